@@ -0,0 +1,421 @@
+// Headless engine micro-benchmarks (premake target `campsur_bench`).
+//
+//   campsur_bench [--counts 1000,10000,100000,1000000] [--iterations 5] [--filter substr]
+//                 [--out results.json] [--seed 12345] [--uncapped]
+//
+// Every case builds its world outside the timed region, runs one warm-up pass, then times
+// `iterations` passes. Results (min / median / mean ms and ns per entity) are printed as a table
+// and written as JSON so runs can be diffed across commits.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "components.h"
+#include "core_systems.h"
+#include "ecs_registry.h"
+#include "json.hpp"
+#include "network/replication_server.h"
+#include "network/transport.h"
+#include "terrain.h"
+#include "world.h"
+
+using namespace criogenio;
+
+namespace {
+
+struct BenchConfig {
+  std::vector<size_t> counts{1000, 10000, 100000};
+  int iterations = 5;
+  std::string filter;
+  std::string outPath = "campsur_bench.json";
+  uint32_t seed = 12345;
+  bool uncapped = false;
+};
+
+struct BenchResult {
+  std::string name;
+  size_t entities = 0;
+  size_t opsPerIteration = 0; // entities touched per timed pass (ns/op denominator)
+  std::vector<double> samplesMs;
+};
+
+/** `beforePass` runs untimed before each pass; only `pass` is measured. */
+struct BenchCase {
+  const char *name;
+  /** Builds the world for `n` entities; returns the per-pass op count. */
+  std::function<size_t(World &world, size_t n, std::mt19937 &rng)> build;
+  std::function<void(World &world)> beforePass; // untimed, may be empty
+  std::function<void(World &world)> pass;
+  /** Larger counts are skipped (super-linear cases) unless --uncapped; 0 = no cap. */
+  size_t maxEntities = 0;
+};
+
+struct NullTransport final : INetworkTransport {
+  size_t bytes = 0;
+  bool StartServer(uint16_t) override { return true; }
+  bool ConnectToServer(const char *, uint16_t) override { return true; }
+  void Update() override {}
+  void Send(ConnectionId, const uint8_t *, size_t size, bool) override { bytes += size; }
+  std::vector<NetworkMessage> PollMessages() override { return {}; }
+  std::vector<ConnectionId> GetConnectionIds() const override { return {1}; }
+};
+
+bool benchAxis(void *, World &, ecs::EntityId, float *dx, float *dy) {
+  *dx = 1.f;
+  *dy = 0.5f;
+  return true;
+}
+
+std::vector<ecs::EntityId> spawnTransforms(World &world, size_t n, std::mt19937 &rng) {
+  std::uniform_real_distribution<float> pos(0.f, 4096.f);
+  std::vector<ecs::EntityId> ids;
+  ids.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const ecs::EntityId id = world.CreateEntity();
+    world.AddComponent<Transform>(id, pos(rng), pos(rng));
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+// Case state lives here between build and pass (one case runs at a time).
+struct CaseState {
+  std::vector<ecs::EntityId> ids;
+  std::vector<ecs::EntityId> scratch;
+  std::unique_ptr<ISystem> system;
+  std::unique_ptr<NullTransport> transport;
+  std::unique_ptr<ReplicationServer> server;
+  size_t cursor = 0;
+  double sink = 0.0; // keeps loops from being optimized away
+};
+CaseState g_state;
+
+std::vector<BenchCase> makeCases() {
+  std::vector<BenchCase> cases;
+
+  cases.push_back({"ecs.add_remove_component",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     g_state.ids = spawnTransforms(w, n, rng);
+                     return n * 2;
+                   },
+                   {},
+                   [](World &w) {
+                     for (ecs::EntityId id : g_state.ids)
+                       w.AddComponent<RigidBody>(id);
+                     for (ecs::EntityId id : g_state.ids)
+                       w.RemoveComponent<RigidBody>(id);
+                   }});
+
+  auto buildMixed = [](World &w, size_t n, std::mt19937 &rng) {
+    g_state.ids = spawnTransforms(w, n, rng);
+    for (size_t i = 0; i < n; i += 2)
+      w.AddComponent<RigidBody>(g_state.ids[i]);
+    return n;
+  };
+  cases.push_back({"ecs.view_cached", buildMixed, {}, [](World &w) {
+                     w.GetEntitiesWith<Transform, RigidBody>(g_state.scratch);
+                     g_state.sink += static_cast<double>(g_state.scratch.size());
+                   }});
+  cases.push_back({"ecs.view_uncached", buildMixed, {}, [](World &) {
+                     ecs::Signature sig;
+                     sig.add(ecs::ComponentTypeRegistry::GetTypeId<Transform>());
+                     sig.add(ecs::ComponentTypeRegistry::GetTypeId<RigidBody>());
+                     ecs::Query(sig).build_into(g_state.scratch);
+                     g_state.sink += static_cast<double>(g_state.scratch.size());
+                   }});
+
+  // Destroying is O(alive) per entity today, so each pass removes a bounded random batch.
+  cases.push_back({"ecs.destroy_entity",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     g_state.ids = spawnTransforms(w, n, rng);
+                     std::shuffle(g_state.ids.begin(), g_state.ids.end(), rng);
+                     g_state.cursor = 0;
+                     return std::min<size_t>(n / 8, 1000);
+                   },
+                   {},
+                   [](World &w) {
+                     const size_t batch = std::min<size_t>(g_state.ids.size() / 8, 1000);
+                     for (size_t i = 0; i < batch && g_state.cursor < g_state.ids.size(); ++i)
+                       w.DeleteEntity(g_state.ids[g_state.cursor++]);
+                   },
+                   100000});
+
+  cases.push_back({"sparse_set.dense_iterate",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     spawnTransforms(w, n, rng);
+                     return n;
+                   },
+                   {},
+                   [](World &) {
+                     double sum = 0.0;
+                     for (const Transform &t :
+                          ecs::Registry::instance().get_component_array<Transform>())
+                       sum += t.x + t.y;
+                     g_state.sink += sum;
+                   }});
+  cases.push_back({"sparse_set.lookup_by_entity",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     g_state.ids = spawnTransforms(w, n, rng);
+                     std::shuffle(g_state.ids.begin(), g_state.ids.end(), rng);
+                     return n;
+                   },
+                   {},
+                   [](World &w) {
+                     double sum = 0.0;
+                     for (ecs::EntityId id : g_state.ids)
+                       if (const Transform *t = w.GetComponent<Transform>(id))
+                         sum += t->x + t->y;
+                     g_state.sink += sum;
+                   }});
+
+  cases.push_back({"system.movement",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     g_state.ids = spawnTransforms(w, n, rng);
+                     for (ecs::EntityId id : g_state.ids) {
+                       auto &c = w.AddComponent<Controller>(id);
+                       c.velocity = {60.f, 60.f};
+                       w.AddComponent<AnimationState>(id);
+                     }
+                     SetWorldMovementInputProvider(w, benchAxis);
+                     g_state.system = std::make_unique<MovementSystem>(w);
+                     return n;
+                   },
+                   {},
+                   [](World &) { g_state.system->Update(1.f / 60.f); }});
+
+  // Dynamic bodies plus 32 platforms. The statics view also returns every dynamic body, so a
+  // pass is O(n^2) today; capped until the broadphase changes.
+  cases.push_back({"system.collision",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     g_state.ids = spawnTransforms(w, n, rng);
+                     for (ecs::EntityId id : g_state.ids) {
+                       w.AddComponent<RigidBody>(id).velocity = {0.f, 40.f};
+                       auto &col = w.AddComponent<BoxCollider>(id);
+                       col.width = col.height = 16.f;
+                     }
+                     for (int i = 0; i < 32; ++i) {
+                       const ecs::EntityId p = w.CreateEntity();
+                       w.AddComponent<Transform>(p, static_cast<float>(i) * 128.f, 2048.f);
+                       auto &col = w.AddComponent<BoxCollider>(p);
+                       col.width = 96.f;
+                       col.height = 16.f;
+                       col.isPlatform = true;
+                     }
+                     g_state.system = std::make_unique<CollisionSystem>(w);
+                     return n;
+                   },
+                   {},
+                   [](World &) { g_state.system->Update(1.f / 60.f); },
+                   20000});
+
+  cases.push_back({"system.ai_movement",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     const ecs::EntityId target = w.CreateEntity();
+                     w.AddComponent<Transform>(target, 2048.f, 2048.f);
+                     g_state.ids = spawnTransforms(w, n, rng);
+                     for (ecs::EntityId id : g_state.ids) {
+                       w.AddComponent<AIController>(id, Vec2{50.f, 0.f},
+                                                    static_cast<int>(target));
+                       w.AddComponent<AnimationState>(id);
+                     }
+                     g_state.system = std::make_unique<AIMovementSystem>(w);
+                     return n;
+                   },
+                   {},
+                   [](World &) { g_state.system->Update(1.f / 60.f); }});
+
+  // Same swarm on a 256x256 tile map (~20% walls) steering along the shared flow field. The
+  // target crosses a cell boundary before every pass, so each pass pays one field rebuild.
+  cases.push_back({"system.ai_flow_field",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     auto terrain = std::make_unique<Terrain2D>();
+                     terrain->tileset.tileSize = 16;
+                     TmxMapMetadata &meta = terrain->tmxMeta;
+                     meta.boundsMaxTx = meta.boundsMaxTy = 256;
+                     meta.collisionStrideTiles = meta.collisionHeightTiles = 256;
+                     meta.collisionSolid.assign(256 * 256, 0);
+                     std::bernoulli_distribution wall(0.2);
+                     for (uint8_t &c : meta.collisionSolid)
+                       c = wall(rng) ? 1 : 0;
+                     w.SetTerrain(std::move(terrain));
+                     const ecs::EntityId target = w.CreateEntity();
+                     w.AddComponent<Transform>(target, 2048.f, 2048.f);
+                     g_state.ids = spawnTransforms(w, n, rng);
+                     for (ecs::EntityId id : g_state.ids) {
+                       auto &ai = w.AddComponent<AIController>(id, Vec2{50.f, 0.f},
+                                                               static_cast<int>(target));
+                       ai.followFlowField = true;
+                       w.AddComponent<AnimationState>(id);
+                     }
+                     g_state.ids.push_back(target); // last entry, moved by beforePass
+                     g_state.system = std::make_unique<AIMovementSystem>(w);
+                     return n;
+                   },
+                   [](World &w) {
+                     if (Transform *t = w.GetComponent<Transform>(g_state.ids.back()))
+                       t->x = t->x >= 2048.f + 16.f * 32.f ? 2048.f : t->x + 16.f;
+                   },
+                   [](World &) { g_state.system->Update(1.f / 60.f); }});
+
+  // Every transform moves between passes so each tick encodes the full entity set.
+  cases.push_back({"net.snapshot_encode",
+                   [](World &w, size_t n, std::mt19937 &rng) {
+                     g_state.ids = spawnTransforms(w, n, rng);
+                     for (ecs::EntityId id : g_state.ids)
+                       w.AddComponent<NetReplicated>(id);
+                     g_state.transport = std::make_unique<NullTransport>();
+                     g_state.server = std::make_unique<ReplicationServer>(w, *g_state.transport);
+                     return n;
+                   },
+                   [](World &w) {
+                     for (ecs::EntityId id : g_state.ids)
+                       if (Transform *t = w.GetComponent<Transform>(id))
+                         t->x += 1.f;
+                   },
+                   [](World &) { g_state.server->Update(); }});
+
+  return cases;
+}
+
+std::vector<size_t> parseCounts(const char *arg) {
+  std::vector<size_t> out;
+  std::string s(arg);
+  size_t start = 0;
+  while (start <= s.size()) {
+    const size_t comma = s.find(',', start);
+    const std::string tok = s.substr(start, comma == std::string::npos ? comma : comma - start);
+    if (!tok.empty())
+      out.push_back(static_cast<size_t>(std::strtoull(tok.c_str(), nullptr, 10)));
+    if (comma == std::string::npos)
+      break;
+    start = comma + 1;
+  }
+  return out;
+}
+
+bool parseArgs(int argc, char **argv, BenchConfig &cfg) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (a == "--counts" && hasValue)
+      cfg.counts = parseCounts(argv[++i]);
+    else if (a == "--iterations" && hasValue)
+      cfg.iterations = std::max(1, std::atoi(argv[++i]));
+    else if (a == "--filter" && hasValue)
+      cfg.filter = argv[++i];
+    else if (a == "--out" && hasValue)
+      cfg.outPath = argv[++i];
+    else if (a == "--uncapped")
+      cfg.uncapped = true;
+    else if (a == "--seed" && hasValue)
+      cfg.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    else {
+      std::fprintf(stderr,
+                   "usage: campsur_bench [--counts 1000,10000,...] [--iterations N] "
+                   "[--filter substr] [--out file.json] [--seed N] [--uncapped]\n");
+      return false;
+    }
+  }
+  return !cfg.counts.empty();
+}
+
+double median(std::vector<double> v) {
+  std::sort(v.begin(), v.end());
+  const size_t m = v.size() / 2;
+  return v.size() % 2 ? v[m] : (v[m - 1] + v[m]) * 0.5;
+}
+
+BenchResult runCase(const BenchCase &bc, size_t n, const BenchConfig &cfg) {
+  BenchResult r;
+  r.name = bc.name;
+  r.entities = n;
+  std::mt19937 rng(cfg.seed);
+  World world;
+  r.opsPerIteration = bc.build(world, n, rng);
+  for (int i = 0; i <= cfg.iterations; ++i) { // pass 0 is the warm-up
+    if (bc.beforePass)
+      bc.beforePass(world);
+    const auto t0 = std::chrono::steady_clock::now();
+    bc.pass(world);
+    const auto t1 = std::chrono::steady_clock::now();
+    if (i > 0)
+      r.samplesMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+  }
+  ClearWorldMovementInputProvider(world);
+  g_state.server.reset();
+  g_state.transport.reset();
+  g_state.system.reset();
+  g_state.ids.clear();
+  g_state.scratch.clear();
+  return r;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  BenchConfig cfg;
+  if (!parseArgs(argc, argv, cfg))
+    return 2;
+
+  nlohmann::json results = nlohmann::json::array();
+  std::printf("%-28s %10s %10s %10s %10s %12s\n", "case", "entities", "min ms", "median ms",
+              "mean ms", "ns/op");
+  for (const BenchCase &bc : makeCases()) {
+    if (!cfg.filter.empty() && std::string(bc.name).find(cfg.filter) == std::string::npos)
+      continue;
+    for (size_t n : cfg.counts) {
+      if (bc.maxEntities && n > bc.maxEntities && !cfg.uncapped) {
+        std::printf("%-28s %10zu   skipped (cap %zu, --uncapped to run)\n", bc.name, n,
+                    bc.maxEntities);
+        results.push_back({{"name", bc.name}, {"entities", n}, {"skipped", true}});
+        continue;
+      }
+      const BenchResult r = runCase(bc, n, cfg);
+      double sum = 0.0;
+      for (double s : r.samplesMs)
+        sum += s;
+      const double mean = sum / static_cast<double>(r.samplesMs.size());
+      const double med = median(r.samplesMs);
+      const double minMs = *std::min_element(r.samplesMs.begin(), r.samplesMs.end());
+      const double nsPerOp =
+          r.opsPerIteration ? med * 1e6 / static_cast<double>(r.opsPerIteration) : 0.0;
+      std::printf("%-28s %10zu %10.3f %10.3f %10.3f %12.1f\n", r.name.c_str(), n, minMs, med,
+                  mean, nsPerOp);
+      std::fflush(stdout);
+      results.push_back({{"name", r.name},
+                         {"entities", n},
+                         {"ops_per_iteration", r.opsPerIteration},
+                         {"iterations", r.samplesMs.size()},
+                         {"min_ms", minMs},
+                         {"median_ms", med},
+                         {"mean_ms", mean},
+                         {"ns_per_op", nsPerOp},
+                         {"samples_ms", r.samplesMs}});
+    }
+  }
+
+  nlohmann::json doc = {{"suite", "campsur_bench"},
+                        {"seed", cfg.seed},
+                        {"iterations", cfg.iterations},
+                        {"counts", cfg.counts},
+                        {"results", results}};
+  std::ofstream out(cfg.outPath, std::ios::trunc);
+  if (!out) {
+    std::fprintf(stderr, "campsur_bench: could not write %s\n", cfg.outPath.c_str());
+    return 1;
+  }
+  out << doc.dump(2) << '\n';
+  std::printf("wrote %s (sink %.1f)\n", cfg.outPath.c_str(), g_state.sink);
+  return 0;
+}
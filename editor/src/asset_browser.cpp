@@ -381,6 +381,7 @@ void EditorApp::DrawAssetBrowser() {
       if (sp->animationId != criogenio::INVALID_ASSET_ID)
         criogenio::AnimationDatabase::instance().removeReference(sp->animationId);
       sp->animationId = nid;
+      w.MarkSpatialDirty(eid);
       criogenio::AnimationDatabase::instance().addReference(nid);
     }
     if (!w.HasComponent<criogenio::AnimationState>(eid))
@@ -2184,6 +2184,7 @@ void EditorApp::DrawMainMenuBar() {
                 if (sp->animationId != criogenio::INVALID_ASSET_ID)
                   criogenio::AnimationDatabase::instance().removeReference(sp->animationId);
                 sp->animationId = nid;
+                w.MarkSpatialDirty(e);
                 criogenio::AnimationDatabase::instance().addReference(nid);
               }
               if (!w.HasComponent<criogenio::AnimationState>(e))
@@ -3103,13 +3104,9 @@ void EditorApp::DrawTerrainEditor() {
     if (baseGid > 0) {
       const criogenio::TmxTilesetEntry *picked = nullptr;
       int localId = -1;
-      for (int i = static_cast<int>(terrain->tmxTilesets.size()) - 1; i >= 0; --i) {
-        const auto &ts = terrain->tmxTilesets[i];
-        if (static_cast<int>(baseGid) >= ts.firstGid) {
-          picked = &ts;
-          localId = static_cast<int>(baseGid) - ts.firstGid;
-          break;
-        }
+      if (const criogenio::TmxGidEntry *g = terrain->LookupTmxGid(baseGid)) {
+        picked = &terrain->tmxTilesets[static_cast<size_t>(g->tilesetIndex)];
+        localId = g->localId;
       }
       if (picked) {
         auto it = picked->tileProperties.find(localId);
@@ -3258,6 +3255,7 @@ void EditorApp::DrawTerrainEditor() {
         e.sheet.columns = std::max(1, e.sheet.atlas->texture.width  / e.tilePixelW);
         e.sheet.rows    = std::max(1, e.sheet.atlas->texture.height / e.tilePixelH);
         terrain->tmxTilesets.push_back(std::move(e));
+        terrain->RebuildTmxGidLookup();
         printf("[Editor] Added tileset: %s (firstGid=%d)\n", path,
                terrain->tmxTilesets.back().firstGid);
       } else {
@@ -4554,6 +4552,7 @@ void EditorApp::DrawAnimationEditor(int entity) {
           criogenio::AnimationDatabase::instance().removeReference(oldId);
         }
         sprite->animationId = newId;
+        GetWorld().MarkSpatialDirty(entity);
         criogenio::AnimationDatabase::instance().addReference(newId);
         if (const auto *def =
                 criogenio::AnimationDatabase::instance().getAnimation(newId);
@@ -4728,6 +4727,7 @@ void EditorApp::DrawAnimationEditor(int entity) {
       animId =
           criogenio::AnimationDatabase::instance().createAnimation(texPathEdit);
       sprite->animationId = animId;
+      GetWorld().MarkSpatialDirty(entity);
       criogenio::AnimationDatabase::instance().addReference(animId);
     } else {
       // Ensure texture path matches the edited one
@@ -4971,6 +4971,7 @@ void EditorApp::DrawAnimatedSpriteInspector(int entity) {
         AnimationDatabase::instance().removeReference(oldId);
         AnimationDatabase::instance().addReference(newId);
         sprite->animationId = newId;
+        GetWorld().MarkSpatialDirty(entity);
         AssetManager::instance().load<criogenio::TextureResource>(tmp);
       }
     }
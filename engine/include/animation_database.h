@@ -10,6 +10,8 @@
 
 namespace criogenio {
 
+struct TextureResource;
+
 // Simple asset ID type
 using AssetId = uint32_t;
 constexpr AssetId INVALID_ASSET_ID = 0;
@@ -31,6 +33,13 @@ struct AnimationDef {
   AssetId id;
   std::string texturePath;
   std::vector<AnimationClip> clips;
+  // Resolved texture for texturePath (see AnimationDatabase::resolveTexture). Valid while
+  // textureGeneration matches AssetManager::generation(); 0 means never resolved.
+  mutable std::shared_ptr<TextureResource> texture;
+  mutable uint64_t textureGeneration = 0;
+  // Largest frame width / height over every clip (sprite cull bounds); kept by addClip /
+  // removeClip.
+  Vec2 maxFrameSize{0.f, 0.f};
 };
 
 class AnimationDatabase {
@@ -42,6 +51,11 @@ public:
   void addClip(AssetId animId, const AnimationClip &clip);
 
   const AnimationDef *getAnimation(AssetId animId) const;
+  /**
+   * Texture for `def`, loaded through AssetManager once and reused until an unload / hot
+   * reload bumps AssetManager::generation(). Render hot paths use this instead of load().
+   */
+  static TextureResource *resolveTexture(const AnimationDef &def);
   const AnimationClip *getClip(AssetId animId,
                                const std::string &clipName) const;
 
@@ -56,6 +70,8 @@ public:
   AssetId cloneAnimation(AssetId sourceId);
 
   void clear();
+  /** Bumped by every clip edit / clear, so cached frame extents can be refreshed. */
+  uint64_t generation() const { return generation_; }
 
   // Reference counting helpers for usage tracking
   void addReference(AssetId animId);
@@ -69,6 +85,7 @@ private:
   }
 
   AssetId nextId_;
+  uint64_t generation_ = 1;
   std::unordered_map<AssetId, AnimationDef> animations_;
   std::unordered_map<AssetId, int> refcounts_;
 };
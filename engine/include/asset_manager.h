@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -69,12 +71,20 @@ public:
 
   void unload(const std::string &path);
 
+  /**
+   * Bumped whenever cached resources may have been replaced or dropped (unload, hot reload,
+   * clear). Callers that keep resolved handles compare against it instead of calling
+   * load() every frame; reading it takes no lock.
+   */
+  uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
   void registerHotReloadCallback(const std::string &path, HotReloadCallback cb);
   void triggerHotReload(const std::string &path);
 
   void clear() {
     std::lock_guard<std::mutex> lk(mutex_);
     cache_.clear();
+    generation_.fetch_add(1, std::memory_order_acq_rel);
   }
 
 private:
@@ -99,6 +109,7 @@ private:
   };
 
   std::mutex mutex_;
+  std::atomic<uint64_t> generation_{1};
   std::unordered_map<Key, std::shared_ptr<Resource>, KeyHash> cache_;
   std::unordered_map<std::type_index, std::function<std::shared_ptr<Resource>(
                                           const std::string &)>>
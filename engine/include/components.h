@@ -303,6 +303,13 @@ public:
   Direction direction = Direction::UP;
   AIBrainState brainState = FRIENDLY;
   int entityTarget = -1;
+  /**
+   * Steer along the shared flow field over the TMX collision mask instead of a straight line
+   * (AIMovementSystem). `pathAnchor` is the point, relative to Transform, that follows the
+   * path (e.g. the feet).
+   */
+  bool followFlowField = false;
+  Vec2 pathAnchor = {0, 0};
 
   AIController() = default;
   AIController(Vec2 velocity, int entityTarget)
@@ -318,6 +325,9 @@ public:
                 {"direction", static_cast<int>(direction)},
                 {"brainState", static_cast<int>(brainState)},
                 {"entityTarget", entityTarget},
+                {"followFlowField", followFlowField},
+                {"pathAnchor_x", pathAnchor.x},
+                {"pathAnchor_y", pathAnchor.y},
             }};
   }
 
@@ -327,6 +337,12 @@ public:
     direction = static_cast<Direction>(GetInt(data.fields.at("direction")));
     brainState = static_cast<AIBrainState>(GetInt(data.fields.at("brainState")));
     entityTarget = GetInt(data.fields.at("entityTarget"));
+    if (auto it = data.fields.find("followFlowField"); it != data.fields.end())
+      followFlowField = std::get<bool>(it->second);
+    if (auto it = data.fields.find("pathAnchor_x"); it != data.fields.end())
+      pathAnchor.x = GetFloat(it->second);
+    if (auto it = data.fields.find("pathAnchor_y"); it != data.fields.end())
+      pathAnchor.y = GetFloat(it->second);
   }
 };
 
@@ -2,6 +2,8 @@
 
 #include "animated_component.h"
 #include "components.h"
+#include "draw_order_sort.h"
+#include "flow_field.h"
 #include "systems.h"
 #include "world.h"
 #include <algorithm>
@@ -66,6 +68,7 @@ public:
 
   void Update(float dt) override;
   void Render(Renderer &renderer) override;
+  const char *SystemName() const override { return "Movement"; }
 };
 
 class MovementSystem3D : public ISystem {
@@ -75,6 +78,7 @@ public:
 
   void Update(float dt) override;
   void Render(Renderer &renderer) override;
+  const char *SystemName() const override { return "Movement3D"; }
 };
 
 class AIMovementSystem : public ISystem {
@@ -84,6 +88,11 @@ public:
 
   void Update(float dt) override;
   void Render(Renderer &renderer) override;
+  const char *SystemName() const override { return "AIMovement"; }
+  const FlowFieldCache &GetFlowFields() const { return flowFields_; }
+
+private:
+  FlowFieldCache flowFields_; // one field per goal tile, shared by followFlowField agents
 };
 
 class AnimationSystem : public ISystem {
@@ -94,6 +103,7 @@ public:
   std::string BuildClipKey(const AnimationState &st);
   void Update(float dt) override;
   void Render(Renderer &) override;
+  const char *SystemName() const override { return "Animation"; }
   void OnWorldLoaded(World &world);
 };
 
@@ -103,6 +113,10 @@ public:
   SpriteSystem(World &w) : world(w) {};
   void Update(float dt) override;
   void Render(Renderer &) override;
+  const char *SystemName() const override { return "Sprite"; }
+
+private:
+  DrawOrderSorter drawOrder_;
 };
 
 class RenderSystem : public ISystem {
@@ -111,6 +125,10 @@ public:
   RenderSystem(World &w) : world(w) {}
   void Update(float) override;
   void Render(Renderer &renderer) override;
+  const char *SystemName() const override { return "Render"; }
+
+private:
+  DrawOrderSorter drawOrder_;
 };
 
 class GravitySystem : public ISystem {
@@ -119,6 +137,7 @@ public:
   GravitySystem(World &w) : world(w) {}
   void Update(float dt) override;
   void Render(Renderer &renderer) override;
+  const char *SystemName() const override { return "Gravity"; }
 };
 
 /** Resolves RigidBody+BoxCollider entities against platform BoxColliders. Run after GravitySystem. */
@@ -128,6 +147,7 @@ public:
   CollisionSystem(World &w) : world(w) {}
   void Update(float dt) override;
   void Render(Renderer &renderer) override;
+  const char *SystemName() const override { return "Collision"; }
 };
 
 } // namespace criogenio
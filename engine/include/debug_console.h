@@ -30,6 +30,7 @@ public:
   /** SDL_Event from SDL3; sdlWindow is SDL_Window* for text input. Returns true if consumed. */
   bool HandleEvent(Engine &engine, const void *sdlEvent, void *sdlWindow);
 
+  /** Console panel when open; the profiler timeline (`profile overlay`) draws even when closed. */
   void Draw(Renderer &renderer, int viewportW, int viewportH);
 
   void ExecuteLine(Engine &engine, const std::string &line);
@@ -38,6 +39,7 @@ public:
 
 private:
   void registerBuiltins(Engine &engine);
+  void drawProfilerOverlay(Renderer &renderer, int viewportW, int viewportH);
   static std::vector<std::string> splitArgs(const std::string &line);
   static std::string normalizeCommandName(std::string name);
 
@@ -46,6 +48,7 @@ private:
   std::string inputLine_;
   bool open_ = false;
   bool builtinsRegistered_ = false;
+  bool profilerOverlay_ = false;
   static constexpr int kMaxLogLines = 200;
 };
 
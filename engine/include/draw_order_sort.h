@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ecs_core.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace criogenio {
+
+/** Pack (draw order, entity id) so unsigned key order matches (order, id) lexicographic order. */
+inline uint64_t MakeDrawOrderKey(int order, ecs::EntityId id) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(order) ^ 0x80000000u) << 32) |
+         static_cast<uint64_t>(id);
+}
+
+/**
+ * Per-system draw-order sorter. The draw order of each entity is computed once per frame
+ * into a flat key array, which is ordered by an LSD radix sort. When the incoming id list
+ * is identical to last frame's, last frame's permutation seeds the array and a bounded
+ * insertion sort repairs the few entities that moved; too many moves falls back to radix.
+ */
+class DrawOrderSorter {
+public:
+  struct Stats {
+    uint64_t radixSorts = 0;
+    uint64_t insertionSorts = 0;
+  };
+
+  /** Reorder `ids` in place by (orderOf(id), id). `orderOf` is called exactly once per id. */
+  template <typename OrderFn> void Sort(std::vector<ecs::EntityId> &ids, OrderFn &&orderOf) {
+    const bool coherent = BeginFrame(ids);
+    for (Entry &e : entries_)
+      e.key = MakeDrawOrderKey(orderOf(ids[e.index]), ids[e.index]);
+    FinishFrame(ids, coherent);
+  }
+
+  const Stats &GetStats() const { return stats_; }
+
+private:
+  struct Entry {
+    uint64_t key;
+    uint32_t index; // position in the caller's unsorted id list
+  };
+
+  bool BeginFrame(const std::vector<ecs::EntityId> &ids);
+  void FinishFrame(std::vector<ecs::EntityId> &ids, bool coherent);
+  void RadixSort();
+  bool InsertionSort(size_t maxMoves);
+
+  std::vector<Entry> entries_;
+  std::vector<Entry> scratch_;
+  std::vector<ecs::EntityId> prevInput_;
+  std::vector<uint32_t> prevPerm_;
+  Stats stats_;
+};
+
+} // namespace criogenio
@@ -194,6 +194,8 @@ public:
     }
 
     auto storage = static_cast<ComponentStorage<T> *>(it->second.get());
+    if (!storage->contains(entity))
+      return; // nothing changed: keep cached views valid
     storage->remove(entity);
 
     // Update entity signature
@@ -323,6 +325,9 @@ public:
   // Utility
   // ========================================================================
 
+  /** Bumped by every structural change (entity or component added / removed). */
+  uint64_t mutation_counter() const { return mutation_counter_; }
+
   void clear() {
     component_storage.clear();
     EntityManager::instance().clear();
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "tmx_metadata.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace criogenio {
+
+/**
+ * Dijkstra distance field over a TMX collision mask (`TmxMapMetadata::collisionSolid`) toward
+ * one goal tile. 8-connected (orthogonal cost 10, diagonal 14) without cutting solid corners.
+ * Every reached cell stores the neighbour that descends the field, so steering an agent is a
+ * single lookup regardless of how many agents share the field.
+ */
+class FlowField2D {
+public:
+  static constexpr uint32_t kUnreachable = UINT32_MAX;
+
+  /**
+   * Rebuild toward world tile (goalTx, goalTy). The goal may itself be solid (a target
+   * standing against a wall); other solid cells are never entered. False when the goal is
+   * outside the mask.
+   */
+  bool Build(const TmxMapMetadata &meta, int goalTx, int goalTy);
+  bool Valid() const { return valid_; }
+  int GoalTx() const { return goalTx_; }
+  int GoalTy() const { return goalTy_; }
+  /** Path cost from (worldTx, worldTy) to the goal, kUnreachable when cut off or outside. */
+  uint32_t Cost(int worldTx, int worldTy) const;
+  /**
+   * Next tile toward the goal. From an unreached cell (an agent overlapping a wall) this is
+   * the cheapest reached neighbour, so agents slide back onto the field. False at the goal
+   * or when nothing nearby is reached.
+   */
+  bool NextStep(int worldTx, int worldTy, int &outTx, int &outTy) const;
+  size_t ReachedCells() const { return reached_; }
+
+private:
+  static constexpr size_t kBuckets = 15; // > largest step cost
+  bool CellIndex(int worldTx, int worldTy, size_t &out) const;
+
+  bool valid_ = false;
+  int goalTx_ = 0, goalTy_ = 0;
+  int minTx_ = 0, minTy_ = 0;
+  int width_ = 0, height_ = 0;
+  size_t reached_ = 0;
+  std::vector<uint32_t> cost_;
+  std::vector<int8_t> step_; // index into the 8 neighbour offsets, -1 = none
+  std::array<std::vector<uint32_t>, kBuckets> buckets_;
+};
+
+/**
+ * Flow fields keyed by goal tile, shared by every agent heading for the same cell. A target
+ * that moves to another cell gets a new field on first use; fields left idle for a whole
+ * frame are recycled (buffers reused). A changed collision mask drops everything.
+ */
+class FlowFieldCache {
+public:
+  static constexpr size_t kMaxFields = 16;
+
+  /**
+   * Field toward (goalTx, goalTy), built on a miss; nullptr when the goal is unusable. The
+   * pointer stays valid until the next Acquire.
+   */
+  const FlowField2D *Acquire(const TmxMapMetadata &meta, int goalTx, int goalTy);
+  /** Frame boundary for the idle tracking above. */
+  void Sweep();
+  void Clear();
+  size_t Size() const { return entries_.size(); }
+  uint64_t BuildCount() const { return builds_; }
+
+private:
+  struct Entry {
+    int goalTx = 0, goalTy = 0;
+    uint32_t lastUse = 0;
+    bool ok = false;
+    FlowField2D field;
+  };
+
+  const uint8_t *maskData_ = nullptr;
+  size_t maskSize_ = 0;
+  uint32_t maskRevision_ = 0;
+  uint32_t frame_ = 1;
+  uint64_t builds_ = 0;
+  std::vector<Entry> entries_;
+};
+
+} // namespace criogenio
@@ -47,6 +47,10 @@ enum class TextureBlendMode {
   Add,
   Mod,
   Mul,
+  /** Source colour already multiplied by its alpha (off-screen render targets). */
+  Premultiplied,
+  /** dst += src, source premultiplied (compositing additive accumulation buffers). */
+  AddPremultiplied,
 };
 
 // Common colors
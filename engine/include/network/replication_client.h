@@ -2,6 +2,7 @@
 
 #include "entity.h"
 #include "network/snapshot.h"
+#include "network/terrain_delta.h"
 #include "world.h"
 #include <unordered_map>
 
@@ -15,6 +16,8 @@ public:
   explicit ReplicationClient(World &world);
 
   void ApplySnapshot(const Snapshot &snap);
+  /** Apply replicated tile edits to the local terrain (no-op without terrain). */
+  void ApplyTerrainDelta(const TerrainDelta &delta);
   void UpdateInterpolation(float dt);
 
 private:
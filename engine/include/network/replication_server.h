@@ -8,6 +8,8 @@
 #include "network/transport.h"
 #include "world.h"
 #include <cstdint>
+#include <deque>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -23,8 +25,50 @@ public:
     uint64_t entitiesDeltaSkipped = 0;
     uint64_t snapshotsSkippedNoop = 0;
     uint64_t bytesSent = 0;
+    uint64_t terrainDeltasSent = 0;
+    uint64_t terrainChunksSent = 0;
+    uint64_t terrainBytesSent = 0;
   };
 
+  /** Per-tick snapshot metrics, kept in a fixed ring for histograms / time-series export. */
+  struct TickSample {
+    uint32_t tick = 0;
+    float buildMs = 0.f;  // entity gather + transform payload packing
+    float encodeMs = 0.f; // wire encode of the assembled snapshot
+    uint32_t bytesPerClient = 0; // 0 when the tick was skipped as a no-op
+    uint32_t entitiesInPacket = 0;
+    uint32_t entitiesConsidered = 0;
+    uint32_t entitiesDeltaSkipped = 0;
+    uint32_t clients = 0;
+    float DeltaSkipRatio() const {
+      return entitiesConsidered > 0
+                 ? static_cast<float>(entitiesDeltaSkipped) / static_cast<float>(entitiesConsidered)
+                 : 0.f;
+    }
+  };
+  /** Distribution of one metric over the retained tick window. */
+  struct MetricSummary {
+    float min = 0.f;
+    float avg = 0.f;
+    float p50 = 0.f;
+    float p95 = 0.f;
+    float p99 = 0.f;
+    float max = 0.f;
+  };
+  struct TickMetricsSummary {
+    size_t samples = 0;
+    MetricSummary buildMs;
+    MetricSummary encodeMs;
+    MetricSummary bytesPerClient;
+    MetricSummary entitiesPerPacket;
+    MetricSummary deltaSkipRatio;
+  };
+  /** Ticks retained for metrics (~10 s at 60 Hz). */
+  static constexpr size_t kTickHistoryCapacity = 600;
+
+  /** Max chunks streamed per tick to a late joiner (keeps the join burst bounded). */
+  static constexpr size_t kTerrainStreamChunksPerTick = 64;
+
   ReplicationServer(World &world, INetworkTransport &net);
 
   void Update();
@@ -37,10 +81,24 @@ public:
   }
   bool IsQuantizedTransformPayloadEnabled() const { return useQuantizedTransformPayload_; }
   const Stats &GetStats() const { return stats_; }
-  void ResetStats() { stats_ = {}; }
+  void ResetStats() {
+    stats_ = {};
+    tickHistory_.clear();
+    tickHistoryHead_ = 0;
+  }
+
+  /** Retained per-tick samples, oldest first. */
+  void GetTickHistory(std::vector<TickSample> &out) const;
+  TickMetricsSummary SummarizeTickHistory() const;
+  /** Dump the retained window as a time series; format picked by extension (.json, else CSV). */
+  bool WriteTickHistory(const std::string &path) const;
 
 private:
   void BuildAndSendSnapshot();
+  /** Broadcast dirty terrain chunks and drain per-connection late-join chunk streams. */
+  void ReplicateTerrain();
+  void SendTerrainDelta(ConnectionId conn, const std::vector<uint8_t> &data, size_t chunkCount);
+  void RecordTickSample(const TickSample &sample);
   bool ShouldSerializeTransform(ecs::EntityId eid, const Transform &t, bool forceFull);
   uint8_t BuildTransformFieldMask(ecs::EntityId eid, const Transform &t, bool forceFull) const;
   bool CanQuantizeTransformFields(uint8_t fieldMask, const Transform &t) const;
@@ -64,7 +122,13 @@ private:
     float scaleY = 1.f;
   };
   std::unordered_map<ecs::EntityId, SerializedTransform> lastSentTransform_;
+  /** Terrain that change tracking was enabled on; re-armed when the world swaps maps. */
+  Terrain2D *trackedTerrain_ = nullptr;
+  /** Edited chunks still owed to connections that joined after the edits happened. */
+  std::unordered_map<ConnectionId, std::deque<TerrainChunkRef>> terrainStreamQueue_;
   Stats stats_;
+  std::vector<TickSample> tickHistory_; // ring, capacity kTickHistoryCapacity
+  size_t tickHistoryHead_ = 0;          // next write slot once the ring is full
 };
 
 }  // namespace criogenio
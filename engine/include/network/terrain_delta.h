@@ -0,0 +1,53 @@
+#pragma once
+
+#include "terrain.h"
+#include "network/serialization.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace criogenio {
+
+/** One replicated chunk: full cell contents, or a removal when `removed` is set. */
+struct TerrainDeltaChunk {
+  uint16_t layer = 0;
+  int32_t chunkX = 0;
+  int32_t chunkY = 0;
+  bool removed = false;
+  std::vector<int> tiles; // chunkSize*chunkSize cells when !removed
+};
+
+struct TerrainDelta {
+  uint32_t tick = 0;
+  uint16_t chunkSize = 0;
+  std::vector<TerrainDeltaChunk> chunks;
+};
+
+/** Chunk record flags on the wire. */
+constexpr uint8_t TERRAIN_CHUNK_REMOVED = 1u << 0;
+
+/**
+ * Append the current contents of `ref` to `delta` (a removal record when the chunk is no
+ * longer allocated). Returns false when `ref.layer` is out of range.
+ */
+bool AppendTerrainDeltaChunk(TerrainDelta &delta, const Terrain2D &terrain,
+                             const TerrainChunkRef &ref);
+
+/**
+ * Wire format: MsgType::TerrainDelta, tick, chunkSize, chunk count, then per chunk
+ * layer/cx/cy/flags followed by run-length encoded cells (run count, then
+ * uint16 length + int32 value pairs). Tile layers are mostly runs of empty / fill
+ * tiles, so a 16x16 chunk typically encodes to a few dozen bytes instead of 1 KiB.
+ */
+void WriteTerrainDelta(NetWriter &w, const TerrainDelta &delta);
+
+/** Parse a TerrainDelta message; returns an empty delta on malformed input. */
+TerrainDelta ParseTerrainDeltaFromWire(const uint8_t *data, size_t size);
+
+/**
+ * Apply every chunk of `delta` to `terrain`. Returns the number of chunks applied (0 when
+ * the sender's chunk size differs from the local terrain).
+ */
+size_t ApplyTerrainDelta(Terrain2D &terrain, const TerrainDelta &delta);
+
+} // namespace criogenio
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace criogenio {
+
+struct TmxMapMetadata;
+
+/** Tile coordinate on a PathGrid (world tile space, same as `Terrain2D::GetTile`). */
+struct PathTile {
+  int tx = 0;
+  int ty = 0;
+  bool operator==(const PathTile &o) const { return tx == o.tx && ty == o.ty; }
+};
+
+/**
+ * Immutable walkability snapshot for path queries: TMX collision plus any dynamic blockers
+ * stamped in by the owner. Shared read-only with worker threads once published.
+ */
+struct PathGrid {
+  int minTx = 0, minTy = 0;
+  int width = 0, height = 0;
+  /** World pixels per tile and map origin, for converting waypoints. */
+  float tileW = 1.f, tileH = 1.f;
+  float originX = 0.f, originY = 0.f;
+  uint64_t version = 0;
+  std::vector<uint8_t> solid; // width * height, row-major, 1 = blocked
+
+  /** Local (0-based) cell; out of bounds counts as blocked. */
+  bool Blocked(int lx, int ly) const {
+    return lx < 0 || ly < 0 || lx >= width || ly >= height ||
+           solid[static_cast<size_t>(ly) * width + lx] != 0;
+  }
+  /** Copy `meta.collisionSolid` (bounds and stride included); false when it is empty. */
+  bool AssignFromTmx(const TmxMapMetadata &meta);
+  /** Mark every tile overlapping the world-pixel rect as blocked. */
+  void BlockWorldRect(float x, float y, float w, float h);
+};
+
+/**
+ * HPA*-style abstraction over a PathGrid. The map is cut into kClusterSize square clusters;
+ * walkable runs along each shared border become portal pairs, and portals of one cluster are
+ * linked by their in-cluster path cost. Queries run A* on that small graph and refine each
+ * hop with an in-cluster search. Rebuilding from a previous graph reuses every cluster whose
+ * cells and one-tile border ring did not change, so toggling a door only redoes the clusters
+ * around it.
+ */
+class HierarchicalPathGraph {
+public:
+  static constexpr int kClusterSize = 16;
+  /** Border runs at least this long get a portal at each end instead of one in the middle. */
+  static constexpr int kWideEntrance = 6;
+
+  static std::shared_ptr<const HierarchicalPathGraph>
+  Build(std::shared_ptr<const PathGrid> grid, const HierarchicalPathGraph *previous);
+
+  const PathGrid &Grid() const { return *grid_; }
+  uint64_t Version() const { return grid_->version; }
+  size_t ClusterCount() const { return clusters_.size(); }
+  size_t NodeCount() const { return nodes_.size(); }
+  /** Clusters copied from the previous graph in Build. */
+  size_t ReusedClusters() const { return reusedClusters_; }
+
+  /**
+   * Tiles from `start` (excluded) to `goal` (included), world tile coordinates. False when
+   * either end is blocked / outside or no route exists. Safe to call from any thread.
+   */
+  bool FindPath(PathTile start, PathTile goal, std::vector<PathTile> &out) const;
+
+private:
+  struct Portal {
+    int lx = 0, ly = 0;   // grid-local cell on the cluster edge
+    uint8_t sides = 0;    // bit per border (0 +x, 1 -x, 2 +y, 3 -y) it crosses
+  };
+  struct Cluster {
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0; // local cell range [x0, x1) x [y0, y1)
+    uint64_t hash = 0;                  // cells plus one-tile ring
+    std::vector<Portal> portals;
+    std::vector<uint32_t> intra;        // portals x portals in-cluster costs
+    std::vector<uint32_t> nodeIds;      // parallel to portals
+  };
+  struct Edge {
+    uint32_t to = 0;
+    uint32_t cost = 0;
+  };
+  struct Node {
+    int lx = 0, ly = 0;
+    uint32_t cluster = 0;
+  };
+
+  explicit HierarchicalPathGraph(std::shared_ptr<const PathGrid> grid) : grid_(std::move(grid)) {}
+  void BuildCluster(Cluster &c) const;
+  uint32_t ClusterOf(int lx, int ly) const;
+  void Refine(uint32_t cluster, int ax, int ay, int bx, int by,
+              std::vector<PathTile> &out) const;
+
+  std::shared_ptr<const PathGrid> grid_;
+  int clustersX_ = 0, clustersY_ = 0;
+  std::vector<Cluster> clusters_;
+  std::vector<Node> nodes_;
+  std::vector<std::vector<Edge>> adjacency_;
+  size_t reusedClusters_ = 0;
+};
+
+} // namespace criogenio
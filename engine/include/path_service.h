@@ -0,0 +1,143 @@
+#pragma once
+
+#include "components.h"
+#include "ecs_core.h"
+#include "graphics_types.h"
+#include "path_graph.h"
+#include "serialization.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace criogenio {
+
+class World;
+struct TmxMapMetadata;
+
+/**
+ * Tile path written by PathService::Deliver. `waypoints` are world-space tile centres;
+ * AIMovementSystem walks them (placing the agent's `AIController::pathAnchor` on each) ahead
+ * of its target / flow-field steering. Transient: not serialized.
+ */
+struct Path2D : public Component {
+  enum class Status : uint8_t { Pending, Ready, Failed };
+  Status status = Status::Pending;
+  /** Matches the PathService request; older results for this entity are dropped. */
+  uint32_t requestId = 0;
+  std::vector<Vec2> waypoints;
+  size_t next = 0;
+  /** World point the request was made toward. */
+  Vec2 goal;
+
+  bool Active() const { return status == Status::Ready && next < waypoints.size(); }
+
+  std::string TypeName() const override { return "Path2D"; }
+  SerializedComponent Serialize() const override {
+    SerializedComponent o;
+    o.type = TypeName();
+    return o;
+  }
+  void Deserialize(const SerializedComponent &) override {}
+};
+
+struct PathServiceStats {
+  uint64_t requested = 0;
+  uint64_t delivered = 0;
+  uint64_t failed = 0;
+  uint64_t graphBuilds = 0;
+  size_t pending = 0;
+  size_t clusters = 0;
+  size_t nodes = 0;
+  /** Clusters copied from the previous graph by the last rebuild. */
+  size_t reusedClusters = 0;
+  double lastBuildMs = 0.0;
+  double lastQueryMs = 0.0;
+};
+
+/**
+ * Asynchronous tile path queries over a HierarchicalPathGraph. The main thread publishes
+ * walkability (TMX collision plus blocker rects such as closed doors) and queues requests;
+ * worker threads rebuild the graph lazily when a newer grid was published and run the
+ * searches; Deliver hands finished paths back as Path2D components. Nothing on the main
+ * thread waits for a search or a rebuild.
+ */
+class PathService {
+public:
+  /** `workers` 0 picks min(4, hardware_concurrency / 2), at least one. */
+  explicit PathService(unsigned workers = 0);
+  ~PathService();
+  PathService(const PathService &) = delete;
+  PathService &operator=(const PathService &) = delete;
+
+  /**
+   * Use `meta.collisionSolid` as the base grid. No-op while the same mask (storage,
+   * size and `collisionRevision`) is already loaded, so it is cheap to call every frame.
+   */
+  void SetCollision(const TmxMapMetadata &meta, float tileW, float tileH, Vec2 origin);
+  /** World rects stamped over the base grid; no-op when equal to the current set. */
+  void SetBlockers(const std::vector<Rect> &rects);
+  /** Drop the grid, queued jobs and undelivered results (map unload). */
+  void Clear();
+
+  /**
+   * Queue a path from world point `from` to `to` (both tested by tile). Adds / resets the
+   * entity's Path2D to Pending and returns the request id, or 0 without a grid.
+   */
+  uint32_t RequestPath(World &world, ecs::EntityId entity, Vec2 from, Vec2 to);
+  /** Main thread: copy finished results into matching Path2D components. */
+  size_t Deliver(World &world);
+  /** Block until every queued request has a result (tests, tools). */
+  void WaitIdle();
+
+  unsigned WorkerCount() const { return static_cast<unsigned>(workers_.size()); }
+  PathServiceStats GetStats() const;
+
+private:
+  struct Job {
+    uint32_t requestId = 0;
+    ecs::EntityId entity = ecs::NULL_ENTITY;
+    PathTile from, to;
+  };
+  struct Result {
+    uint32_t requestId = 0;
+    ecs::EntityId entity = ecs::NULL_ENTITY;
+    bool ok = false;
+    std::vector<Vec2> waypoints;
+  };
+
+  void WorkerLoop();
+  void Publish();
+  std::shared_ptr<const HierarchicalPathGraph> GraphFor(std::shared_ptr<const PathGrid> grid);
+
+  // Main thread only.
+  PathGrid base_;
+  std::vector<Rect> blockers_;
+  const uint8_t *maskData_ = nullptr;
+  size_t maskSize_ = 0;
+  uint32_t maskRevision_ = 0;
+  uint64_t version_ = 0;
+  uint32_t nextRequestId_ = 1;
+
+  mutable std::mutex mutex_; // jobs_, results_, grid_, stats_, busy_, stop_
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  std::deque<Job> jobs_;
+  std::vector<Result> results_;
+  std::shared_ptr<const PathGrid> grid_;
+  PathServiceStats stats_;
+  size_t busy_ = 0;
+  bool stop_ = false;
+
+  std::mutex graphMutex_; // graph_ (rebuilt by whichever worker sees a newer grid first)
+  std::shared_ptr<const HierarchicalPathGraph> graph_;
+
+  std::vector<std::thread> workers_;
+};
+
+} // namespace criogenio
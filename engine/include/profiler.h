@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Scoped CPU zone profiler. CRIO_PROFILE_ZONE("name") records the enclosing scope into a
+ * per-thread ring buffer (name must be a string literal or otherwise outlive the profiler).
+ * Build with CRIOGENIO_PROFILER=0 to compile every zone out.
+ */
+#ifndef CRIOGENIO_PROFILER
+#define CRIOGENIO_PROFILER 1
+#endif
+/** Per-system duration stats in World::Update / Render (defaults to the profiler switch). */
+#ifndef CRIOGENIO_SYSTEM_TIMING
+#define CRIOGENIO_SYSTEM_TIMING CRIOGENIO_PROFILER
+#endif
+
+namespace criogenio {
+
+struct ProfileZoneEvent {
+  const char *name = nullptr;
+  uint64_t startNs = 0;
+  uint64_t endNs = 0;
+  uint32_t depth = 0; // nesting level on its thread, 0 = outermost
+  uint32_t frame = 0; // Profiler::FrameIndex() when the zone closed
+};
+
+/**
+ * Zone sink. Each thread writes to its own fixed-size ring (oldest events are overwritten);
+ * rings are only locked against the reader, so recording never contends across threads.
+ * Recording can be paused at runtime (SetEnabled) for a single relaxed load per zone.
+ */
+class Profiler {
+public:
+  static constexpr size_t kRingCapacity = 1u << 14;
+
+  static Profiler &instance();
+  static uint64_t NowNs();
+
+  void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+  bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /** Frame boundary; call once per frame from the main loop thread (it becomes the "main" ring). */
+  void BeginFrame();
+  uint32_t FrameIndex() const { return frame_.load(std::memory_order_relaxed); }
+  /** Start time of the current frame and duration of the previous one. */
+  uint64_t FrameStartNs() const { return frameStartNs_; }
+  uint64_t LastFrameNs() const { return lastFrameNs_; }
+
+  /** Label for the calling thread in exports (copied). */
+  void SetThreadName(const char *name);
+
+  /** Main-thread zones that closed during `frame`, ordered by start time. */
+  std::vector<ProfileZoneEvent> CollectMainThreadFrame(uint32_t frame) const;
+  /** Every buffered zone on every thread as Chrome trace JSON (chrome://tracing, Perfetto). */
+  bool WriteChromeTrace(const std::string &path) const;
+  /** Drop every buffered zone (rings stay registered). */
+  void Clear();
+
+  // Used by ProfileScope.
+  uint32_t EnterZone();
+  void ExitZone(const char *name, uint64_t startNs, uint32_t depth);
+
+private:
+  Profiler() = default;
+
+  struct ThreadRing {
+    uint32_t id = 0;
+    std::string name;
+    uint32_t depth = 0;
+    uint64_t written = 0; // total events ever pushed; slot = written % kRingCapacity
+    std::vector<ProfileZoneEvent> events;
+    mutable std::mutex mutex;
+  };
+  ThreadRing &localRing();
+
+  std::atomic<bool> enabled_{true};
+  std::atomic<uint32_t> frame_{0};
+  uint64_t frameStartNs_ = 0;
+  uint64_t lastFrameNs_ = 0;
+  ThreadRing *mainRing_ = nullptr;
+  mutable std::mutex registryMutex_;
+  std::vector<std::unique_ptr<ThreadRing>> rings_;
+};
+
+/** RAII zone; prefer the CRIO_PROFILE_ZONE macro so zones vanish when compiled out. */
+class ProfileScope {
+public:
+  explicit ProfileScope(const char *name) : name_(name) {
+    Profiler &p = Profiler::instance();
+    if (!p.IsEnabled())
+      return;
+    depth_ = p.EnterZone();
+    startNs_ = Profiler::NowNs();
+    active_ = true;
+  }
+  ~ProfileScope() {
+    if (active_)
+      Profiler::instance().ExitZone(name_, startNs_, depth_);
+  }
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+  const char *name_;
+  uint64_t startNs_ = 0;
+  uint32_t depth_ = 0;
+  bool active_ = false;
+};
+
+/** Rolling window of the last kWindow duration samples: average, max and percentiles. */
+class TimingWindow {
+public:
+  static constexpr size_t kWindow = 240;
+
+  void Add(double ms);
+  void Reset();
+  size_t Count() const { return count_; }
+  uint64_t TotalSamples() const { return total_; }
+  double AvgMs() const { return count_ ? sum_ / static_cast<double>(count_) : 0.0; }
+  double MaxMs() const;
+  /** Nearest-rank percentile over the window, p in (0, 100]. */
+  double PercentileMs(double p) const;
+
+private:
+  std::array<float, kWindow> samples_{};
+  size_t next_ = 0;
+  size_t count_ = 0;
+  uint64_t total_ = 0;
+  double sum_ = 0.0;
+};
+
+/** Adds the scope's duration to a TimingWindow; use via CRIO_TIME_INTO. */
+class ScopedTimingSample {
+public:
+  explicit ScopedTimingSample(TimingWindow &window)
+      : window_(window), startNs_(Profiler::NowNs()) {}
+  ~ScopedTimingSample() {
+    window_.Add(static_cast<double>(Profiler::NowNs() - startNs_) / 1e6);
+  }
+  ScopedTimingSample(const ScopedTimingSample &) = delete;
+  ScopedTimingSample &operator=(const ScopedTimingSample &) = delete;
+
+private:
+  TimingWindow &window_;
+  uint64_t startNs_;
+};
+
+/**
+ * Time since construction, for a sample stored after the timed call returns (when the target
+ * TimingWindow may move during the call); use via CRIO_TIME_START / CRIO_TIME_STORE.
+ */
+class TimingStopwatch {
+public:
+  TimingStopwatch() : startNs_(Profiler::NowNs()) {}
+  double ElapsedMs() const { return static_cast<double>(Profiler::NowNs() - startNs_) / 1e6; }
+
+private:
+  uint64_t startNs_;
+};
+
+} // namespace criogenio
+
+#define CRIO_PROFILE_CONCAT_INNER(a, b) a##b
+#define CRIO_PROFILE_CONCAT(a, b) CRIO_PROFILE_CONCAT_INNER(a, b)
+#if CRIOGENIO_PROFILER
+#define CRIO_PROFILE_ZONE(name)                                                                \
+  ::criogenio::ProfileScope CRIO_PROFILE_CONCAT(crioProfileZone_, __LINE__)(name)
+#define CRIO_PROFILE_FRAME() ::criogenio::Profiler::instance().BeginFrame()
+#else
+#define CRIO_PROFILE_ZONE(name) ((void)0)
+#define CRIO_PROFILE_FRAME() ((void)0)
+#endif
+#if CRIOGENIO_SYSTEM_TIMING
+#define CRIO_TIME_INTO(window)                                                                 \
+  ::criogenio::ScopedTimingSample CRIO_PROFILE_CONCAT(crioTimingSample_, __LINE__)(window)
+#define CRIO_TIME_START(name) const ::criogenio::TimingStopwatch name
+#define CRIO_TIME_STORE(name, window) (window).Add((name).ElapsedMs())
+#else
+#define CRIO_TIME_INTO(window) ((void)0)
+#define CRIO_TIME_START(name) ((void)0)
+#define CRIO_TIME_STORE(name, window) ((void)0)
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "graphics_types.h"
+#include <cstdint>
 #include <functional>
 #include <string>
 
@@ -22,6 +23,11 @@ public:
   void SetViewport(int width, int height);
   void BeginCamera2D(const Camera2D& camera);
   void EndCamera2D();
+  /**
+   * World-space rect covered by the viewport under the active 2D camera (rotation ignored,
+   * like the draw path). False outside BeginCamera2D/EndCamera2D: callers should not cull.
+   */
+  bool GetCameraWorldBounds(Rect& out) const;
 
   void DrawTexture(TextureHandle texture, float x, float y);
   void DrawRect(float x, float y, float w, float h, Color color);
@@ -50,12 +56,55 @@ public:
   void DrawLine(float x1, float y1, float x2, float y2, Color color);
   void DrawGrid(int slices, float spacing);
 
+  /**
+   * Sprite batching. Between BeginSpriteBatch / EndSpriteBatch (nestable), SubmitSprite and the
+   * DrawTexturePro / DrawTextureProFlipped / DrawTextureRec calls append textured quads (tint in
+   * vertex colour) instead of drawing; consecutive quads sharing texture + blend mode go out as
+   * one SDL_RenderGeometry call. A texture/blend change, any other draw call, a render-target
+   * switch, FlushSpriteBatch, the outermost EndSpriteBatch or EndFrame flushes, so submission
+   * order is always preserved. Outside a batch, SubmitSprite draws immediately. Either way a
+   * sprite rotates about `origin`, relative to the top-left of `dest` (see RotatedQuadCorners).
+   * EndFrame reports a BeginSpriteBatch left without its EndSpriteBatch.
+   */
+  void BeginSpriteBatch();
+  void SubmitSprite(TextureHandle texture, Rect source, Rect dest, Vec2 origin, float rotation,
+                    Color tint, TextureBlendMode blend = TextureBlendMode::Alpha,
+                    bool flipH = false, bool flipV = false);
+  void FlushSpriteBatch();
+  void EndSpriteBatch();
+  bool IsSpriteBatchActive() const;
+  struct SpriteBatchStats {
+    uint32_t quads = 0;
+    uint32_t drawCalls = 0;
+  };
+  /** Batched quads and geometry calls in the last completed frame. */
+  SpriteBatchStats GetSpriteBatchStats() const;
+
   /** Blend mode for `DrawRect` / `DrawFilledCircleScreen` (not textures). Default is alpha. */
   void SetRenderDrawBlendMode(TextureBlendMode blend);
   /** Axis-aligned rect in raw window pixels; ignores the 2D camera (for post-world fullscreen passes). */
   void DrawRectScreen(float x, float y, float w, float h, Color color);
-  /** Filled disk in window pixel space; ignores the 2D camera. */
+  /**
+   * Filled disk in window pixel space; ignores the 2D camera. One textured quad from the radial
+   * texture cache (batched while a sprite batch is open), honouring SetRenderDrawBlendMode.
+   */
   void DrawFilledCircleScreen(float centerX, float centerY, float radius, Color color);
+  /**
+   * Soft disk: alpha is 1 inside (1 - falloff) * radius and fades linearly to 0 at the edge
+   * (falloff 0 = hard disk, 1 = gradient from the centre). Same path as DrawFilledCircleScreen.
+   */
+  void DrawRadialGradientScreen(float centerX, float centerY, float radius, float falloff,
+                                Color color);
+  /**
+   * Cached white radial texture (alpha = coverage) for `radius` / `falloff`. Radius is rounded
+   * up to a power-of-two texture size (kRadialTextureMinSize..kRadialTextureMaxSize) and falloff
+   * to 1/kRadialFalloffSteps, so the cache stays small. Owned by the renderer; do not unload.
+   */
+  TextureHandle GetRadialTexture(float radius, float falloff = 0.f);
+  static constexpr int kRadialTextureMinSize = 16;
+  static constexpr int kRadialTextureMaxSize = 512;
+  static constexpr int kRadialFalloffSteps = 16;
+  size_t GetRadialTextureCacheSize() const;
 
   bool WindowShouldClose() const;
   /**
@@ -68,6 +117,8 @@ public:
   int GetViewportHeight() const;
 
   TextureHandle LoadTexture(const std::string& path);
+  /** Static texture from tightly packed R,G,B,A bytes (generated images); free with UnloadTexture. */
+  TextureHandle CreateTextureFromPixels(int width, int height, const uint8_t* rgba);
   void UnloadTexture(TextureHandle* handle);
 
   // Render target (for editor scene view). CreateRenderTarget -> SetRenderTarget -> draw -> UnsetRenderTarget.
@@ -75,6 +126,13 @@ public:
   void SetRenderTarget(TextureHandle target);
   void UnsetRenderTarget();
   void DestroyRenderTarget(TextureHandle* target);
+  bool IsRenderTargetActive() const;
+
+  // Off-screen baking: PushRenderTarget redirects drawing into target in its own pixel space
+  // (camera suspended, optionally cleared to transparent); PopRenderTarget restores the previous
+  // target, viewport and camera. Pushes nest.
+  void PushRenderTarget(TextureHandle target, bool clear = true);
+  void PopRenderTarget();
 
   Vec2 GetMousePosition() const;
 
@@ -83,4 +141,11 @@ public:
   void* GetRendererHandle() const;
 };
 
+/**
+ * Screen corners (top-left, top-right, bottom-right, bottom-left) of `dst` rotated `rotation`
+ * degrees clockwise about `dst` top-left + `pivot`: the quad SDL_RenderTextureRotated draws for
+ * that rect and center. Batched sprites are built from it so they match immediate draws.
+ */
+void RotatedQuadCorners(const Rect& dst, Vec2 pivot, float rotation, Vec2 out[4]);
+
 } // namespace criogenio
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ecs_core.h"
+#include "graphics_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace criogenio {
+
+/**
+ * Uniform spatial hash of entity AABBs in world pixels. An entity whose bounds span several
+ * cells is listed in each of them; queries de-duplicate. Update() with bounds that stay in
+ * the same cell range only rewrites the stored rect, so refreshing mostly-static entities
+ * every frame is cheap.
+ */
+class SpatialHashGrid2D {
+public:
+  static constexpr float kDefaultCellSize = 256.f;
+
+  explicit SpatialHashGrid2D(float cellSize = kDefaultCellSize);
+
+  /** Changing the cell size drops every entry. */
+  void SetCellSize(float cellSize);
+  float GetCellSize() const { return cellSize_; }
+  void Clear();
+
+  /** Insert `id` or move it to `bounds`. */
+  void Update(ecs::EntityId id, const Rect &bounds);
+  void Remove(ecs::EntityId id);
+  bool Contains(ecs::EntityId id) const;
+  /** Stored bounds, or nullptr when `id` is not indexed. */
+  const Rect *GetBounds(ecs::EntityId id) const;
+  size_t Size() const { return live_.size(); }
+
+  /**
+   * Full-refresh helpers: call BeginSync(), Update() every entity that should stay indexed,
+   * then EndSync() to drop the ones that were not touched (destroyed / lost the component).
+   */
+  void BeginSync();
+  void EndSync();
+
+  /**
+   * Append every id whose bounds overlap `area` (each id once). Cells are visited in
+   * row-major order, so results are stable while the area and entities stay in their cells.
+   */
+  void QueryRect(const Rect &area, std::vector<ecs::EntityId> &out) const;
+  /** Append every id whose bounds come within `radius` of (cx, cy), in QueryRect order. */
+  void QueryRadius(float cx, float cy, float radius, std::vector<ecs::EntityId> &out) const;
+  /**
+   * Append up to `k` ids whose bounds lie within `maxRadius` of (cx, cy), nearest first
+   * (distance to the closest point of the bounds; ties broken by lower id).
+   */
+  void QueryNearest(float cx, float cy, float maxRadius, size_t k,
+                    std::vector<ecs::EntityId> &out) const;
+
+  /** Squared distance from (px, py) to the closest point of `r` (0 inside). */
+  static float DistanceSqToRect(const Rect &r, float px, float py);
+
+private:
+  struct Item {
+    Rect bounds{};
+    int minCx = 0, minCy = 0, maxCx = 0, maxCy = 0;
+    uint32_t liveIndex = 0;
+    uint32_t syncStamp = 0;
+    mutable uint32_t queryStamp = 0;
+    bool present = false;
+  };
+
+  static uint64_t CellKey(int cx, int cy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+  }
+  int CellCoord(float v) const;
+  void LinkCells(ecs::EntityId id, const Item &item);
+  void UnlinkCells(ecs::EntityId id, const Item &item);
+  void VisitCell(int cx, int cy, const Rect &area, std::vector<ecs::EntityId> &out) const;
+
+  float cellSize_ = kDefaultCellSize;
+  std::unordered_map<uint64_t, std::vector<ecs::EntityId>> cells_;
+  std::vector<Item> items_; // indexed by entity id
+  std::vector<ecs::EntityId> live_;
+  uint32_t syncStamp_ = 0;
+  mutable uint32_t queryStamp_ = 0;
+};
+
+} // namespace criogenio
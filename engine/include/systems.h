@@ -11,6 +11,8 @@ public:
   virtual ~ISystem() = default;
   virtual void Update(float dt) = 0;
   virtual void Render(Renderer &renderer) = 0;
+  /** Stable label for profiler zones and per-system timing (string literal). */
+  virtual const char *SystemName() const { return "System"; }
 };
 
 } // namespace criogenio
@@ -7,8 +7,10 @@
 #include "resources.h"
 #include "serialization.h"
 #include "tmx_metadata.h"
+#include <compare>
 #include <map>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -26,6 +28,13 @@ struct ChunkedLayer {
   std::map<ChunkKey, std::vector<int>> chunks; // (cx, cy) -> tiles[chunkSize*chunkSize]
 };
 
+/** Layer-qualified chunk address (dirty tracking, terrain replication). */
+struct TerrainChunkRef {
+  int layer = 0;
+  ChunkKey chunk{0, 0};
+  auto operator<=>(const TerrainChunkRef &) const = default;
+};
+
 // ---- Tiled GID flip-bit encoding ---------------------------------------
 // Tiled stores per-tile flips/rotation in the top 3 bits of the 32-bit GID.
 // We keep these bits in the engine's `int` cells so they round-trip through
@@ -87,6 +96,54 @@ struct TmxTilesetEntry {
   std::map<int, std::vector<TmxProperty>> tileProperties;
 };
 
+/**
+ * Render-target cache behind Terrain2D chunk baking: one texture per (layer, chunk) holding the
+ * chunk's tiles pre-drawn at native size. Owns its textures; a copy starts empty.
+ */
+struct TerrainChunkBakeCache {
+  struct Entry {
+    TextureHandle target;
+    bool dirty = true;
+    bool empty = false; // every cell blank: nothing to draw, no texture
+    uint64_t lastUsedFrame = 0;
+  };
+
+  TerrainChunkBakeCache() = default;
+  TerrainChunkBakeCache(const TerrainChunkBakeCache &) {}
+  TerrainChunkBakeCache &operator=(const TerrainChunkBakeCache &other) {
+    if (this != &other)
+      Clear();
+    return *this;
+  }
+  ~TerrainChunkBakeCache() { Clear(); }
+
+  /** Destroy every baked texture. */
+  void Clear();
+  void Release(Entry &e);
+
+  std::map<TerrainChunkRef, Entry> entries;
+  Renderer *renderer = nullptr;
+  uint64_t frame = 0;
+  int bakesThisFrame = 0;
+  /** Inputs the baked pixels depend on; any change drops the cache. */
+  uint64_t assetGeneration = 0;
+  size_t layerCount = 0;
+  int chunkSize = 0;
+  int stepX = 0;
+  int stepY = 0;
+  bool gidMode = false;
+  uint64_t bakes = 0;
+  uint64_t evictions = 0;
+};
+
+/** Resolved draw data for one Tiled GID (flip bits stripped); see Terrain2D::LookupTmxGid. */
+struct TmxGidEntry {
+  const TextureResource *atlas = nullptr;
+  Rect source{};
+  int tilesetIndex = -1; // into Terrain2D::tmxTilesets
+  int localId = -1;      // tile index within that tileset
+};
+
 // Think about the 3D terrain
 
 class Terrain {
@@ -125,6 +182,48 @@ public:
                    const std::string &asset_root_dir = {});
   void SetAtlas(int layer, const char *path);
 
+  // ---- Runtime edit tracking (feeds MsgType::TerrainDelta replication) ----
+  /**
+   * When enabled, SetTile / FillLayer / ClearLayer record the chunks they touch. Off by
+   * default so editor painting and TMX loading pay nothing; ReplicationServer turns it on.
+   * Enabling resets both the dirty set and the edit history.
+   */
+  void SetChunkChangeTracking(bool enabled);
+  bool IsChunkChangeTrackingEnabled() const { return trackChunkChanges_; }
+  /** Move chunks dirtied since the last call into `out` (sorted). Returns false when none. */
+  bool ConsumeDirtyChunks(std::vector<TerrainChunkRef> &out);
+  /** Every chunk edited since tracking was enabled (what a late joiner is missing). */
+  const std::set<TerrainChunkRef> &EditedChunks() const { return editedChunks_; }
+  /** Raw chunk cells (chunkSize*chunkSize), or nullptr when the chunk is not allocated. */
+  const std::vector<int> *FindChunkTiles(int layerIndex, ChunkKey key) const;
+  /**
+   * Replace a whole chunk (replication apply path). Empty `tiles` removes the chunk; any
+   * other size than chunkSize*chunkSize is ignored. Not recorded by change tracking.
+   */
+  void ApplyChunkTiles(int layerIndex, ChunkKey key, std::vector<int> tiles);
+
+  // ---- Chunk baking ----
+  /**
+   * With a camera active (and no editor render target bound), each visible chunk is drawn as
+   * one quad from a cached texture instead of chunkSize^2 tile blits. SetTile re-bakes its
+   * chunk; bulk edits, layer/tileset changes and atlas hot reload drop the whole cache.
+   * Chunks that cannot be baked this frame (per-frame bake limit, budget full of chunks in use)
+   * fall back to per-tile drawing.
+   */
+  static constexpr size_t kDefaultChunkBakeBudget = 256;
+  static constexpr int kMaxChunkBakesPerFrame = 8;
+  /** Max baked chunk textures kept (least recently drawn evicted first); 0 disables baking. */
+  void SetChunkBakeBudget(size_t maxChunks);
+  size_t GetChunkBakeBudget() const { return chunkBakeBudget_; }
+  /** Drop every baked chunk; needed only after writing `layers` directly instead of via SetTile. */
+  void InvalidateChunkBakes() { chunkBakes_.Clear(); }
+  struct ChunkBakeStats {
+    size_t cached = 0;
+    uint64_t bakes = 0;
+    uint64_t evictions = 0;
+  };
+  ChunkBakeStats GetChunkBakeStats() const;
+
   // Visible tile range in world coords (for editor grid / culling)
   void GetVisibleTileRange(const Camera2D &camera, float viewWidth, float viewHeight,
                            int &minTx, int &minTy, int &maxTx, int &maxTy) const;
@@ -140,6 +239,18 @@ public:
   bool TmxFootprintOverlapsSolid(float rectLeft, float rectTop, float w, float h) const;
   void ClearTmxState();
 
+  /**
+   * GID -> atlas + source rect table, built by BeginTmxMode and whenever Render sees
+   * `tmxTilesets` change. Callers that edit `tmxTilesets` and look up before the next Render
+   * call RebuildTmxGidLookup themselves. Returns nullptr for 0 / unmapped GIDs.
+   */
+  const TmxGidEntry *LookupTmxGid(uint32_t gid) const {
+    return gid < tmxGidLookup_.size() && tmxGidLookup_[gid].tilesetIndex >= 0
+               ? &tmxGidLookup_[gid]
+               : nullptr;
+  }
+  void RebuildTmxGidLookup();
+
   /**
    * Rebuild `tmxMeta.collisionSolid` from layers whose name contains "collision" or have
    * property `collides=true`, plus object groups whose name contains "collision".
@@ -172,17 +283,54 @@ private:
   friend class TilemapLoader;
   void BeginTmxMode(int mapTileW, int mapTileH, std::vector<TmxTilesetEntry> entries);
   void SetTmxLogicalExtent(int tilesW, int tilesH);
-  const TmxTilesetEntry *FindTmxTileset(uint32_t gid) const;
-  void RenderChunkedLayerGid(Renderer &renderer, const ChunkedLayer &layer,
-                             float alpha = 1.0f) const;
-  void RenderChunkedLayerTileIndex(Renderer &renderer, const ChunkedLayer &layer,
-                                   float alpha = 1.0f) const;
+  /** Cheap digest of `tmxTilesets` layout, to notice direct edits (editor, level import). */
+  uint64_t TmxTilesetsFingerprint() const;
+  /** Visible tile range (inclusive, one-tile margin) and the chunks containing it. */
+  struct ChunkCellRange {
+    int minTx = 0, minTy = 0, maxTx = -1, maxTy = -1;
+    int minCx = 0, minCy = 0, maxCx = -1, maxCy = -1;
+  };
+  /** False when the renderer has no active 2D camera (nothing to cull against). */
+  bool VisibleChunkCells(const Renderer &renderer, int stepX, int stepY,
+                         ChunkCellRange &out) const;
+  /**
+   * Calls fn(cx, cy, tiles, lx0, ly0, lx1, ly1) for each allocated chunk of `layer` under the
+   * camera, with the inclusive local cell range that is on screen.
+   */
+  template <typename ChunkFn>
+  void ForEachVisibleChunk(const Renderer &renderer, const ChunkedLayer &layer, int stepX,
+                           int stepY, ChunkFn &&fn) const;
+  void RenderChunkedLayerGid(Renderer &renderer, int layerIndex, float alpha = 1.0f);
+  void RenderChunkedLayerTileIndex(Renderer &renderer, int layerIndex, float alpha = 1.0f);
+  /** Draw local cells [lx0..lx1]x[ly0..ly1] of one chunk with cell (0,0) at (baseX, baseY). */
+  void DrawChunkCellsGid(Renderer &renderer, const std::vector<int> &tiles, int lx0, int ly0,
+                         int lx1, int ly1, float baseX, float baseY, Color tint) const;
+  void DrawChunkCellsTileIndex(Renderer &renderer, const std::vector<int> &tiles, int lx0,
+                               int ly0, int lx1, int ly1, float baseX, float baseY,
+                               Color tint) const;
+  /** Per-frame cache bookkeeping; returns whether baked drawing is usable this frame. */
+  bool BeginChunkBakeFrame(Renderer &renderer);
+  /** Draw a chunk from its baked texture (baking it first if needed); false = draw per tile. */
+  bool DrawBakedChunk(Renderer &renderer, int layerIndex, int cx, int cy,
+                      const std::vector<int> &tiles, Color tint);
+  bool EvictChunkBakeForInsert();
+  void MarkChunkBakeDirty(int layerIndex, ChunkKey key);
+  void MarkLayerBakesDirty(int layerIndex);
+  void MarkChunkChanged(int layerIndex, ChunkKey key);
 
   bool gidMode_ = false;
   int mapTilePxW_ = 0;
   int mapTilePxH_ = 0;
   int logicalMapTilesW_ = 0;
   int logicalMapTilesH_ = 0;
+  bool trackChunkChanges_ = false;
+  std::set<TerrainChunkRef> dirtyChunks_;
+  std::set<TerrainChunkRef> editedChunks_;
+  std::vector<TmxGidEntry> tmxGidLookup_;
+  uint64_t tmxGidLookupFingerprint_ = 0;
+  size_t chunkBakeBudget_ = kDefaultChunkBakeBudget;
+  bool chunkBakingThisFrame_ = false;
+  TerrainChunkBakeCache chunkBakes_;
 };
 
 class Terrain3D : public Terrain {
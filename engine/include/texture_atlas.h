@@ -0,0 +1,120 @@
+#pragma once
+
+#include "graphics_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace criogenio {
+
+class Renderer;
+struct TextureResource;
+
+/**
+ * Skyline bottom-left rectangle packer for one fixed-size page. Rects are placed where their
+ * top edge ends lowest (ties: narrowest skyline segment), which keeps pages dense for the
+ * mixed sprite-sheet sizes the runtime atlas sees. Insert-only; Reset() empties the page.
+ */
+class SkylinePacker {
+public:
+  SkylinePacker(int width = 0, int height = 0);
+
+  void Reset(int width, int height);
+  /** Place a w x h rect; false when it does not fit anywhere on the page. */
+  bool Insert(int w, int h, int &outX, int &outY);
+
+  int Width() const { return width_; }
+  int Height() const { return height_; }
+  /** Fraction of the page area covered by inserted rects. */
+  float Occupancy() const;
+
+private:
+  struct Segment {
+    int x = 0;
+    int y = 0; // top of free space above this span
+    int width = 0;
+  };
+  bool Fit(size_t index, int w, int h, int &outY) const;
+
+  std::vector<Segment> skyline_;
+  int width_ = 0;
+  int height_ = 0;
+  long long usedArea_ = 0;
+};
+
+/** Where a packed source texture lives: page texture plus the source's top-left on it. */
+struct AtlasPlacement {
+  std::shared_ptr<TextureResource> page;
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+/**
+ * Runtime texture atlas: sprite sheets and animation textures are copied on first use into a
+ * few large render-target pages, so sprite batches draw whole scenes from a handful of
+ * textures. Authored rects (AnimationFrame::rect, Sprite source rects) are left untouched; the
+ * draw path remaps them to page coordinates with Remap(). Packed sources are kept alive by the
+ * atlas. Any AssetManager generation bump (unload, hot reload) drops every page and placement;
+ * textures are repacked as they are drawn again.
+ */
+class RuntimeTextureAtlas {
+public:
+  static constexpr int kPageSize = 2048;
+  /** Transparent gutter around each source so linear filtering does not bleed neighbours. */
+  static constexpr int kPadding = 2;
+  /** Sources with a larger side stay standalone (they would crowd out everything else). */
+  static constexpr int kMaxPackedSide = 1024;
+
+  static RuntimeTextureAtlas &instance();
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const { return enabled_; }
+
+  /** Placement for `source`, packing it on first use; nullptr = draw from the source itself. */
+  const AtlasPlacement *Resolve(Renderer &renderer,
+                                const std::shared_ptr<TextureResource> &source);
+  /**
+   * When `source` is packed and `rect` lies inside it, swap `texture` for the page and offset
+   * `rect` into page coordinates. Returns whether anything changed.
+   */
+  bool Remap(Renderer &renderer, const std::shared_ptr<TextureResource> &source,
+             TextureHandle &texture, Rect &rect);
+
+  /** Destroy every page and forget every placement. */
+  void Clear();
+
+  struct Stats {
+    size_t pages = 0;
+    size_t packed = 0;
+    size_t standalone = 0; // too large, or no page could be created
+    float occupancy = 0.f; // average over pages
+  };
+  Stats GetStats() const;
+
+private:
+  RuntimeTextureAtlas() = default;
+
+  struct Page {
+    std::shared_ptr<TextureResource> texture;
+    SkylinePacker packer;
+  };
+  struct Entry {
+    std::shared_ptr<TextureResource> source; // keeps the key pointer from being reused
+    AtlasPlacement placement;
+    bool packed = false;
+  };
+  Entry &PackSource(Renderer &renderer, const std::shared_ptr<TextureResource> &source);
+  Page *CreatePage(Renderer &renderer);
+
+  std::vector<Page> pages_;
+  std::unordered_map<const TextureResource *, Entry> entries_;
+  uint64_t assetGeneration_ = 0;
+  bool enabled_ = true;
+  bool pagesUnavailable_ = false; // render targets failed this generation; stop retrying
+};
+
+} // namespace criogenio
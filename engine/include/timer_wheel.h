@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace criogenio {
+
+/**
+ * Hierarchical timer wheel over integer ticks (callers pick the unit, e.g. milliseconds).
+ * Four levels of 64 slots cover 64^4 ticks; later deadlines park in the top level and are
+ * re-filed as the wheel turns. Schedule is O(1); Advance costs one slot per elapsed tick plus
+ * the timers it fires or cascades, and jumps straight to the target when nothing is pending.
+ * Timers are opaque 64-bit keys and cannot be cancelled: callers ignore stale firings.
+ */
+class TimerWheel {
+public:
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 6;
+  static constexpr uint64_t kSlots = uint64_t{1} << kSlotBits;
+
+  uint64_t Now() const { return now_; }
+  size_t Pending() const { return pending_; }
+  void Clear(uint64_t now = 0);
+
+  /** Fire `key` once the wheel reaches `due` (deadlines not after Now() fire on the next tick). */
+  void Schedule(uint64_t key, uint64_t due);
+  /** Turn the wheel to `now`, appending fired keys to `fired` in deadline order. */
+  void Advance(uint64_t now, std::vector<uint64_t> &fired);
+
+private:
+  struct Timer {
+    uint64_t key = 0;
+    uint64_t due = 0;
+  };
+  void file(const Timer &t);
+
+  std::vector<Timer> slots_[kLevels][kSlots];
+  uint64_t now_ = 0;
+  size_t pending_ = 0;
+};
+
+} // namespace criogenio
@@ -145,6 +145,8 @@ struct TmxMapMetadata {
   int collisionStrideTiles = 0;
   int collisionHeightTiles = 0;
   std::vector<uint8_t> collisionSolid;
+  /** Bumped whenever `collisionSolid` is rebuilt in place (path caches compare it). */
+  uint32_t collisionRevision = 0;
 
   void clear() {
     infinite = false;
@@ -5,19 +5,48 @@
 #include "box3d/fp_camera.h"
 #include "ecs_core.h"
 #include "ecs_registry.h"
+#include "gameplay_tags.h"
 #include "graphics_types.h"
+#include "profiler.h"
 #include "render.h"
+#include "spatial_grid.h"
 #include "systems.h"
 #include "terrain.h"
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 namespace criogenio {
 
+class AnimatedSprite;
+
+/** Components whose writes can move an entity in World::GetSpatialIndex() / GetSpriteIndex(). */
+template <typename T>
+inline constexpr bool kSpatiallyIndexed = std::is_same_v<T, Transform> ||
+                                          std::is_same_v<T, BoxCollider> ||
+                                          std::is_same_v<T, WorldPickup> ||
+                                          std::is_same_v<T, Sprite>;
+
+/**
+ * Components whose add / remove re-indexes an entity. AnimatedSprite is bounded by its
+ * animation's largest frame, so ticking it does not; code that swaps its `animationId` calls
+ * World::MarkSpatialDirty.
+ */
+template <typename T>
+inline constexpr bool kSpatialMembership = kSpatiallyIndexed<T> ||
+                                           std::is_same_v<T, AnimatedSprite>;
+
+/** Rolling update / render durations for one registered system (see World::GetSystemTimings). */
+struct SystemTiming {
+  std::string name; // ISystem::SystemName() at registration
+  TimingWindow update;
+  TimingWindow render;
+};
+
 // ============================================================================
 // World: ECS-based World
 // ============================================================================
@@ -62,23 +91,42 @@ public:
   template <typename T, typename... Args>
   T &AddComponent(ecs::EntityId entity_id, Args &&...args) {
     T component(std::forward<Args>(args)...);
-    return ecs::Registry::instance().add_component<T>(entity_id, component);
+    T &ref = ecs::Registry::instance().add_component<T>(entity_id, component);
+    if constexpr (kSpatialMembership<T>)
+      MarkSpatialDirty(entity_id);
+    return ref;
   }
 
+  /**
+   * Mutable access to a spatially indexed component marks the entity for re-indexing, since the
+   * caller may move it. Use ReadComponent for reads that should not.
+   */
   template <typename T> T *GetComponent(ecs::EntityId entity_id) {
-    return ecs::Registry::instance().get_component<T>(entity_id);
+    T *component = ecs::Registry::instance().get_component<T>(entity_id);
+    if constexpr (kSpatiallyIndexed<T>) {
+      if (component)
+        MarkSpatialDirty(entity_id);
+    }
+    return component;
   }
 
   template <typename T> const T *GetComponent(ecs::EntityId entity_id) const {
     return ecs::Registry::instance().get_component<T>(entity_id);
   }
 
+  /** Read-only access that never marks the entity dirty, callable on a mutable World. */
+  template <typename T> const T *ReadComponent(ecs::EntityId entity_id) const {
+    return ecs::Registry::instance().get_component<T>(entity_id);
+  }
+
   template <typename T> bool HasComponent(ecs::EntityId entity_id) const {
     return ecs::Registry::instance().has_component<T>(entity_id);
   }
 
   template <typename T> void RemoveComponent(ecs::EntityId entity_id) {
     ecs::Registry::instance().remove_component<T>(entity_id);
+    if constexpr (kSpatialMembership<T>)
+      MarkSpatialDirty(entity_id);
   }
 
   // Query (new ECS style - more efficient)
@@ -119,12 +167,22 @@ public:
   template <typename T, typename... Args> T *AddSystem(Args &&...args) {
     auto sys = std::make_unique<T>(std::forward<Args>(args)...);
     T *ptr = sys.get();
+    systemTimings_.push_back(SystemTiming{sys->SystemName(), {}, {}});
     systems.push_back(std::move(sys));
     return ptr;
   }
   /** Remove all registered systems (e.g. to swap between editor and game mode systems). */
   void ClearSystems();
 
+  /**
+   * Per-system timings in registration order, recorded by Update / Render when built with
+   * CRIOGENIO_SYSTEM_TIMING (otherwise the windows stay empty and nothing is timed).
+   */
+  const std::vector<SystemTiming> &GetSystemTimings() const { return systemTimings_; }
+  /** First system registered under `name`, or nullptr. */
+  const SystemTiming *FindSystemTiming(const std::string &name) const;
+  void ResetSystemTimings();
+
   // World Update
   void OnUpdate(std::function<void(float)> fn);
   void Update(float dt);
@@ -181,15 +239,64 @@ public:
   /** Computes 2D center from Transform top-left plus explicit sprite extents. */
   bool TryGetEntityCenter2D(ecs::EntityId id, float width, float height, Vec2 *outCenter) const;
 
+  /**
+   * Shared proximity index over every entity with a Transform. Bounds are the BoxCollider
+   * rect when present, else the WorldPickup footprint, else the position as a point. Adding,
+   * removing or taking a mutable pointer to a Transform / BoxCollider / WorldPickup marks the
+   * entity dirty, and the next query re-indexes only the dirty entities. Per-frame reads (queries,
+   * culling, AI distance checks) go through ReadComponent so unmoved entities stay clean. Code
+   * that keeps a mutable pointer across a query and writes through it afterwards must call
+   * MarkSpatialDirty().
+   */
+  const SpatialHashGrid2D &GetSpatialIndex();
+  void MarkSpatialDirty(ecs::EntityId id) {
+    if (id == ecs::NULL_ENTITY)
+      return;
+    if (id >= spatialDirtyFlags_.size())
+      spatialDirtyFlags_.resize(static_cast<size_t>(id) + 1, 0);
+    if (!spatialDirtyFlags_[id]) {
+      spatialDirtyFlags_[id] = 1;
+      spatialDirty_.push_back(id);
+    }
+  }
+  /**
+   * Draw-culling index over every Transform with a Sprite or AnimatedSprite, keyed by the
+   * rotation-aware bounds SpriteSystem / RenderSystem draw (an AnimatedSprite at its animation's
+   * largest frame). Refreshed from the same dirty marks as GetSpatialIndex, plus every
+   * AnimatedSprite after an AnimationDatabase clip edit.
+   */
+  const SpatialHashGrid2D &GetSpriteIndex();
+  /** Sprites whose draw bounds overlap `area`. */
+  void QuerySpritesInRect(const Rect &area, std::vector<ecs::EntityId> &out);
+  /** True while `id` waits to be re-indexed by the next GetSpatialIndex(). */
+  bool IsSpatialDirty(ecs::EntityId id) const {
+    return id < spatialDirtyFlags_.size() && spatialDirtyFlags_[id] != 0;
+  }
+  /** Entities whose indexed bounds overlap `area` (see SpatialHashGrid2D::QueryRect). */
+  void QueryEntitiesInRect(const Rect &area, std::vector<ecs::EntityId> &out);
+  /** Entities whose indexed bounds come within `radius` of `center`. */
+  void QueryEntitiesInRadius(Vec2 center, float radius, std::vector<ecs::EntityId> &out);
+  /** Up to `k` entities within `maxRadius` of `center`, nearest first. */
+  void QueryNearestEntities(Vec2 center, float maxRadius, size_t k,
+                            std::vector<ecs::EntityId> &out);
+
 private:
   bool spriteSortByGroundY_ = false;
   ecs::EntityId mainCameraEntity = ecs::NULL_ENTITY;
   ecs::EntityId mainCamera3DEntity = ecs::NULL_ENTITY;
   std::unordered_map<size_t, std::unique_ptr<GlobalComponent>> globalComponents;
   std::vector<std::unique_ptr<ISystem>> systems;
+  std::vector<SystemTiming> systemTimings_; // parallel to `systems`
   std::unique_ptr<Terrain2D> terrain;
   std::function<void(float)> userUpdate = nullptr;
 
+  void SyncSpatialIndices();
+  SpatialHashGrid2D spatialIndex_{128.f};
+  SpatialHashGrid2D spriteIndex_{128.f};
+  uint64_t spriteAnimGeneration_ = 0; // AnimationDatabase::generation() last indexed
+  std::vector<ecs::EntityId> spatialDirty_;
+  std::vector<uint8_t> spatialDirtyFlags_; // indexed by entity id
+
   // Entity name tracking (optional, for debugging)
   std::unordered_map<ecs::EntityId, std::string> entity_names;
 };
@@ -1,4 +1,6 @@
 #include "animation_database.h"
+#include "asset_manager.h"
+#include "resources.h"
 #include <string>
 #include <algorithm>
 
@@ -20,6 +22,12 @@ void AnimationDatabase::addClip(AssetId animId, const AnimationClip &clip) {
   auto it = animations_.find(animId);
   if (it != animations_.end()) {
     it->second.clips.push_back(clip);
+    Vec2 &ext = it->second.maxFrameSize;
+    for (const AnimationFrame &f : clip.frames) {
+      ext.x = std::max(ext.x, f.rect.width);
+      ext.y = std::max(ext.y, f.rect.height);
+    }
+    ++generation_;
   }
 }
 
@@ -50,6 +58,15 @@ const AnimationDef *AnimationDatabase::getAnimation(AssetId animId) const {
   return (it != animations_.end()) ? &it->second : nullptr;
 }
 
+TextureResource *AnimationDatabase::resolveTexture(const AnimationDef &def) {
+  const uint64_t gen = AssetManager::instance().generation();
+  if (def.textureGeneration != gen) {
+    def.texture = AssetManager::instance().load<TextureResource>(def.texturePath);
+    def.textureGeneration = gen;
+  }
+  return def.texture.get();
+}
+
 const AnimationClip *
 AnimationDatabase::getClip(AssetId animId, const std::string &clipName) const {
   const auto *animDef = getAnimation(animId);
@@ -75,11 +92,20 @@ void AnimationDatabase::removeClip(AssetId animId,
                                return c.name == clipName;
                              }),
               clips.end());
+  Vec2 &ext = it->second.maxFrameSize;
+  ext = {0.f, 0.f};
+  for (const AnimationClip &c : clips)
+    for (const AnimationFrame &f : c.frames) {
+      ext.x = std::max(ext.x, f.rect.width);
+      ext.y = std::max(ext.y, f.rect.height);
+    }
+  ++generation_;
 }
 
 void AnimationDatabase::clear() {
   animations_.clear();
   nextId_ = INVALID_ASSET_ID + 1;
+  ++generation_;
 }
 
 std::string AnimationDatabase::setTexturePath(AssetId animId,
@@ -89,6 +115,8 @@ std::string AnimationDatabase::setTexturePath(AssetId animId,
     return std::string();
   std::string old = it->second.texturePath;
   it->second.texturePath = newPath;
+  it->second.texture.reset();
+  it->second.textureGeneration = 0;
   return old;
 }
 
@@ -18,6 +18,7 @@ void AssetManager::unload(const std::string &path) {
     else
       ++it;
   }
+  generation_.fetch_add(1, std::memory_order_acq_rel);
 }
 
 void AssetManager::registerHotReloadCallback(const std::string &path,
@@ -52,6 +53,9 @@ void AssetManager::triggerHotReload(const std::string &path) {
     }
   }
 
+  if (!keysToReload.empty())
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+
   // invoke callbacks
   std::vector<HotReloadCallback> cbs;
   {
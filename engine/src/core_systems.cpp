@@ -9,8 +9,10 @@
 #include "keys.h"
 #include "math.h"
 #include "object_layer.h"
+#include "path_service.h"
 #include "resources.h"
 #include "terrain.h"
+#include "texture_atlas.h"
 #include <algorithm>
 #include <cctype>
 #include <chrono>
@@ -189,6 +191,22 @@ int EffectiveSpriteDrawOrder(const World &world, ecs::EntityId id) {
   return order;
 }
 
+/**
+ * Entities with `T` to draw this frame: the world sprite index under the camera rect, or every
+ * one when no camera is active. The index also holds the other sprite kind, so filter by `T`.
+ */
+template <typename T>
+void CollectVisibleSprites(World &world, Renderer &renderer, std::vector<ecs::EntityId> &ids) {
+  Rect view;
+  if (!renderer.GetCameraWorldBounds(view)) {
+    world.GetEntitiesWith<T>(ids);
+    return;
+  }
+  ids.clear();
+  world.QuerySpritesInRect(view, ids);
+  std::erase_if(ids, [&world](ecs::EntityId id) { return !world.HasComponent<T>(id); });
+}
+
 } // namespace
 
 void SetPlayerMovementAxisOverride(PlayerMovementAxisOverrideFn fn) {
@@ -396,10 +414,33 @@ void MovementSystem3D::Update(float dt) {
 
 void MovementSystem3D::Render(Renderer &renderer) { (void)renderer; }
 
+namespace {
+
+/** Point of `target` that a path toward it should reach (Transform-relative). */
+Vec2 PathAnchorOf(World &world, ecs::EntityId target, const Vec2 &fallback) {
+  if (const auto *ai = world.GetComponent<AIController>(target); ai && ai->followFlowField)
+    return ai->pathAnchor;
+  if (const auto *ctrl = world.GetComponent<Controller>(target);
+      ctrl && ctrl->tile_collision_w > 0.f && ctrl->tile_collision_h > 0.f)
+    return {ctrl->tile_collision_offset_x + ctrl->tile_collision_w * 0.5f,
+            ctrl->tile_collision_offset_y + ctrl->tile_collision_h * 0.5f};
+  return fallback;
+}
+
+} // namespace
+
 void AIMovementSystem::Update(float dt) {
   static thread_local std::vector<ecs::EntityId> ids;
   world.GetEntitiesWith<AIController>(ids);
 
+  Terrain2D *terrain = world.GetTerrain();
+  const bool canPath = terrain && !terrain->tmxMeta.collisionSolid.empty() &&
+                       terrain->GridStepX() > 0 && terrain->GridStepY() > 0;
+  const float gw = canPath ? static_cast<float>(terrain->GridStepX()) : 1.f;
+  const float gh = canPath ? static_cast<float>(terrain->GridStepY()) : 1.f;
+  auto tileX = [&](float x) { return static_cast<int>(std::floor((x - terrain->origin.x) / gw)); };
+  auto tileY = [&](float y) { return static_cast<int>(std::floor((y - terrain->origin.y) / gh)); };
+
   for (ecs::EntityId id : ids) {
     auto *ctrl = world.GetComponent<AIController>(id);
     auto *tr = world.GetComponent<Transform>(id);
@@ -408,18 +449,50 @@ void AIMovementSystem::Update(float dt) {
     if (!ctrl || !tr || !anim)
       continue;
 
-    if (ctrl->entityTarget <= 0 and ctrl->entityTarget != id) {
-      return;
-    }
-
     const float arriveRadius = 0.01f;
 
-    auto *targetTrasnform = world.GetComponent<Transform>(ctrl->entityTarget);
-    if (!targetTrasnform)
-      continue;
+    // A delivered Path2D wins; otherwise head for the target, or for the next flow-field
+    // cell while not yet in its cell.
+    float goalX = 0.f;
+    float goalY = 0.f;
+    bool viaWaypoint = false;
+    Path2D *path = world.GetComponent<Path2D>(id);
+    if (path && !path->Active())
+      path = nullptr;
+    const Transform *targetTrasnform = nullptr;
+    if (path) {
+      goalX = path->waypoints[path->next].x - ctrl->pathAnchor.x;
+      goalY = path->waypoints[path->next].y - ctrl->pathAnchor.y;
+      viaWaypoint = path->next + 1 < path->waypoints.size();
+    } else {
+      if (ctrl->entityTarget <= 0 and ctrl->entityTarget != id) {
+        return;
+      }
+      targetTrasnform = world.ReadComponent<Transform>(ctrl->entityTarget);
+      if (!targetTrasnform)
+        continue;
+      goalX = targetTrasnform->x;
+      goalY = targetTrasnform->y;
+    }
+    if (!path && ctrl->followFlowField && canPath) {
+      const Vec2 targetAnchor = PathAnchorOf(world, ctrl->entityTarget, ctrl->pathAnchor);
+      const int goalTx = tileX(targetTrasnform->x + targetAnchor.x);
+      const int goalTy = tileY(targetTrasnform->y + targetAnchor.y);
+      const int tx = tileX(tr->x + ctrl->pathAnchor.x);
+      const int ty = tileY(tr->y + ctrl->pathAnchor.y);
+      int nx = 0, ny = 0;
+      if (tx != goalTx || ty != goalTy) {
+        const FlowField2D *field = flowFields_.Acquire(terrain->tmxMeta, goalTx, goalTy);
+        if (field && field->NextStep(tx, ty, nx, ny)) {
+          goalX = terrain->origin.x + (static_cast<float>(nx) + 0.5f) * gw - ctrl->pathAnchor.x;
+          goalY = terrain->origin.y + (static_cast<float>(ny) + 0.5f) * gh - ctrl->pathAnchor.y;
+          viaWaypoint = true;
+        }
+      }
+    }
 
-    float dx = targetTrasnform->x - tr->x;
-    float dy = targetTrasnform->y - tr->y;
+    float dx = goalX - tr->x;
+    float dy = goalY - tr->y;
 
     float distSq = dx * dx + dy * dy;
 
@@ -433,8 +506,10 @@ void AIMovementSystem::Update(float dt) {
 
       // Prevent overshoot
       if (step >= dist) {
-        tr->x = targetTrasnform->x;
-        tr->y = targetTrasnform->y;
+        tr->x = goalX;
+        tr->y = goalY;
+        if (path)
+          ++path->next;
       } else {
         tr->x += dirX * step;
         tr->y += dirY * step;
@@ -447,11 +522,14 @@ void AIMovementSystem::Update(float dt) {
 
       anim->current = AnimState::WALKING;
     } else {
-      tr->x = targetTrasnform->x;
-      tr->y = targetTrasnform->y;
-      anim->current = AnimState::IDLE;
+      tr->x = goalX;
+      tr->y = goalY;
+      if (path)
+        ++path->next;
+      anim->current = viaWaypoint ? AnimState::WALKING : AnimState::IDLE;
     }
   }
+  flowFields_.Sweep();
 }
 
 void AIMovementSystem::Render(Renderer &renderer) {};
@@ -498,19 +576,15 @@ void RenderSystem::Update(float) {}
 
 void RenderSystem::Render(Renderer &renderer) {
   static thread_local std::vector<ecs::EntityId> ids;
-  world.GetEntitiesWith<AnimatedSprite>(ids);
-  std::sort(ids.begin(), ids.end(), [&](ecs::EntityId a, ecs::EntityId b) {
-    const int oa = EffectiveSpriteDrawOrder(world, a);
-    const int ob = EffectiveSpriteDrawOrder(world, b);
-    if (oa != ob)
-      return oa < ob;
-    return a < b;
-  });
+  CollectVisibleSprites<AnimatedSprite>(world, renderer, ids);
+  drawOrder_.Sort(ids, [this](ecs::EntityId id) { return EffectiveSpriteDrawOrder(world, id); });
+  RuntimeTextureAtlas &atlas = RuntimeTextureAtlas::instance();
+  renderer.BeginSpriteBatch();
   for (ecs::EntityId id : ids) {
     if (world.GetComponent<EditorHidden>(id))
       continue;
-    auto *animSprite = world.GetComponent<AnimatedSprite>(id);
-    auto *tr = world.GetComponent<Transform>(id);
+    const auto *animSprite = world.ReadComponent<AnimatedSprite>(id);
+    const auto *tr = world.ReadComponent<Transform>(id);
 
     if (!animSprite || !tr)
       continue;
@@ -521,9 +595,8 @@ void RenderSystem::Render(Renderer &renderer) {
     if (!animDef)
       continue;
 
-    // Load texture from asset manager
-    auto texture =
-        AssetManager::instance().load<TextureResource>(animDef->texturePath);
+    // Cached on the definition; no AssetManager lock / path hash per sprite.
+    TextureResource *texture = AnimationDatabase::resolveTexture(*animDef);
     if (!texture)
       continue;
 
@@ -536,9 +609,11 @@ void RenderSystem::Render(Renderer &renderer) {
     // Transform is top-left across gameplay/collision/camera code, so keep render anchored too.
     Vec2 origin = {0.f, 0.f};
 
-    renderer.DrawTexturePro(texture->texture, src, dest, origin, tr->rotation,
-                            Colors::White);
+    TextureHandle drawTex = texture->texture;
+    atlas.Remap(renderer, animDef->texture, drawTex, src);
+    renderer.SubmitSprite(drawTex, src, dest, origin, tr->rotation, Colors::White);
   }
+  renderer.EndSpriteBatch();
 }
 
 void AnimationSystem::OnWorldLoaded(World &world) {
@@ -714,19 +789,15 @@ void SpriteSystem::Update(float dt) {}
 
 void SpriteSystem::Render(Renderer &renderer) {
   static thread_local std::vector<ecs::EntityId> ids;
-  world.GetEntitiesWith<Sprite>(ids);
-  std::sort(ids.begin(), ids.end(), [&](ecs::EntityId a, ecs::EntityId b) {
-    const int oa = EffectiveSpriteDrawOrder(world, a);
-    const int ob = EffectiveSpriteDrawOrder(world, b);
-    if (oa != ob)
-      return oa < ob;
-    return a < b;
-  });
+  CollectVisibleSprites<Sprite>(world, renderer, ids);
+  drawOrder_.Sort(ids, [this](ecs::EntityId id) { return EffectiveSpriteDrawOrder(world, id); });
+  RuntimeTextureAtlas &atlas = RuntimeTextureAtlas::instance();
+  renderer.BeginSpriteBatch();
   for (ecs::EntityId id : ids) {
     if (world.GetComponent<EditorHidden>(id))
       continue;
-    auto *sprite = world.GetComponent<Sprite>(id);
-    auto *tr = world.GetComponent<Transform>(id);
+    const auto *sprite = world.ReadComponent<Sprite>(id);
+    const auto *tr = world.ReadComponent<Transform>(id);
 
     // Load texture from asset manager
     if (!sprite->atlas)
@@ -743,9 +814,11 @@ void SpriteSystem::Render(Renderer &renderer) {
     Rect dest = {tr->x, tr->y, w, h};
     Vec2 origin = {dest.width * 0.5f, dest.height * 0.5f};
 
-    renderer.DrawTexturePro(texture->texture, src, dest, origin, tr->rotation,
-                            Colors::White);
+    TextureHandle drawTex = texture->texture;
+    atlas.Remap(renderer, texture, drawTex, src);
+    renderer.SubmitSprite(drawTex, src, dest, origin, tr->rotation, Colors::White);
   }
+  renderer.EndSpriteBatch();
 }
 
 } // namespace criogenio
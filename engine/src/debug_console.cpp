@@ -2,7 +2,10 @@
 #include "engine.h"
 #include "graphics_types.h"
 #include "input.h"
+#include "profiler.h"
 #include "render.h"
+#include "texture_atlas.h"
+#include "world.h"
 #include <SDL3/SDL.h>
 #include <algorithm>
 #include <cctype>
@@ -166,9 +169,136 @@ void DebugConsole::registerBuiltins(Engine &engine) {
         static_cast<unsigned long long>(st.bytesSent),
         server->IsQuantizedTransformPayloadEnabled() ? "on" : "off");
     AddLogLine(b);
+    std::snprintf(b, sizeof b, "netstats: terrain deltas=%llu chunks=%llu bytes=%llu",
+                  static_cast<unsigned long long>(st.terrainDeltasSent),
+                  static_cast<unsigned long long>(st.terrainChunksSent),
+                  static_cast<unsigned long long>(st.terrainBytesSent));
+    AddLogLine(b);
     AddLogLine("Usage: netstats [reset]");
   });
 
+  RegisterCommand("netprof", [this](Engine &engine, const std::vector<std::string> &args) {
+    ReplicationServer *server = engine.GetReplicationServer();
+    if (!server) {
+      AddLogLine("netprof: server replication is not active.");
+      return;
+    }
+    if (args.size() > 2 && args[1] == "dump") {
+      if (server->WriteTickHistory(args[2]))
+        AddLogLine("netprof: wrote " + args[2]);
+      else
+        AddLogLine("netprof: could not write " + args[2]);
+      return;
+    }
+    const auto sum = server->SummarizeTickHistory();
+    char b[200];
+    std::snprintf(b, sizeof b, "netprof: %zu ticks (min / avg / p50 / p95 / p99 / max)",
+                  sum.samples);
+    AddLogLine(b);
+    auto line = [&](const char *name, const ReplicationServer::MetricSummary &m) {
+      std::snprintf(b, sizeof b, "  %-12s %.3f / %.3f / %.3f / %.3f / %.3f / %.3f", name, m.min,
+                    m.avg, m.p50, m.p95, m.p99, m.max);
+      AddLogLine(b);
+    };
+    line("build_ms", sum.buildMs);
+    line("encode_ms", sum.encodeMs);
+    line("bytes/client", sum.bytesPerClient);
+    line("entities/pkt", sum.entitiesPerPacket);
+    line("skip_ratio", sum.deltaSkipRatio);
+    AddLogLine("Usage: netprof [dump <file.csv|file.json>]  (netstats reset clears history)");
+  });
+
+  RegisterCommand("atlas", [this](Engine &engine, const std::vector<std::string> &args) {
+    RuntimeTextureAtlas &atlas = RuntimeTextureAtlas::instance();
+    bool on = false;
+    if (args.size() > 1 && args[1] == "clear") {
+      atlas.Clear();
+      AddLogLine("atlas: cleared (sources repack as they are drawn)");
+      return;
+    }
+    if (args.size() > 1 && parseOnOffArg(args[1], on))
+      atlas.SetEnabled(on);
+    const auto st = atlas.GetStats();
+    const auto batch = engine.GetRenderer().GetSpriteBatchStats();
+    char b[200];
+    std::snprintf(b, sizeof b,
+                  "atlas: %s  pages=%zu packed=%zu standalone=%zu occupancy=%.0f%%  "
+                  "batch quads=%u draws=%u",
+                  atlas.IsEnabled() ? "on" : "off", st.pages, st.packed, st.standalone,
+                  static_cast<double>(st.occupancy * 100.f), batch.quads, batch.drawCalls);
+    AddLogLine(b);
+    AddLogLine("Usage: atlas [on|off|clear]");
+  });
+
+  RegisterCommand("profile", [this](Engine &, const std::vector<std::string> &args) {
+    Profiler &prof = Profiler::instance();
+    bool on = false;
+    if (args.size() > 2 && args[1] == "dump") {
+      if (prof.WriteChromeTrace(args[2]))
+        AddLogLine("profile: wrote " + args[2] + " (open in chrome://tracing or Perfetto)");
+      else
+        AddLogLine("profile: could not write " + args[2]);
+      return;
+    }
+    if (args.size() > 1 && args[1] == "clear") {
+      prof.Clear();
+      AddLogLine("profile: buffers cleared");
+      return;
+    }
+    if (args.size() > 1 && args[1] == "overlay") {
+      if (args.size() > 2 && parseOnOffArg(args[2], on))
+        profilerOverlay_ = on;
+      else
+        profilerOverlay_ = !profilerOverlay_;
+    } else if (args.size() > 1 && parseOnOffArg(args[1], on)) {
+      prof.SetEnabled(on);
+    }
+    const uint32_t frame = prof.FrameIndex();
+    const size_t zones = frame > 0 ? prof.CollectMainThreadFrame(frame - 1).size() : 0;
+    char b[200];
+    std::snprintf(b, sizeof b, "profile: %s  overlay=%s  last frame %.2f ms, %zu zones%s",
+                  prof.IsEnabled() ? "on" : "off", profilerOverlay_ ? "on" : "off",
+                  static_cast<double>(prof.LastFrameNs()) / 1e6, zones,
+                  CRIOGENIO_PROFILER ? "" : "  (compiled out)");
+    AddLogLine(b);
+    AddLogLine("Usage: profile [on|off|clear|overlay [on|off]|dump <file.json>]");
+  });
+
+  RegisterCommand("perf", [this](Engine &engine, const std::vector<std::string> &args) {
+    if (args.size() < 2 || args[1] != "systems") {
+      AddLogLine("Usage: perf systems [reset]");
+      return;
+    }
+    World &world = engine.GetWorld();
+    if (args.size() > 2 && args[2] == "reset") {
+      world.ResetSystemTimings();
+      AddLogLine("perf: system timings reset");
+      return;
+    }
+    if (!CRIOGENIO_SYSTEM_TIMING) {
+      AddLogLine("perf: system timing compiled out (CRIOGENIO_SYSTEM_TIMING=0)");
+      return;
+    }
+    // Costliest first: by average update + render over the window.
+    std::vector<const SystemTiming *> rows;
+    for (const SystemTiming &t : world.GetSystemTimings())
+      rows.push_back(&t);
+    std::stable_sort(rows.begin(), rows.end(), [](const SystemTiming *a, const SystemTiming *b) {
+      return a->update.AvgMs() + a->render.AvgMs() > b->update.AvgMs() + b->render.AvgMs();
+    });
+    char b[200];
+    std::snprintf(b, sizeof b, "perf: %zu systems, last %zu frames (ms avg / max / p99)",
+                  rows.size(), TimingWindow::kWindow);
+    AddLogLine(b);
+    for (const SystemTiming *t : rows) {
+      std::snprintf(b, sizeof b,
+                    "  %-20s upd %.3f / %.3f / %.3f   rnd %.3f / %.3f / %.3f", t->name.c_str(),
+                    t->update.AvgMs(), t->update.MaxMs(), t->update.PercentileMs(99.0),
+                    t->render.AvgMs(), t->render.MaxMs(), t->render.PercentileMs(99.0));
+      AddLogLine(b);
+    }
+  });
+
   (void)engine;
 }
 
@@ -249,8 +379,62 @@ bool DebugConsole::HandleEvent(Engine &engine, const void *sdlEvent,
   }
 }
 
+void DebugConsole::drawProfilerOverlay(Renderer &renderer, int viewportW, int viewportH) {
+  const Profiler &prof = Profiler::instance();
+  const uint32_t frame = prof.FrameIndex();
+  if (frame == 0)
+    return;
+  const std::vector<ProfileZoneEvent> zones = prof.CollectMainThreadFrame(frame - 1);
+  const uint64_t frameNs = prof.LastFrameNs();
+  const uint64_t originNs = prof.FrameStartNs() - frameNs;
+
+  constexpr int kMaxRows = 8;
+  constexpr float kRowH = 14.f;
+  constexpr float kCharW = 8.f; // SDL debug text glyph width
+  const float panelH = 22.f + kRowH * kMaxRows;
+  const float panelTop = static_cast<float>(viewportH) - panelH;
+  const float left = 6.f;
+  const float width = static_cast<float>(viewportW) - left * 2.f;
+  // Fixed 60 Hz scale unless the frame was longer, so bars do not jump every frame.
+  const double spanNs = std::max<double>(static_cast<double>(frameNs), 1e9 / 60.0);
+  renderer.DrawRectScreen(0.f, panelTop, static_cast<float>(viewportW), panelH, {20, 20, 24, 200});
+  const float budgetX = left + static_cast<float>(width * (1e9 / 60.0) / spanNs);
+  renderer.DrawRectScreen(budgetX, panelTop, 1.f, panelH, {255, 80, 80, 200});
+
+  char b[96];
+  std::snprintf(b, sizeof b, "frame %.2f ms  zones %zu", static_cast<double>(frameNs) / 1e6,
+                zones.size());
+  renderer.DrawDebugText(left, panelTop + 4.f, b);
+
+  for (const ProfileZoneEvent &z : zones) {
+    if (z.depth >= static_cast<uint32_t>(kMaxRows) || z.startNs < originNs)
+      continue;
+    const float x0 = left + static_cast<float>(width * (z.startNs - originNs) / spanNs);
+    const float w = std::max(1.f, static_cast<float>(width * (z.endNs - z.startNs) / spanNs));
+    const float y = panelTop + 18.f + kRowH * static_cast<float>(z.depth);
+    unsigned h = 2166136261u;
+    for (const char *c = z.name; c && *c; ++c)
+      h = (h ^ static_cast<unsigned char>(*c)) * 16777619u;
+    const Color col{static_cast<unsigned char>(90 + (h & 0x7F)),
+                    static_cast<unsigned char>(90 + ((h >> 8) & 0x7F)),
+                    static_cast<unsigned char>(90 + ((h >> 16) & 0x7F)), 230};
+    renderer.DrawRectScreen(x0, y, w, kRowH - 2.f, col);
+    const size_t fit = static_cast<size_t>((w - 4.f) / kCharW);
+    if (fit >= 3 && z.name) {
+      std::snprintf(b, sizeof b, "%.*s %.2f", static_cast<int>(std::min<size_t>(fit, 40)),
+                    z.name, static_cast<double>(z.endNs - z.startNs) / 1e6);
+      b[std::min(fit, sizeof b - 1)] = '\0';
+      renderer.DrawDebugText(x0 + 2.f, y + 3.f, b);
+    }
+  }
+}
+
 void DebugConsole::Draw(Renderer &renderer, int viewportW, int viewportH) {
-  if (!open_ || viewportW <= 0 || viewportH <= 0)
+  if (viewportW <= 0 || viewportH <= 0)
+    return;
+  if (profilerOverlay_)
+    drawProfilerOverlay(renderer, viewportW, viewportH);
+  if (!open_)
     return;
 
   const int panelH = 200;
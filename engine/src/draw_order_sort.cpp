@@ -0,0 +1,92 @@
+#include "draw_order_sort.h"
+#include <algorithm>
+#include <cstring>
+
+namespace criogenio {
+
+namespace {
+
+/** Below this many entries a plain insertion sort beats the radix passes. */
+constexpr size_t kRadixMinEntries = 64;
+
+} // namespace
+
+bool DrawOrderSorter::BeginFrame(const std::vector<ecs::EntityId> &ids) {
+  const size_t n = ids.size();
+  entries_.resize(n);
+  const bool coherent = n > 0 && prevPerm_.size() == n && prevInput_.size() == n &&
+                        std::memcmp(prevInput_.data(), ids.data(), n * sizeof(ecs::EntityId)) == 0;
+  for (size_t i = 0; i < n; ++i)
+    entries_[i].index = coherent ? prevPerm_[i] : static_cast<uint32_t>(i);
+  prevInput_.assign(ids.begin(), ids.end());
+  return coherent;
+}
+
+void DrawOrderSorter::FinishFrame(std::vector<ecs::EntityId> &ids, bool coherent) {
+  const size_t n = entries_.size();
+  if (n < kRadixMinEntries) {
+    InsertionSort(static_cast<size_t>(-1));
+    ++stats_.insertionSorts;
+  } else if (coherent && InsertionSort(n / 4)) {
+    ++stats_.insertionSorts;
+  } else {
+    RadixSort();
+    ++stats_.radixSorts;
+  }
+  prevPerm_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    prevPerm_[i] = entries_[i].index;
+    ids[i] = prevInput_[entries_[i].index];
+  }
+}
+
+bool DrawOrderSorter::InsertionSort(size_t maxMoves) {
+  size_t moves = 0;
+  for (size_t i = 1; i < entries_.size(); ++i) {
+    const Entry e = entries_[i];
+    size_t j = i;
+    while (j > 0 && entries_[j - 1].key > e.key) {
+      entries_[j] = entries_[j - 1];
+      --j;
+      if (++moves > maxMoves) {
+        entries_[j] = e;
+        return false;
+      }
+    }
+    entries_[j] = e;
+  }
+  return true;
+}
+
+void DrawOrderSorter::RadixSort() {
+  const size_t n = entries_.size();
+  scratch_.resize(n);
+  // All eight byte histograms in one pass; bytes shared by every key (e.g. the high bytes of
+  // small entity ids, or a single draw-order bucket) are skipped entirely.
+  static thread_local uint32_t counts[8][256];
+  std::memset(counts, 0, sizeof counts);
+  for (const Entry &e : entries_) {
+    for (int b = 0; b < 8; ++b)
+      ++counts[b][(e.key >> (b * 8)) & 0xFFu];
+  }
+  Entry *src = entries_.data();
+  Entry *dst = scratch_.data();
+  for (int b = 0; b < 8; ++b) {
+    uint32_t *c = counts[b];
+    if (c[(src[0].key >> (b * 8)) & 0xFFu] == n)
+      continue;
+    uint32_t offset = 0;
+    for (int d = 0; d < 256; ++d) {
+      const uint32_t cnt = c[d];
+      c[d] = offset;
+      offset += cnt;
+    }
+    for (size_t i = 0; i < n; ++i)
+      dst[c[(src[i].key >> (b * 8)) & 0xFFu]++] = src[i];
+    std::swap(src, dst);
+  }
+  if (src != entries_.data())
+    std::copy(src, src + n, entries_.data());
+}
+
+} // namespace criogenio
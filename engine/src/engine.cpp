@@ -4,11 +4,13 @@
 #include "gameplay_tags.h"
 #include "map_authoring_components.h"
 #include "object_layer.h"
+#include "profiler.h"
 #include "inventory.h"
 #include "input.h"
 #include "network/net_messages.h"
 #include "network/replication_client.h"
 #include "resources.h"
+#include "texture_atlas.h"
 #include "world.h"
 #include <chrono>
 #include <cstdio>
@@ -52,6 +54,7 @@ Engine::~Engine() {
     delete world;
     world = nullptr;
   }
+  criogenio::RuntimeTextureAtlas::instance().Clear();
   criogenio::AssetManager::instance().clear();
   if (renderer) {
     delete renderer;
@@ -155,22 +158,35 @@ void Engine::Run() {
     return OnPollEvent(ev);
   };
   while (!renderer->WindowShouldClose()) {
-    renderer->ProcessEvents(&eventHook);
+    CRIO_PROFILE_FRAME();
+    {
+      CRIO_PROFILE_ZONE("Engine::ProcessEvents");
+      renderer->ProcessEvents(&eventHook);
+    }
     float now = GetTimeSeconds();
     float dt = now - previousTime;
     previousTime = now;
 
-    OnFrame(dt);
+    {
+      CRIO_PROFILE_ZONE("Engine::OnFrame");
+      OnFrame(dt);
+    }
 
     // Apply snapshots before world update so client-side systems (e.g. camera) see current transforms.
     if (networkMode == NetworkMode::Client && transport && replicationClient) {
+      CRIO_PROFILE_ZONE("Net::ClientApply");
       transport->Update();
       auto msgs = transport->PollMessages();
       for (const auto& msg : msgs) {
-        if (msg.data.size() >= 1u &&
-            static_cast<MsgType>(msg.data[0]) == MsgType::Snapshot) {
+        if (msg.data.empty())
+          continue;
+        const MsgType type = static_cast<MsgType>(msg.data[0]);
+        if (type == MsgType::Snapshot) {
           Snapshot snap = ParseSnapshotFromWire(msg.data.data(), msg.data.size());
           replicationClient->ApplySnapshot(snap);
+        } else if (type == MsgType::TerrainDelta) {
+          replicationClient->ApplyTerrainDelta(
+              ParseTerrainDeltaFromWire(msg.data.data(), msg.data.size()));
         }
       }
     }
@@ -178,19 +194,33 @@ void Engine::Run() {
     world->Update(dt);
 
     if (networkMode == NetworkMode::Server && transport && replicationServer) {
+      CRIO_PROFILE_ZONE("Net::ServerUpdate");
       transport->Update();
       replicationServer->Update();
     } else if (networkMode == NetworkMode::Client && transport &&
                replicationClient) {
+      CRIO_PROFILE_ZONE("Net::ClientInterpolate");
       replicationClient->UpdateInterpolation(dt);
     }
     renderer->BeginFrame();
     world->Render(*renderer);
-    OnAfterWorldRender(*renderer);
-    debugConsole_.Draw(*renderer, renderer->GetViewportWidth(),
-                        renderer->GetViewportHeight());
-    OnGUI();
-    renderer->EndFrame();
+    {
+      CRIO_PROFILE_ZONE("Engine::OnAfterWorldRender");
+      OnAfterWorldRender(*renderer);
+    }
+    {
+      CRIO_PROFILE_ZONE("DebugConsole::Draw");
+      debugConsole_.Draw(*renderer, renderer->GetViewportWidth(),
+                          renderer->GetViewportHeight());
+    }
+    {
+      CRIO_PROFILE_ZONE("Engine::OnGUI");
+      OnGUI();
+    }
+    {
+      CRIO_PROFILE_ZONE("Renderer::EndFrame");
+      renderer->EndFrame();
+    }
     Input::EndFrame();
   }
 }
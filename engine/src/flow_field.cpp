@@ -0,0 +1,161 @@
+#include "flow_field.h"
+#include <algorithm>
+
+namespace criogenio {
+
+namespace {
+
+// Orthogonal neighbours first; kOpposite[d] is the step back along d.
+constexpr int kDx[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+constexpr int kDy[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+constexpr int8_t kOpposite[8] = {1, 0, 3, 2, 7, 6, 5, 4};
+constexpr uint32_t kOrthogonalCost = 10;
+constexpr uint32_t kDiagonalCost = 14;
+
+} // namespace
+
+bool FlowField2D::CellIndex(int worldTx, int worldTy, size_t &out) const {
+  const int lx = worldTx - minTx_;
+  const int ly = worldTy - minTy_;
+  if (lx < 0 || ly < 0 || lx >= width_ || ly >= height_)
+    return false;
+  out = static_cast<size_t>(ly) * static_cast<size_t>(width_) + static_cast<size_t>(lx);
+  return true;
+}
+
+bool FlowField2D::Build(const TmxMapMetadata &meta, int goalTx, int goalTy) {
+  valid_ = false;
+  reached_ = 0;
+  goalTx_ = goalTx;
+  goalTy_ = goalTy;
+  minTx_ = meta.boundsMinTx;
+  minTy_ = meta.boundsMinTy;
+  width_ = meta.collisionStrideTiles;
+  height_ = meta.collisionHeightTiles;
+  const size_t cells = static_cast<size_t>(std::max(0, width_)) * std::max(0, height_);
+  size_t goal = 0;
+  if (cells == 0 || meta.collisionSolid.size() < cells || !CellIndex(goalTx, goalTy, goal))
+    return false;
+
+  cost_.assign(cells, kUnreachable);
+  step_.assign(cells, -1);
+  const uint8_t *solid = meta.collisionSolid.data();
+  auto isSolid = [&](int lx, int ly) { return solid[ly * width_ + lx] != 0; };
+
+  // Dial's algorithm: edge costs are small integers, so a ring of kBuckets cost buckets
+  // replaces the heap and the whole build stays linear in the cell count.
+  for (std::vector<uint32_t> &b : buckets_)
+    b.clear();
+  cost_[goal] = 0;
+  buckets_[0].push_back(static_cast<uint32_t>(goal));
+  size_t pending = 1;
+  for (uint32_t c = 0; pending > 0; ++c) {
+    std::vector<uint32_t> &bucket = buckets_[c % kBuckets];
+    while (!bucket.empty()) {
+      const uint32_t idx = bucket.back();
+      bucket.pop_back();
+      --pending;
+      if (c != cost_[idx])
+        continue; // stale entry
+      ++reached_;
+      const int lx = static_cast<int>(idx % static_cast<uint32_t>(width_));
+      const int ly = static_cast<int>(idx / static_cast<uint32_t>(width_));
+      for (int d = 0; d < 8; ++d) {
+        const int nx = lx + kDx[d];
+        const int ny = ly + kDy[d];
+        if (nx < 0 || ny < 0 || nx >= width_ || ny >= height_ || isSolid(nx, ny))
+          continue;
+        if (d >= 4 && (isSolid(nx, ly) || isSolid(lx, ny)))
+          continue; // no squeezing diagonally between two walls
+        const uint32_t nc = c + (d < 4 ? kOrthogonalCost : kDiagonalCost);
+        const size_t nidx = static_cast<size_t>(ny) * width_ + nx;
+        if (nc >= cost_[nidx])
+          continue;
+        cost_[nidx] = nc;
+        step_[nidx] = kOpposite[d];
+        buckets_[nc % kBuckets].push_back(static_cast<uint32_t>(nidx));
+        ++pending;
+      }
+    }
+  }
+  valid_ = true;
+  return true;
+}
+
+uint32_t FlowField2D::Cost(int worldTx, int worldTy) const {
+  size_t idx = 0;
+  if (!valid_ || !CellIndex(worldTx, worldTy, idx))
+    return kUnreachable;
+  return cost_[idx];
+}
+
+bool FlowField2D::NextStep(int worldTx, int worldTy, int &outTx, int &outTy) const {
+  size_t idx = 0;
+  if (!valid_ || !CellIndex(worldTx, worldTy, idx) || cost_[idx] == 0)
+    return false;
+  int dir = step_[idx];
+  if (dir < 0) {
+    uint32_t best = kUnreachable;
+    for (int d = 0; d < 8; ++d) {
+      const uint32_t c = Cost(worldTx + kDx[d], worldTy + kDy[d]);
+      if (c < best) {
+        best = c;
+        dir = d;
+      }
+    }
+    if (dir < 0)
+      return false;
+  }
+  outTx = worldTx + kDx[dir];
+  outTy = worldTy + kDy[dir];
+  return true;
+}
+
+const FlowField2D *FlowFieldCache::Acquire(const TmxMapMetadata &meta, int goalTx, int goalTy) {
+  if (meta.collisionSolid.empty())
+    return nullptr;
+  if (meta.collisionSolid.data() != maskData_ || meta.collisionSolid.size() != maskSize_ ||
+      meta.collisionRevision != maskRevision_) {
+    Clear();
+    maskData_ = meta.collisionSolid.data();
+    maskSize_ = meta.collisionSolid.size();
+    maskRevision_ = meta.collisionRevision;
+  }
+  for (Entry &e : entries_) {
+    if (e.goalTx == goalTx && e.goalTy == goalTy) {
+      e.lastUse = frame_;
+      return e.ok ? &e.field : nullptr;
+    }
+  }
+
+  // Miss: recycle a field idle for a whole frame, grow, or evict the least recently used.
+  Entry *slot = nullptr;
+  for (Entry &e : entries_) {
+    if (e.lastUse + 1 < frame_) {
+      slot = &e;
+      break;
+    }
+  }
+  if (!slot && entries_.size() < kMaxFields)
+    slot = &entries_.emplace_back();
+  if (!slot)
+    slot = &*std::min_element(entries_.begin(), entries_.end(),
+                              [](const Entry &a, const Entry &b) { return a.lastUse < b.lastUse; });
+  slot->goalTx = goalTx;
+  slot->goalTy = goalTy;
+  slot->lastUse = frame_;
+  slot->ok = slot->field.Build(meta, goalTx, goalTy);
+  ++builds_;
+  return slot->ok ? &slot->field : nullptr;
+}
+
+void FlowFieldCache::Sweep() { ++frame_; }
+
+void FlowFieldCache::Clear() {
+  entries_.clear();
+  maskData_ = nullptr;
+  maskSize_ = 0;
+  maskRevision_ = 0;
+}
+
+} // namespace criogenio
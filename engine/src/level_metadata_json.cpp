@@ -655,6 +655,7 @@ void TerrainImportLevelMetadata(Terrain2D &terrain, const SerializedLevelMetadat
   m.collisionStrideTiles = lm.collisionStrideTiles;
   m.collisionHeightTiles = lm.collisionHeightTiles;
   m.collisionSolid = lm.collisionSolid;
+  m.collisionRevision = terrain.tmxMeta.collisionRevision + 1;
 
   terrain.tmxMeta = std::move(m);
   terrain.gidMode_ = lm.gidMode;
@@ -689,6 +690,7 @@ void TerrainImportLevelMetadata(Terrain2D &terrain, const SerializedLevelMetadat
   }
   if (terrain.gidMode_ && !terrain.tmxTilesets.empty())
     terrain.tileset = terrain.tmxTilesets[0].sheet;
+  terrain.RebuildTmxGidLookup();
 }
 
 } // namespace criogenio
@@ -38,6 +38,11 @@ Snapshot ParseSnapshotFromWire(const uint8_t *data, size_t size) {
 
 ReplicationClient::ReplicationClient(World &world) : world(world) {}
 
+void ReplicationClient::ApplyTerrainDelta(const TerrainDelta &delta) {
+  if (Terrain2D *terrain = world.GetTerrain())
+    criogenio::ApplyTerrainDelta(*terrain, delta);
+}
+
 void ReplicationClient::ApplySnapshot(const Snapshot &snap) {
   for (const auto &sent : snap.entities) {
     ecs::EntityId eid;
@@ -5,8 +5,12 @@
 #include "network/replication_client.h"
 #include "network/net_messages.h"
 #include "network/serialization.h"
+#include "network/terrain_delta.h"
 #include "world.h"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <limits>
 
@@ -42,6 +46,33 @@ int16_t QuantizeValue(float v, float scale) {
   return static_cast<int16_t>(std::round(v * scale));
 }
 
+using TickClock = std::chrono::steady_clock;
+
+float ElapsedMs(TickClock::time_point from, TickClock::time_point to) {
+  return std::chrono::duration<float, std::milli>(to - from).count();
+}
+
+ReplicationServer::MetricSummary Summarize(std::vector<float> &values) {
+  ReplicationServer::MetricSummary m;
+  if (values.empty())
+    return m;
+  std::sort(values.begin(), values.end());
+  auto at = [&values](float q) {
+    const size_t idx = static_cast<size_t>(q * static_cast<float>(values.size() - 1) + 0.5f);
+    return values[std::min(idx, values.size() - 1)];
+  };
+  double sum = 0.0;
+  for (float v : values)
+    sum += v;
+  m.min = values.front();
+  m.max = values.back();
+  m.avg = static_cast<float>(sum / static_cast<double>(values.size()));
+  m.p50 = at(0.50f);
+  m.p95 = at(0.95f);
+  m.p99 = at(0.99f);
+  return m;
+}
+
 }  // namespace
 
 ReplicationServer::ReplicationServer(World &world, INetworkTransport &net)
@@ -120,6 +151,12 @@ void ReplicationServer::Update() {
     world.AddComponent<ReplicatedNetId>(entityId, ReplicatedNetId(netId));
     entityToNetId[entityId] = netId;
     connectionToEntity[conn] = entityId;
+    // Late joiner: owe it every chunk edited at runtime before it connected.
+    if (trackedTerrain_ && trackedTerrain_ == world.GetTerrain() &&
+        !trackedTerrain_->EditedChunks().empty()) {
+      const auto &edited = trackedTerrain_->EditedChunks();
+      terrainStreamQueue_[conn].assign(edited.begin(), edited.end());
+    }
   }
 
   auto msgs = net.PollMessages();
@@ -134,6 +171,70 @@ void ReplicationServer::Update() {
     }
   }
   BuildAndSendSnapshot();
+  ReplicateTerrain();
+}
+
+void ReplicationServer::SendTerrainDelta(ConnectionId conn, const std::vector<uint8_t> &data,
+                                         size_t chunkCount) {
+  net.Send(conn, data.data(), data.size(), true);
+  stats_.terrainDeltasSent++;
+  stats_.terrainChunksSent += chunkCount;
+  stats_.terrainBytesSent += data.size();
+  stats_.bytesSent += data.size();
+}
+
+void ReplicationServer::ReplicateTerrain() {
+  Terrain2D *terrain = world.GetTerrain();
+  if (terrain != trackedTerrain_) {
+    // New map (or none): the previous edit history no longer describes anything clients hold.
+    trackedTerrain_ = terrain;
+    terrainStreamQueue_.clear();
+    if (terrain)
+      terrain->SetChunkChangeTracking(true);
+  }
+  if (!terrain)
+    return;
+
+  const std::vector<ConnectionId> conns = net.GetConnectionIds();
+  const uint16_t chunkSize = static_cast<uint16_t>(terrain->GetChunkSize());
+
+  static thread_local std::vector<TerrainChunkRef> dirty;
+  if (terrain->ConsumeDirtyChunks(dirty) && !conns.empty()) {
+    TerrainDelta delta;
+    delta.tick = serverTick;
+    delta.chunkSize = chunkSize;
+    delta.chunks.reserve(dirty.size());
+    for (const TerrainChunkRef &ref : dirty)
+      AppendTerrainDeltaChunk(delta, *terrain, ref);
+    if (!delta.chunks.empty()) {
+      NetWriter buf;
+      WriteTerrainDelta(buf, delta);
+      for (ConnectionId conn : conns)
+        SendTerrainDelta(conn, buf.Data(), delta.chunks.size());
+    }
+  }
+
+  for (auto it = terrainStreamQueue_.begin(); it != terrainStreamQueue_.end();) {
+    const bool connected = std::find(conns.begin(), conns.end(), it->first) != conns.end();
+    if (!connected || it->second.empty()) {
+      it = terrainStreamQueue_.erase(it);
+      continue;
+    }
+    TerrainDelta delta;
+    delta.tick = serverTick;
+    delta.chunkSize = chunkSize;
+    auto &queue = it->second;
+    while (!queue.empty() && delta.chunks.size() < kTerrainStreamChunksPerTick) {
+      AppendTerrainDeltaChunk(delta, *terrain, queue.front());
+      queue.pop_front();
+    }
+    if (!delta.chunks.empty()) {
+      NetWriter buf;
+      WriteTerrainDelta(buf, delta);
+      SendTerrainDelta(it->first, buf.Data(), delta.chunks.size());
+    }
+    ++it;
+  }
 }
 
 void ReplicationServer::HandleInput(ConnectionId conn, const PlayerInput &input) {
@@ -159,6 +260,9 @@ void ReplicationServer::SetServerPlayerInput(const PlayerInput &input) {
 }
 
 void ReplicationServer::BuildAndSendSnapshot() {
+  const TickClock::time_point buildStart = TickClock::now();
+  const uint64_t consideredBefore = stats_.entitiesConsidered;
+  const uint64_t skippedBefore = stats_.entitiesDeltaSkipped;
   const bool forceFull = (fullSnapshotIntervalTicks > 0) &&
                          ((serverTick % fullSnapshotIntervalTicks) == 0);
   Snapshot snap;
@@ -237,18 +341,105 @@ void ReplicationServer::BuildAndSendSnapshot() {
   const size_t approxEntityBytes =
       snap.entities.size() *
       (sizeof(NetEntityId) + sizeof(uint32_t) * 2 + sizeof(uint8_t) + sizeof(float) * 5);
+  TickSample sample;
+  sample.tick = snap.tick;
+  sample.entitiesInPacket = static_cast<uint32_t>(snap.entities.size());
+  sample.entitiesConsidered = static_cast<uint32_t>(stats_.entitiesConsidered - consideredBefore);
+  sample.entitiesDeltaSkipped = static_cast<uint32_t>(stats_.entitiesDeltaSkipped - skippedBefore);
+  const TickClock::time_point buildEnd = TickClock::now();
+  sample.buildMs = ElapsedMs(buildStart, buildEnd);
   if (!forceFull && snap.entities.empty()) {
     stats_.snapshotsSkippedNoop++;
+    RecordTickSample(sample);
     return;
   }
   NetWriter buf(sizeof(uint8_t) + sizeof(uint32_t) * 2 + approxEntityBytes);
   WriteSnapshot(buf, snap);
   const std::vector<uint8_t> &data = buf.Data();
+  sample.encodeMs = ElapsedMs(buildEnd, TickClock::now());
+  sample.bytesPerClient = static_cast<uint32_t>(data.size());
   for (ConnectionId conn : net.GetConnectionIds()) {
     net.Send(conn, data.data(), data.size(), true);
     stats_.snapshotsSent++;
     stats_.bytesSent += data.size();
+    sample.clients++;
+  }
+  RecordTickSample(sample);
+}
+
+void ReplicationServer::RecordTickSample(const TickSample &sample) {
+  if (tickHistory_.size() < kTickHistoryCapacity) {
+    tickHistory_.push_back(sample);
+    return;
+  }
+  tickHistory_[tickHistoryHead_] = sample;
+  tickHistoryHead_ = (tickHistoryHead_ + 1) % kTickHistoryCapacity;
+}
+
+void ReplicationServer::GetTickHistory(std::vector<TickSample> &out) const {
+  out.clear();
+  out.reserve(tickHistory_.size());
+  // Until the ring wraps the head stays 0, so this is a plain copy.
+  out.insert(out.end(), tickHistory_.begin() + static_cast<std::ptrdiff_t>(tickHistoryHead_),
+             tickHistory_.end());
+  out.insert(out.end(), tickHistory_.begin(),
+             tickHistory_.begin() + static_cast<std::ptrdiff_t>(tickHistoryHead_));
+}
+
+ReplicationServer::TickMetricsSummary ReplicationServer::SummarizeTickHistory() const {
+  TickMetricsSummary out;
+  out.samples = tickHistory_.size();
+  if (tickHistory_.empty())
+    return out;
+  std::vector<float> values;
+  values.reserve(tickHistory_.size());
+  auto summarize = [&](auto field) {
+    values.clear();
+    for (const TickSample &s : tickHistory_)
+      values.push_back(field(s));
+    return Summarize(values);
+  };
+  out.buildMs = summarize([](const TickSample &s) { return s.buildMs; });
+  out.encodeMs = summarize([](const TickSample &s) { return s.encodeMs; });
+  out.bytesPerClient =
+      summarize([](const TickSample &s) { return static_cast<float>(s.bytesPerClient); });
+  out.entitiesPerPacket =
+      summarize([](const TickSample &s) { return static_cast<float>(s.entitiesInPacket); });
+  out.deltaSkipRatio = summarize([](const TickSample &s) { return s.DeltaSkipRatio(); });
+  return out;
+}
+
+bool ReplicationServer::WriteTickHistory(const std::string &path) const {
+  std::FILE *f = std::fopen(path.c_str(), "w");
+  if (!f)
+    return false;
+  std::vector<TickSample> samples;
+  GetTickHistory(samples);
+  const bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+  if (json) {
+    std::fputs("{\"samples\":[\n", f);
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const TickSample &s = samples[i];
+      std::fprintf(f,
+                   "  {\"tick\":%u,\"build_ms\":%.4f,\"encode_ms\":%.4f,\"bytes_per_client\":%u,"
+                   "\"entities_in_packet\":%u,\"entities_considered\":%u,"
+                   "\"entities_delta_skipped\":%u,\"delta_skip_ratio\":%.4f,\"clients\":%u}%s\n",
+                   s.tick, s.buildMs, s.encodeMs, s.bytesPerClient, s.entitiesInPacket,
+                   s.entitiesConsidered, s.entitiesDeltaSkipped, s.DeltaSkipRatio(), s.clients,
+                   i + 1 < samples.size() ? "," : "");
+    }
+    std::fputs("]}\n", f);
+  } else {
+    std::fputs("tick,build_ms,encode_ms,bytes_per_client,entities_in_packet,entities_considered,"
+               "entities_delta_skipped,delta_skip_ratio,clients\n",
+               f);
+    for (const TickSample &s : samples) {
+      std::fprintf(f, "%u,%.4f,%.4f,%u,%u,%u,%u,%.4f,%u\n", s.tick, s.buildMs, s.encodeMs,
+                   s.bytesPerClient, s.entitiesInPacket, s.entitiesConsidered,
+                   s.entitiesDeltaSkipped, s.DeltaSkipRatio(), s.clients);
+    }
   }
+  return std::fclose(f) == 0;
 }
 
 }  // namespace criogenio
@@ -0,0 +1,125 @@
+#include "network/terrain_delta.h"
+#include "network/net_messages.h"
+#include <limits>
+#include <stdexcept>
+
+namespace criogenio {
+
+namespace {
+
+void WriteRleCells(NetWriter &w, const std::vector<int> &cells) {
+  constexpr size_t kMaxRun = std::numeric_limits<uint16_t>::max();
+  // Count runs first so the header can precede the payload without backpatching.
+  uint32_t runCount = 0;
+  for (size_t i = 0; i < cells.size();) {
+    size_t j = i + 1;
+    while (j < cells.size() && cells[j] == cells[i] && j - i < kMaxRun)
+      ++j;
+    ++runCount;
+    i = j;
+  }
+  w.Write(runCount);
+  for (size_t i = 0; i < cells.size();) {
+    size_t j = i + 1;
+    while (j < cells.size() && cells[j] == cells[i] && j - i < kMaxRun)
+      ++j;
+    w.Write(static_cast<uint16_t>(j - i));
+    w.Write(static_cast<int32_t>(cells[i]));
+    i = j;
+  }
+}
+
+bool ReadRleCells(NetReader &r, size_t expectedCells, std::vector<int> &out) {
+  const uint32_t runCount = r.Read<uint32_t>();
+  out.clear();
+  out.reserve(expectedCells);
+  for (uint32_t i = 0; i < runCount; ++i) {
+    const uint16_t len = r.Read<uint16_t>();
+    const int32_t value = r.Read<int32_t>();
+    if (len == 0 || out.size() + len > expectedCells)
+      return false;
+    out.insert(out.end(), len, static_cast<int>(value));
+  }
+  return out.size() == expectedCells;
+}
+
+} // namespace
+
+bool AppendTerrainDeltaChunk(TerrainDelta &delta, const Terrain2D &terrain,
+                             const TerrainChunkRef &ref) {
+  if (ref.layer < 0 || ref.layer >= static_cast<int>(terrain.layers.size()) ||
+      ref.layer > std::numeric_limits<uint16_t>::max())
+    return false;
+  TerrainDeltaChunk c;
+  c.layer = static_cast<uint16_t>(ref.layer);
+  c.chunkX = ref.chunk.first;
+  c.chunkY = ref.chunk.second;
+  const std::vector<int> *tiles = terrain.FindChunkTiles(ref.layer, ref.chunk);
+  const size_t expected =
+      static_cast<size_t>(terrain.GetChunkSize()) * static_cast<size_t>(terrain.GetChunkSize());
+  if (!tiles || tiles->size() != expected)
+    c.removed = true;
+  else
+    c.tiles = *tiles;
+  delta.chunks.push_back(std::move(c));
+  return true;
+}
+
+void WriteTerrainDelta(NetWriter &w, const TerrainDelta &delta) {
+  w.Write(static_cast<uint8_t>(MsgType::TerrainDelta));
+  w.Write(delta.tick);
+  w.Write(delta.chunkSize);
+  w.Write(static_cast<uint32_t>(delta.chunks.size()));
+  for (const auto &c : delta.chunks) {
+    w.Write(c.layer);
+    w.Write(c.chunkX);
+    w.Write(c.chunkY);
+    w.Write(static_cast<uint8_t>(c.removed ? TERRAIN_CHUNK_REMOVED : 0u));
+    if (!c.removed)
+      WriteRleCells(w, c.tiles);
+  }
+}
+
+TerrainDelta ParseTerrainDeltaFromWire(const uint8_t *data, size_t size) {
+  if (size < 1u + sizeof(uint32_t) * 2u + sizeof(uint16_t))
+    return {};
+  NetReader r(data, size);
+  try {
+    if (r.Read<uint8_t>() != static_cast<uint8_t>(MsgType::TerrainDelta))
+      return {};
+    TerrainDelta delta;
+    delta.tick = r.Read<uint32_t>();
+    delta.chunkSize = r.Read<uint16_t>();
+    const uint32_t numChunks = r.Read<uint32_t>();
+    const size_t cells = static_cast<size_t>(delta.chunkSize) * delta.chunkSize;
+    for (uint32_t i = 0; i < numChunks; ++i) {
+      TerrainDeltaChunk c;
+      c.layer = r.Read<uint16_t>();
+      c.chunkX = r.Read<int32_t>();
+      c.chunkY = r.Read<int32_t>();
+      c.removed = (r.Read<uint8_t>() & TERRAIN_CHUNK_REMOVED) != 0;
+      if (!c.removed && !ReadRleCells(r, cells, c.tiles))
+        return {};
+      delta.chunks.push_back(std::move(c));
+    }
+    return delta;
+  } catch (const std::runtime_error &) {
+    return {};
+  }
+}
+
+size_t ApplyTerrainDelta(Terrain2D &terrain, const TerrainDelta &delta) {
+  if (delta.chunkSize == 0 || static_cast<int>(delta.chunkSize) != terrain.GetChunkSize())
+    return 0;
+  size_t applied = 0;
+  for (const auto &c : delta.chunks) {
+    if (c.layer >= terrain.layers.size())
+      continue;
+    terrain.ApplyChunkTiles(c.layer, ChunkKey{c.chunkX, c.chunkY},
+                            c.removed ? std::vector<int>{} : c.tiles);
+    ++applied;
+  }
+  return applied;
+}
+
+} // namespace criogenio
@@ -0,0 +1,381 @@
+#include "path_graph.h"
+#include "tmx_metadata.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace criogenio {
+
+namespace {
+
+constexpr int kDx[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+constexpr int kDy[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+constexpr uint32_t kStraight = 10;
+constexpr uint32_t kDiagonal = 14;
+constexpr uint32_t kInf = UINT32_MAX;
+
+uint32_t Octile(int dx, int dy) {
+  dx = std::abs(dx);
+  dy = std::abs(dy);
+  const int lo = std::min(dx, dy);
+  const int hi = std::max(dx, dy);
+  return static_cast<uint32_t>(hi) * kStraight + static_cast<uint32_t>(lo) * (kDiagonal - kStraight);
+}
+
+struct Region {
+  int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+  int Width() const { return x1 - x0; }
+  bool Contains(int x, int y) const { return x >= x0 && y >= y0 && x < x1 && y < y1; }
+  size_t Index(int x, int y) const {
+    return static_cast<size_t>(y - y0) * static_cast<size_t>(Width()) + static_cast<size_t>(x - x0);
+  }
+};
+
+/**
+ * 8-connected search confined to `r` (grid-local cells). With a goal it is A* and stops
+ * there; with goalX < 0 it is a full Dijkstra flood. `parent` holds the step index that led
+ * into each cell, -1 for the start / unreached.
+ */
+bool RegionSearch(const PathGrid &g, const Region &r, int sx, int sy, int goalX, int goalY,
+                  std::vector<uint32_t> &cost, std::vector<int8_t> &parent) {
+  const size_t cells = static_cast<size_t>(r.Width()) * static_cast<size_t>(r.y1 - r.y0);
+  cost.assign(cells, kInf);
+  parent.assign(cells, -1);
+  const bool hasGoal = goalX >= 0;
+  using Open = std::pair<uint32_t, uint32_t>; // (f, region cell)
+  std::priority_queue<Open, std::vector<Open>, std::greater<Open>> open;
+  const size_t start = r.Index(sx, sy);
+  cost[start] = 0;
+  open.emplace(hasGoal ? Octile(goalX - sx, goalY - sy) : 0u, static_cast<uint32_t>(start));
+  while (!open.empty()) {
+    const auto [f, idx] = open.top();
+    open.pop();
+    const int x = r.x0 + static_cast<int>(idx % static_cast<uint32_t>(r.Width()));
+    const int y = r.y0 + static_cast<int>(idx / static_cast<uint32_t>(r.Width()));
+    const uint32_t c = cost[idx];
+    if (f != c + (hasGoal ? Octile(goalX - x, goalY - y) : 0u))
+      continue; // stale entry
+    if (hasGoal && x == goalX && y == goalY)
+      return true;
+    for (int d = 0; d < 8; ++d) {
+      const int nx = x + kDx[d];
+      const int ny = y + kDy[d];
+      if (!r.Contains(nx, ny) || g.Blocked(nx, ny))
+        continue;
+      if (d >= 4 && (g.Blocked(nx, y) || g.Blocked(x, ny)))
+        continue; // no corner cutting
+      const uint32_t nc = c + (d < 4 ? kStraight : kDiagonal);
+      const size_t nidx = r.Index(nx, ny);
+      if (nc >= cost[nidx])
+        continue;
+      cost[nidx] = nc;
+      parent[nidx] = static_cast<int8_t>(d);
+      open.emplace(nc + (hasGoal ? Octile(goalX - nx, goalY - ny) : 0u),
+                   static_cast<uint32_t>(nidx));
+    }
+  }
+  return !hasGoal;
+}
+
+/** Append the cells after (sx, sy) up to (gx, gy) from a finished RegionSearch. */
+void AppendRegionPath(const Region &r, const std::vector<int8_t> &parent, int sx, int sy,
+                      int gx, int gy, std::vector<PathTile> &out) {
+  const size_t first = out.size();
+  int x = gx, y = gy;
+  while (x != sx || y != sy) {
+    out.push_back({x, y});
+    const int8_t d = parent[r.Index(x, y)];
+    x -= kDx[d];
+    y -= kDy[d];
+  }
+  std::reverse(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+}
+
+uint64_t HashMix(uint64_t h, uint64_t v) {
+  h ^= v;
+  return h * 1099511628211ull; // FNV-1a prime
+}
+
+} // namespace
+
+bool PathGrid::AssignFromTmx(const TmxMapMetadata &meta) {
+  if (meta.collisionSolid.empty() || meta.collisionStrideTiles <= 0 ||
+      meta.collisionHeightTiles <= 0)
+    return false;
+  minTx = meta.boundsMinTx;
+  minTy = meta.boundsMinTy;
+  width = meta.collisionStrideTiles;
+  height = meta.collisionHeightTiles;
+  solid.assign(meta.collisionSolid.begin(), meta.collisionSolid.end());
+  solid.resize(static_cast<size_t>(width) * height, 0);
+  return true;
+}
+
+void PathGrid::BlockWorldRect(float x, float y, float w, float h) {
+  if (w <= 0.f || h <= 0.f || tileW <= 0.f || tileH <= 0.f)
+    return;
+  const int tx0 = static_cast<int>(std::floor((x - originX) / tileW)) - minTx;
+  const int ty0 = static_cast<int>(std::floor((y - originY) / tileH)) - minTy;
+  const int tx1 = static_cast<int>(std::floor((x + w - originX - 1e-3f) / tileW)) - minTx;
+  const int ty1 = static_cast<int>(std::floor((y + h - originY - 1e-3f) / tileH)) - minTy;
+  for (int ty = std::max(0, ty0); ty <= std::min(height - 1, ty1); ++ty)
+    for (int tx = std::max(0, tx0); tx <= std::min(width - 1, tx1); ++tx)
+      solid[static_cast<size_t>(ty) * width + tx] = 1;
+}
+
+uint32_t HierarchicalPathGraph::ClusterOf(int lx, int ly) const {
+  return static_cast<uint32_t>((ly / kClusterSize) * clustersX_ + lx / kClusterSize);
+}
+
+void HierarchicalPathGraph::BuildCluster(Cluster &c) const {
+  const PathGrid &g = *grid_;
+  c.portals.clear();
+  auto addPortal = [&](int lx, int ly, int side) {
+    for (Portal &p : c.portals) {
+      if (p.lx == lx && p.ly == ly) {
+        p.sides |= static_cast<uint8_t>(1u << side);
+        return;
+      }
+    }
+    c.portals.push_back({lx, ly, static_cast<uint8_t>(1u << side)});
+  };
+  // Walk one border: `at(i)` is the inside cell, the outside one is one step along `side`.
+  auto scanBorder = [&](int side, int from, int to, auto at) {
+    int runStart = -1;
+    for (int i = from; i <= to; ++i) {
+      bool open = false;
+      if (i < to) {
+        const auto [x, y] = at(i);
+        open = !g.Blocked(x, y) && !g.Blocked(x + kDx[side], y + kDy[side]);
+      }
+      if (open && runStart < 0)
+        runStart = i;
+      if (!open && runStart >= 0) {
+        const int len = i - runStart;
+        if (len >= kWideEntrance) {
+          const auto [ax, ay] = at(runStart);
+          const auto [bx, by] = at(i - 1);
+          addPortal(ax, ay, side);
+          addPortal(bx, by, side);
+        } else {
+          const auto [mx, my] = at(runStart + len / 2);
+          addPortal(mx, my, side);
+        }
+        runStart = -1;
+      }
+    }
+  };
+  if (c.x1 < g.width)
+    scanBorder(0, c.y0, c.y1, [&](int y) { return std::pair<int, int>{c.x1 - 1, y}; });
+  if (c.x0 > 0)
+    scanBorder(1, c.y0, c.y1, [&](int y) { return std::pair<int, int>{c.x0, y}; });
+  if (c.y1 < g.height)
+    scanBorder(2, c.x0, c.x1, [&](int x) { return std::pair<int, int>{x, c.y1 - 1}; });
+  if (c.y0 > 0)
+    scanBorder(3, c.x0, c.x1, [&](int x) { return std::pair<int, int>{x, c.y0}; });
+
+  const size_t n = c.portals.size();
+  c.intra.assign(n * n, kInf);
+  const Region r{c.x0, c.y0, c.x1, c.y1};
+  std::vector<uint32_t> cost;
+  std::vector<int8_t> parent;
+  for (size_t i = 0; i < n; ++i) {
+    RegionSearch(g, r, c.portals[i].lx, c.portals[i].ly, -1, -1, cost, parent);
+    for (size_t j = 0; j < n; ++j)
+      c.intra[i * n + j] = cost[r.Index(c.portals[j].lx, c.portals[j].ly)];
+  }
+}
+
+std::shared_ptr<const HierarchicalPathGraph>
+HierarchicalPathGraph::Build(std::shared_ptr<const PathGrid> grid,
+                             const HierarchicalPathGraph *previous) {
+  std::shared_ptr<HierarchicalPathGraph> graph(new HierarchicalPathGraph(std::move(grid)));
+  const PathGrid &g = *graph->grid_;
+  graph->clustersX_ = (g.width + kClusterSize - 1) / kClusterSize;
+  graph->clustersY_ = (g.height + kClusterSize - 1) / kClusterSize;
+  const bool canReuse = previous && previous->grid_->width == g.width &&
+                        previous->grid_->height == g.height &&
+                        previous->grid_->minTx == g.minTx && previous->grid_->minTy == g.minTy;
+
+  graph->clusters_.resize(static_cast<size_t>(graph->clustersX_) * graph->clustersY_);
+  for (int cy = 0; cy < graph->clustersY_; ++cy) {
+    for (int cx = 0; cx < graph->clustersX_; ++cx) {
+      const size_t ci = static_cast<size_t>(cy) * graph->clustersX_ + cx;
+      Cluster &c = graph->clusters_[ci];
+      c.x0 = cx * kClusterSize;
+      c.y0 = cy * kClusterSize;
+      c.x1 = std::min(g.width, c.x0 + kClusterSize);
+      c.y1 = std::min(g.height, c.y0 + kClusterSize);
+      uint64_t h = 14695981039346656037ull;
+      for (int y = c.y0 - 1; y <= c.y1; ++y)
+        for (int x = c.x0 - 1; x <= c.x1; ++x)
+          h = HashMix(h, g.Blocked(x, y) ? 1u : 0u);
+      c.hash = h;
+      if (canReuse && previous->clusters_[ci].hash == h) {
+        c.portals = previous->clusters_[ci].portals;
+        c.intra = previous->clusters_[ci].intra;
+        ++graph->reusedClusters_;
+      } else {
+        graph->BuildCluster(c);
+      }
+    }
+  }
+
+  std::vector<int32_t> nodeAt(static_cast<size_t>(g.width) * g.height, -1);
+  for (size_t ci = 0; ci < graph->clusters_.size(); ++ci) {
+    Cluster &c = graph->clusters_[ci];
+    c.nodeIds.clear();
+    for (const Portal &p : c.portals) {
+      const uint32_t id = static_cast<uint32_t>(graph->nodes_.size());
+      c.nodeIds.push_back(id);
+      graph->nodes_.push_back({p.lx, p.ly, static_cast<uint32_t>(ci)});
+      nodeAt[static_cast<size_t>(p.ly) * g.width + p.lx] = static_cast<int32_t>(id);
+    }
+  }
+  graph->adjacency_.resize(graph->nodes_.size());
+  for (const Cluster &c : graph->clusters_) {
+    const size_t n = c.portals.size();
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        if (i != j && c.intra[i * n + j] != kInf)
+          graph->adjacency_[c.nodeIds[i]].push_back({c.nodeIds[j], c.intra[i * n + j]});
+      }
+      for (int side = 0; side < 4; ++side) {
+        if (!(c.portals[i].sides & (1u << side)))
+          continue;
+        const int nx = c.portals[i].lx + kDx[side];
+        const int ny = c.portals[i].ly + kDy[side];
+        const int32_t other = nodeAt[static_cast<size_t>(ny) * g.width + nx];
+        if (other >= 0)
+          graph->adjacency_[c.nodeIds[i]].push_back({static_cast<uint32_t>(other), kStraight});
+      }
+    }
+  }
+  return graph;
+}
+
+void HierarchicalPathGraph::Refine(uint32_t cluster, int ax, int ay, int bx, int by,
+                                   std::vector<PathTile> &out) const {
+  if (ax == bx && ay == by)
+    return;
+  const Cluster &c = clusters_[cluster];
+  const Region r{c.x0, c.y0, c.x1, c.y1};
+  std::vector<uint32_t> cost;
+  std::vector<int8_t> parent;
+  if (RegionSearch(*grid_, r, ax, ay, bx, by, cost, parent))
+    AppendRegionPath(r, parent, ax, ay, bx, by, out);
+}
+
+bool HierarchicalPathGraph::FindPath(PathTile start, PathTile goal,
+                                     std::vector<PathTile> &out) const {
+  const PathGrid &g = *grid_;
+  const int sx = start.tx - g.minTx, sy = start.ty - g.minTy;
+  const int gx = goal.tx - g.minTx, gy = goal.ty - g.minTy;
+  if (g.Blocked(sx, sy) || g.Blocked(gx, gy))
+    return false;
+  const size_t first = out.size();
+  auto toWorld = [&]() {
+    for (size_t i = first; i < out.size(); ++i) {
+      out[i].tx += g.minTx;
+      out[i].ty += g.minTy;
+    }
+    return true;
+  };
+  if (sx == gx && sy == gy)
+    return true;
+
+  const uint32_t cs = ClusterOf(sx, sy);
+  const uint32_t cg = ClusterOf(gx, gy);
+  std::vector<uint32_t> cost;
+  std::vector<int8_t> parent;
+  if (cs == cg) {
+    const Cluster &c = clusters_[cs];
+    const Region r{c.x0, c.y0, c.x1, c.y1};
+    if (RegionSearch(g, r, sx, sy, gx, gy, cost, parent)) {
+      AppendRegionPath(r, parent, sx, sy, gx, gy, out);
+      return toWorld();
+    }
+  }
+
+  // Connect start and goal to their cluster portals, then A* over the abstract graph.
+  const Cluster &startCluster = clusters_[cs];
+  const Cluster &goalCluster = clusters_[cg];
+  const Region rs{startCluster.x0, startCluster.y0, startCluster.x1, startCluster.y1};
+  const Region rg{goalCluster.x0, goalCluster.y0, goalCluster.x1, goalCluster.y1};
+  std::vector<uint32_t> startCost;
+  RegionSearch(g, rs, sx, sy, -1, -1, startCost, parent);
+  std::vector<uint32_t> goalCost;
+  RegionSearch(g, rg, gx, gy, -1, -1, goalCost, parent);
+
+  const uint32_t n = static_cast<uint32_t>(nodes_.size());
+  const uint32_t kStart = n, kGoal = n + 1;
+  std::vector<uint32_t> best(n + 2, kInf);
+  std::vector<uint32_t> from(n + 2, kInf);
+  auto heuristic = [&](uint32_t id) {
+    if (id == kGoal)
+      return 0u;
+    if (id == kStart)
+      return Octile(gx - sx, gy - sy);
+    return Octile(gx - nodes_[id].lx, gy - nodes_[id].ly);
+  };
+  using Open = std::pair<uint32_t, uint32_t>;
+  std::priority_queue<Open, std::vector<Open>, std::greater<Open>> open;
+  best[kStart] = 0;
+  open.emplace(heuristic(kStart), kStart);
+  auto relax = [&](uint32_t u, uint32_t v, uint32_t w) {
+    if (w == kInf || best[u] + w >= best[v])
+      return;
+    best[v] = best[u] + w;
+    from[v] = u;
+    open.emplace(best[v] + heuristic(v), v);
+  };
+  bool found = false;
+  while (!open.empty()) {
+    const auto [f, u] = open.top();
+    open.pop();
+    if (f != best[u] + heuristic(u))
+      continue;
+    if (u == kGoal) {
+      found = true;
+      break;
+    }
+    if (u == kStart) {
+      for (size_t i = 0; i < startCluster.portals.size(); ++i) {
+        const Portal &p = startCluster.portals[i];
+        relax(u, startCluster.nodeIds[i], startCost[rs.Index(p.lx, p.ly)]);
+      }
+      continue;
+    }
+    for (const Edge &e : adjacency_[u])
+      relax(u, e.to, e.cost);
+    if (nodes_[u].cluster == cg)
+      relax(u, kGoal, goalCost[rg.Index(nodes_[u].lx, nodes_[u].ly)]);
+  }
+  if (!found)
+    return false;
+
+  std::vector<uint32_t> hops;
+  for (uint32_t v = kGoal; v != kStart; v = from[v])
+    hops.push_back(v);
+  std::reverse(hops.begin(), hops.end());
+  int ax = sx, ay = sy;
+  uint32_t at = cs;
+  for (uint32_t v : hops) {
+    const int bx = v == kGoal ? gx : nodes_[v].lx;
+    const int by = v == kGoal ? gy : nodes_[v].ly;
+    const uint32_t bc = v == kGoal ? cg : nodes_[v].cluster;
+    if (bc == at)
+      Refine(at, ax, ay, bx, by, out);
+    else
+      out.push_back({bx, by}); // portal crossing: adjacent cells
+    ax = bx;
+    ay = by;
+    at = bc;
+  }
+  return toWorld();
+}
+
+} // namespace criogenio
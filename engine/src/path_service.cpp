@@ -0,0 +1,219 @@
+#include "path_service.h"
+#include "tmx_metadata.h"
+#include "world.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+namespace criogenio {
+
+PathService::PathService(unsigned workers) {
+  if (workers == 0)
+    workers = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+  workers_.reserve(workers);
+  for (unsigned i = 0; i < workers; ++i)
+    workers_.emplace_back([this] { WorkerLoop(); });
+}
+
+PathService::~PathService() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &t : workers_)
+    t.join();
+}
+
+void PathService::SetCollision(const TmxMapMetadata &meta, float tileW, float tileH,
+                               Vec2 origin) {
+  if (meta.collisionSolid.data() == maskData_ && meta.collisionSolid.size() == maskSize_ &&
+      meta.collisionRevision == maskRevision_ && base_.tileW == tileW && base_.tileH == tileH &&
+      base_.originX == origin.x && base_.originY == origin.y)
+    return;
+  maskData_ = meta.collisionSolid.data();
+  maskSize_ = meta.collisionSolid.size();
+  maskRevision_ = meta.collisionRevision;
+  if (!base_.AssignFromTmx(meta)) {
+    base_ = PathGrid{};
+    std::lock_guard<std::mutex> lock(mutex_);
+    grid_.reset();
+    return;
+  }
+  base_.tileW = tileW;
+  base_.tileH = tileH;
+  base_.originX = origin.x;
+  base_.originY = origin.y;
+  Publish();
+}
+
+void PathService::SetBlockers(const std::vector<Rect> &rects) {
+  const bool same = rects.size() == blockers_.size() &&
+                    std::equal(rects.begin(), rects.end(), blockers_.begin(),
+                               [](const Rect &a, const Rect &b) {
+                                 return a.x == b.x && a.y == b.y && a.width == b.width &&
+                                        a.height == b.height;
+                               });
+  if (same)
+    return;
+  blockers_ = rects;
+  if (base_.width > 0)
+    Publish();
+}
+
+void PathService::Publish() {
+  auto grid = std::make_shared<PathGrid>(base_);
+  for (const Rect &r : blockers_)
+    grid->BlockWorldRect(r.x, r.y, r.width, r.height);
+  grid->version = ++version_;
+  std::lock_guard<std::mutex> lock(mutex_);
+  grid_ = std::move(grid);
+}
+
+void PathService::Clear() {
+  base_ = PathGrid{};
+  blockers_.clear();
+  maskData_ = nullptr;
+  maskSize_ = 0;
+  maskRevision_ = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  grid_.reset();
+  jobs_.clear();
+  results_.clear();
+  stats_.pending = 0;
+}
+
+uint32_t PathService::RequestPath(World &world, ecs::EntityId entity, Vec2 from, Vec2 to) {
+  if (base_.width <= 0 || base_.tileW <= 0.f || base_.tileH <= 0.f)
+    return 0;
+  auto tileOf = [&](Vec2 p) {
+    return PathTile{static_cast<int>(std::floor((p.x - base_.originX) / base_.tileW)),
+                    static_cast<int>(std::floor((p.y - base_.originY) / base_.tileH))};
+  };
+  Job job;
+  job.requestId = nextRequestId_++;
+  job.entity = entity;
+  job.from = tileOf(from);
+  job.to = tileOf(to);
+
+  Path2D *path = world.GetComponent<Path2D>(entity);
+  if (!path)
+    path = &world.AddComponent<Path2D>(entity);
+  path->status = Path2D::Status::Pending;
+  path->requestId = job.requestId;
+  path->waypoints.clear();
+  path->next = 0;
+  path->goal = to;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(job);
+    ++stats_.requested;
+    ++stats_.pending;
+  }
+  wake_.notify_one();
+  return job.requestId;
+}
+
+size_t PathService::Deliver(World &world) {
+  static thread_local std::vector<Result> ready;
+  ready.clear();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (results_.empty())
+      return 0;
+    ready.swap(results_);
+  }
+  size_t delivered = 0;
+  for (Result &r : ready) {
+    if (!world.HasEntity(r.entity))
+      continue;
+    Path2D *path = world.GetComponent<Path2D>(r.entity);
+    if (!path || path->requestId != r.requestId)
+      continue; // superseded by a newer request
+    path->status = r.ok ? Path2D::Status::Ready : Path2D::Status::Failed;
+    path->waypoints = std::move(r.waypoints);
+    path->next = 0;
+    ++delivered;
+  }
+  ready.clear();
+  return delivered;
+}
+
+void PathService::WaitIdle() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return jobs_.empty() && busy_ == 0; });
+}
+
+PathServiceStats PathService::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+std::shared_ptr<const HierarchicalPathGraph>
+PathService::GraphFor(std::shared_ptr<const PathGrid> grid) {
+  std::lock_guard<std::mutex> lock(graphMutex_);
+  if (graph_ && graph_->Version() >= grid->version)
+    return graph_;
+  const auto t0 = std::chrono::steady_clock::now();
+  graph_ = HierarchicalPathGraph::Build(std::move(grid), graph_.get());
+  const double ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+  std::lock_guard<std::mutex> statsLock(mutex_);
+  ++stats_.graphBuilds;
+  stats_.clusters = graph_->ClusterCount();
+  stats_.nodes = graph_->NodeCount();
+  stats_.reusedClusters = graph_->ReusedClusters();
+  stats_.lastBuildMs = ms;
+  return graph_;
+}
+
+void PathService::WorkerLoop() {
+  std::vector<PathTile> tiles;
+  for (;;) {
+    Job job;
+    std::shared_ptr<const PathGrid> grid;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (stop_)
+        return;
+      job = jobs_.front();
+      jobs_.pop_front();
+      grid = grid_;
+      ++busy_;
+    }
+
+    Result result;
+    result.requestId = job.requestId;
+    result.entity = job.entity;
+    const auto t0 = std::chrono::steady_clock::now();
+    if (grid) {
+      const std::shared_ptr<const HierarchicalPathGraph> graph = GraphFor(grid);
+      tiles.clear();
+      result.ok = graph->FindPath(job.from, job.to, tiles);
+      const PathGrid &g = graph->Grid();
+      result.waypoints.reserve(tiles.size());
+      for (const PathTile &t : tiles)
+        result.waypoints.push_back({g.originX + (static_cast<float>(t.tx) + 0.5f) * g.tileW,
+                                    g.originY + (static_cast<float>(t.ty) + 0.5f) * g.tileH});
+    }
+    const double ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!result.ok)
+        ++stats_.failed;
+      ++stats_.delivered;
+      stats_.lastQueryMs = ms;
+      if (stats_.pending > 0)
+        --stats_.pending;
+      results_.push_back(std::move(result));
+      --busy_;
+    }
+    idle_.notify_all();
+  }
+}
+
+} // namespace criogenio
@@ -0,0 +1,194 @@
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace criogenio {
+
+namespace {
+
+void writeJsonString(std::ostream &out, const char *s) {
+  out << '"';
+  for (; s && *s; ++s) {
+    const char c = *s;
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof buf, "\\u%04x", static_cast<unsigned>(c));
+      out << buf;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+} // namespace
+
+Profiler &Profiler::instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+uint64_t Profiler::NowNs() {
+  using namespace std::chrono;
+  return static_cast<uint64_t>(
+      duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+Profiler::ThreadRing &Profiler::localRing() {
+  thread_local ThreadRing *ring = nullptr;
+  if (!ring) {
+    auto owned = std::make_unique<ThreadRing>();
+    owned->events.resize(kRingCapacity);
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    owned->id = static_cast<uint32_t>(rings_.size());
+    owned->name = "thread " + std::to_string(owned->id);
+    ring = owned.get();
+    rings_.push_back(std::move(owned));
+  }
+  return *ring;
+}
+
+void Profiler::BeginFrame() {
+  ThreadRing &ring = localRing();
+  if (!mainRing_) {
+    mainRing_ = &ring;
+    std::lock_guard<std::mutex> lock(ring.mutex);
+    ring.name = "main";
+  }
+  const uint64_t now = NowNs();
+  if (frameStartNs_ != 0)
+    lastFrameNs_ = now - frameStartNs_;
+  frameStartNs_ = now;
+  frame_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const char *name) {
+  ThreadRing &ring = localRing();
+  std::lock_guard<std::mutex> lock(ring.mutex);
+  ring.name = name ? name : "";
+}
+
+uint32_t Profiler::EnterZone() { return localRing().depth++; }
+
+void Profiler::ExitZone(const char *name, uint64_t startNs, uint32_t depth) {
+  const uint64_t endNs = NowNs();
+  ThreadRing &ring = localRing();
+  ring.depth = depth;
+  std::lock_guard<std::mutex> lock(ring.mutex);
+  ProfileZoneEvent &e = ring.events[ring.written % kRingCapacity];
+  e.name = name;
+  e.startNs = startNs;
+  e.endNs = endNs;
+  e.depth = depth;
+  e.frame = frame_.load(std::memory_order_relaxed);
+  ++ring.written;
+}
+
+std::vector<ProfileZoneEvent> Profiler::CollectMainThreadFrame(uint32_t frame) const {
+  std::vector<ProfileZoneEvent> out;
+  if (!mainRing_)
+    return out;
+  const ThreadRing &ring = *mainRing_;
+  std::lock_guard<std::mutex> lock(ring.mutex);
+  const uint64_t count = std::min<uint64_t>(ring.written, kRingCapacity);
+  // Walk backwards from the newest event; frames are contiguous in the ring.
+  for (uint64_t i = 0; i < count; ++i) {
+    const ProfileZoneEvent &e = ring.events[(ring.written - 1 - i) % kRingCapacity];
+    if (e.frame == frame)
+      out.push_back(e);
+    else if (e.frame < frame)
+      break;
+  }
+  std::sort(out.begin(), out.end(), [](const ProfileZoneEvent &a, const ProfileZoneEvent &b) {
+    return a.startNs < b.startNs || (a.startNs == b.startNs && a.depth < b.depth);
+  });
+  return out;
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    return false;
+  std::lock_guard<std::mutex> registryLock(registryMutex_);
+  uint64_t originNs = UINT64_MAX;
+  for (const auto &ring : rings_) {
+    std::lock_guard<std::mutex> lock(ring->mutex);
+    const uint64_t count = std::min<uint64_t>(ring->written, kRingCapacity);
+    for (uint64_t i = 0; i < count; ++i)
+      originNs = std::min(originNs, ring->events[(ring->written - 1 - i) % kRingCapacity].startNs);
+  }
+  if (originNs == UINT64_MAX)
+    originNs = 0;
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  char buf[160];
+  for (const auto &ring : rings_) {
+    std::lock_guard<std::mutex> lock(ring->mutex);
+    out << (first ? "" : ",") << "\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->id
+        << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+    writeJsonString(out, ring->name.c_str());
+    out << "}}";
+    first = false;
+    const uint64_t count = std::min<uint64_t>(ring->written, kRingCapacity);
+    for (uint64_t i = count; i > 0; --i) {
+      const ProfileZoneEvent &e = ring->events[(ring->written - i) % kRingCapacity];
+      out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->id << ",\"name\":";
+      writeJsonString(out, e.name);
+      std::snprintf(buf, sizeof buf, ",\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}",
+                    static_cast<double>(e.startNs - originNs) / 1000.0,
+                    static_cast<double>(e.endNs - e.startNs) / 1000.0, e.frame);
+      out << buf;
+    }
+  }
+  out << "\n]}\n";
+  return static_cast<bool>(out);
+}
+
+void TimingWindow::Add(double ms) {
+  if (count_ == kWindow)
+    sum_ -= samples_[next_];
+  else
+    ++count_;
+  samples_[next_] = static_cast<float>(ms);
+  sum_ += samples_[next_];
+  next_ = (next_ + 1) % kWindow;
+  ++total_;
+}
+
+void TimingWindow::Reset() { *this = TimingWindow{}; }
+
+double TimingWindow::MaxMs() const {
+  float m = 0.f;
+  for (size_t i = 0; i < count_; ++i)
+    m = std::max(m, samples_[i]);
+  return m;
+}
+
+double TimingWindow::PercentileMs(double p) const {
+  if (count_ == 0)
+    return 0.0;
+  std::array<float, kWindow> sorted;
+  std::copy(samples_.begin(), samples_.begin() + static_cast<std::ptrdiff_t>(count_),
+            sorted.begin());
+  const double rank = std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count_));
+  const size_t idx = static_cast<size_t>(std::max(rank, 1.0)) - 1;
+  std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(idx),
+                   sorted.begin() + static_cast<std::ptrdiff_t>(count_));
+  return sorted[idx];
+}
+
+void Profiler::Clear() {
+  std::lock_guard<std::mutex> registryLock(registryMutex_);
+  for (const auto &ring : rings_) {
+    std::lock_guard<std::mutex> lock(ring->mutex);
+    ring->written = 0;
+  }
+}
+
+} // namespace criogenio
@@ -5,11 +5,15 @@
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_surface.h>
 #include <SDL3/SDL_pixels.h>
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <string>
 #include <fstream>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -39,6 +43,26 @@ struct RendererImpl {
   Camera2D camera;
   bool quitRequested = false;
   SDL_Texture* currentRenderTarget = nullptr;  // when set, viewport follows target size
+  struct SavedTarget {
+    SDL_Texture* sdlTarget = nullptr;
+    SDL_Texture* currentRenderTarget = nullptr;
+    int viewportW = 0;
+    int viewportH = 0;
+    bool cameraActive = false;
+    Camera2D camera;
+  };
+  std::vector<SavedTarget> targetStack;
+  // Sprite batch: one run of quads sharing texture + blend, flushed via SDL_RenderGeometry.
+  int batchDepth = 0;
+  SDL_Texture* batchTexture = nullptr;
+  TextureBlendMode batchBlend = TextureBlendMode::Alpha;
+  std::vector<SDL_Vertex> batchVertices;
+  std::vector<int> batchIndices;
+  Renderer::SpriteBatchStats batchStats;
+  Renderer::SpriteBatchStats lastFrameBatchStats;
+  TextureBlendMode drawBlend = TextureBlendMode::Alpha;
+  // Radial textures keyed by (size << 8) | falloff step; see Renderer::GetRadialTexture.
+  std::unordered_map<uint32_t, TextureHandle> radialTextures;
 };
 
 static RendererImpl* s_impl = nullptr;
@@ -71,6 +95,10 @@ static SDL_BlendMode ToSDLBlend(TextureBlendMode m) {
     return SDL_BLENDMODE_MOD;
   case TextureBlendMode::Mul:
     return SDL_BLENDMODE_MUL;
+  case TextureBlendMode::Premultiplied:
+    return SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+  case TextureBlendMode::AddPremultiplied:
+    return SDL_BLENDMODE_ADD_PREMULTIPLIED;
   }
   return SDL_BLENDMODE_BLEND;
 }
@@ -87,6 +115,79 @@ static void RestoreTextureBlend(SDL_Texture* tex, SDL_BlendMode prev) {
   SDL_SetTextureBlendMode(tex, prev);
 }
 
+static void flushSpriteBatch() {
+  if (!s_impl || !s_impl->renderer || s_impl->batchVertices.empty())
+    return;
+  SDL_BlendMode prevBlend;
+  ApplyTextureBlend(s_impl->batchTexture, s_impl->batchBlend, &prevBlend);
+  SDL_RenderGeometry(s_impl->renderer, s_impl->batchTexture, s_impl->batchVertices.data(),
+                     static_cast<int>(s_impl->batchVertices.size()),
+                     s_impl->batchIndices.data(),
+                     static_cast<int>(s_impl->batchIndices.size()));
+  RestoreTextureBlend(s_impl->batchTexture, prevBlend);
+  s_impl->batchVertices.clear();
+  s_impl->batchIndices.clear();
+  s_impl->batchTexture = nullptr;
+  ++s_impl->batchStats.drawCalls;
+}
+
+// Screen rect of a sprite drawn at world/screen `dest`, and its rotation pivot relative to that
+// rect (`origin` scaled by the camera zoom). Shared by the batched and immediate paths.
+static void spriteScreenRect(const Rect& dest, Vec2 origin, SDL_FRect& dst, SDL_FPoint& pivot) {
+  dst = {dest.x, dest.y, dest.width, dest.height};
+  pivot = {origin.x, origin.y};
+  if (s_impl->cameraActive) {
+    WorldToScreen(dest.x, dest.y, s_impl->camera, s_impl->viewportW, s_impl->viewportH, dst.x,
+                  dst.y, s_impl->currentRenderTarget != nullptr);
+    const float zoom = s_impl->camera.zoom;
+    dst.w *= zoom;
+    dst.h *= zoom;
+    pivot.x *= zoom;
+    pivot.y *= zoom;
+  }
+}
+
+// Append one quad to the batch. `dst` is screen space and `pivot` is relative to it, exactly
+// as SDL_RenderTextureRotated takes them; rotation (degrees, clockwise) and flips match it too.
+static void batchQuad(SDL_Texture* tex, float texW, float texH, const SDL_FRect& src,
+                      const SDL_FRect& dst, double rotation, SDL_FPoint pivot, Color tint,
+                      TextureBlendMode blend, bool flipH, bool flipV) {
+  if (texW <= 0.f || texH <= 0.f)
+    return;
+  if (tex != s_impl->batchTexture || blend != s_impl->batchBlend)
+    flushSpriteBatch();
+  s_impl->batchTexture = tex;
+  s_impl->batchBlend = blend;
+
+  float u0 = src.x / texW, u1 = (src.x + src.w) / texW;
+  float v0 = src.y / texH, v1 = (src.y + src.h) / texH;
+  if (flipH)
+    std::swap(u0, u1);
+  if (flipV)
+    std::swap(v0, v1);
+  Vec2 q[4];
+  RotatedQuadCorners({dst.x, dst.y, dst.w, dst.h}, {pivot.x, pivot.y},
+                     static_cast<float>(rotation), q);
+  const SDL_FPoint corners[4] = {{q[0].x, q[0].y}, {q[1].x, q[1].y}, {q[2].x, q[2].y},
+                                 {q[3].x, q[3].y}};
+  const SDL_FColor col = {tint.r / 255.f, tint.g / 255.f, tint.b / 255.f, tint.a / 255.f};
+  const SDL_FPoint uv[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+  const int base = static_cast<int>(s_impl->batchVertices.size());
+  for (int i = 0; i < 4; ++i)
+    s_impl->batchVertices.push_back(SDL_Vertex{corners[i], col, uv[i]});
+  const int quadIndices[6] = {0, 1, 2, 0, 2, 3};
+  for (int i : quadIndices)
+    s_impl->batchIndices.push_back(base + i);
+  ++s_impl->batchStats.quads;
+}
+
+static void textureSize(TextureHandle texture, float& w, float& h) {
+  w = static_cast<float>(texture.width);
+  h = static_cast<float>(texture.height);
+  if (w <= 0.f || h <= 0.f)
+    SDL_GetTextureSize((SDL_Texture*)texture.opaque, &w, &h);
+}
+
 void SetRendererInitError(const char* fallback) {
   const char* sdlErr = SDL_GetError();
   if (sdlErr && sdlErr[0] != '\0')
@@ -97,6 +198,25 @@ void SetRendererInitError(const char* fallback) {
 
 } // namespace
 
+void RotatedQuadCorners(const Rect& dst, Vec2 pivot, float rotation, Vec2 out[4]) {
+  out[0] = {dst.x, dst.y};
+  out[1] = {dst.x + dst.width, dst.y};
+  out[2] = {dst.x + dst.width, dst.y + dst.height};
+  out[3] = {dst.x, dst.y + dst.height};
+  if (std::fabs(rotation) < 0.001f)
+    return;
+  const double rad = static_cast<double>(rotation) * 3.14159265358979323846 / 180.0;
+  const float c = static_cast<float>(std::cos(rad));
+  const float sn = static_cast<float>(std::sin(rad));
+  const float px = dst.x + pivot.x;
+  const float py = dst.y + pivot.y;
+  for (int i = 0; i < 4; ++i) {
+    const float dx = out[i].x - px;
+    const float dy = out[i].y - py;
+    out[i] = {px + dx * c - dy * sn, py + dx * sn + dy * c};
+  }
+}
+
 Renderer::Renderer(int width, int height, const std::string& title) {
   s_rendererInitError.clear();
   if (SDL_Init(SDL_INIT_VIDEO) != true) {
@@ -127,6 +247,10 @@ Renderer::Renderer(int width, int height, const std::string& title) {
 
 Renderer::~Renderer() {
   if (s_impl) {
+    for (auto& [key, tex] : s_impl->radialTextures)
+      if (tex.valid())
+        SDL_DestroyTexture((SDL_Texture*)tex.opaque);
+    s_impl->radialTextures.clear();
     if (s_impl->renderer)
       SDL_DestroyRenderer(s_impl->renderer);
     if (s_impl->window)
@@ -156,16 +280,79 @@ void Renderer::EndCamera2D() {
     s_impl->cameraActive = false;
 }
 
+bool Renderer::GetCameraWorldBounds(Rect& out) const {
+  if (!s_impl || !s_impl->cameraActive || s_impl->camera.zoom <= 0.f)
+    return false;
+  const Camera2D& cam = s_impl->camera;
+  const float invZoom = 1.f / cam.zoom;
+  // Inverse of WorldToScreen at screen (0,0); the vertical flip for render targets mirrors
+  // the same world span, so it does not change the covered rect.
+  out.x = (0.f - cam.offset.x - s_impl->viewportW * 0.5f) * invZoom + cam.target.x;
+  out.y = (0.f - cam.offset.y - s_impl->viewportH * 0.5f) * invZoom + cam.target.y;
+  out.width = static_cast<float>(s_impl->viewportW) * invZoom;
+  out.height = static_cast<float>(s_impl->viewportH) * invZoom;
+  return true;
+}
+
 void Renderer::BeginFrame() {
   if (!s_impl || !s_impl->renderer)
     return;
+  s_impl->batchStats = SpriteBatchStats{};
   SDL_SetRenderDrawColor(s_impl->renderer, 64, 64, 64, 255);
   SDL_RenderClear(s_impl->renderer);
 }
 
 void Renderer::EndFrame() {
-  if (s_impl && s_impl->renderer)
-    SDL_RenderPresent(s_impl->renderer);
+  if (!s_impl || !s_impl->renderer)
+    return;
+  flushSpriteBatch();
+  if (s_impl->batchDepth != 0) {
+    std::fprintf(stderr, "Renderer: %d BeginSpriteBatch call(s) without EndSpriteBatch this frame\n",
+                 s_impl->batchDepth);
+    assert(s_impl->batchDepth == 0 && "unbalanced BeginSpriteBatch / EndSpriteBatch");
+    s_impl->batchDepth = 0;
+  }
+  s_impl->lastFrameBatchStats = s_impl->batchStats;
+  SDL_RenderPresent(s_impl->renderer);
+}
+
+void Renderer::BeginSpriteBatch() {
+  if (s_impl)
+    ++s_impl->batchDepth;
+}
+
+void Renderer::EndSpriteBatch() {
+  if (!s_impl || s_impl->batchDepth == 0)
+    return;
+  if (--s_impl->batchDepth == 0)
+    flushSpriteBatch();
+}
+
+void Renderer::FlushSpriteBatch() { flushSpriteBatch(); }
+
+bool Renderer::IsSpriteBatchActive() const { return s_impl && s_impl->batchDepth > 0; }
+
+Renderer::SpriteBatchStats Renderer::GetSpriteBatchStats() const {
+  return s_impl ? s_impl->lastFrameBatchStats : SpriteBatchStats{};
+}
+
+void Renderer::SubmitSprite(TextureHandle texture, Rect source, Rect dest, Vec2 origin,
+                            float rotation, Color tint, TextureBlendMode blend, bool flipH,
+                            bool flipV) {
+  if (!s_impl || !s_impl->renderer || !texture.valid())
+    return;
+  if (s_impl->batchDepth == 0) {
+    DrawTextureProFlipped(texture, source, dest, origin, rotation, tint, flipH, flipV, blend);
+    return;
+  }
+  SDL_FRect dst;
+  SDL_FPoint pivot;
+  spriteScreenRect(dest, origin, dst, pivot);
+  float tw = 0.f, th = 0.f;
+  textureSize(texture, tw, th);
+  batchQuad((SDL_Texture*)texture.opaque, tw, th,
+            SDL_FRect{source.x, source.y, source.width, source.height}, dst,
+            static_cast<double>(rotation), pivot, tint, blend, flipH, flipV);
 }
 
 static void drawRectImpl(SDL_Renderer* r, float x, float y, float w, float h,
@@ -192,6 +379,7 @@ static void drawRectImpl(SDL_Renderer* r, float x, float y, float w, float h,
 void Renderer::DrawRect(float x, float y, float w, float h, Color color) {
   if (!s_impl || !s_impl->renderer)
     return;
+  flushSpriteBatch();
   bool flipY = (s_impl->currentRenderTarget != nullptr);
   drawRectImpl(s_impl->renderer, x, y, w, h, color, true, s_impl->viewportW,
                s_impl->viewportH, s_impl->cameraActive,
@@ -201,6 +389,7 @@ void Renderer::DrawRect(float x, float y, float w, float h, Color color) {
 void Renderer::DrawRectOutline(float x, float y, float w, float h, Color color) {
   if (!s_impl || !s_impl->renderer)
     return;
+  flushSpriteBatch();
   bool flipY = (s_impl->currentRenderTarget != nullptr);
   drawRectImpl(s_impl->renderer, x, y, w, h, color, false, s_impl->viewportW,
                s_impl->viewportH, s_impl->cameraActive,
@@ -210,6 +399,7 @@ void Renderer::DrawRectOutline(float x, float y, float w, float h, Color color)
 void Renderer::DrawCircle(float x, float y, float r, Color color) {
   if (!s_impl || !s_impl->renderer)
     return;
+  flushSpriteBatch();
   float cx = x, cy = y;
   bool flipY = (s_impl->currentRenderTarget != nullptr);
   if (s_impl->cameraActive) {
@@ -237,6 +427,7 @@ void Renderer::DrawCircle(float x, float y, float r, Color color) {
 void Renderer::DrawLine(float x1, float y1, float x2, float y2, Color color) {
   if (!s_impl || !s_impl->renderer)
     return;
+  flushSpriteBatch();
   if (s_impl->cameraActive) {
     float sx1, sy1, sx2, sy2;
     WorldToScreen(x1, y1, s_impl->camera, s_impl->viewportW, s_impl->viewportH,
@@ -267,12 +458,14 @@ void Renderer::DrawGrid(int slices, float spacing) {
 void Renderer::SetRenderDrawBlendMode(TextureBlendMode blend) {
   if (!s_impl || !s_impl->renderer)
     return;
+  s_impl->drawBlend = blend;
   SDL_SetRenderDrawBlendMode(s_impl->renderer, ToSDLBlend(blend));
 }
 
 void Renderer::DrawRectScreen(float x, float y, float w, float h, Color color) {
   if (!s_impl || !s_impl->renderer)
     return;
+  flushSpriteBatch();
   SDL_FRect fr = {x, y, w, h};
   SDL_SetRenderDrawColorFromColor(s_impl->renderer, color);
   SDL_RenderFillRect(s_impl->renderer, &fr);
@@ -280,8 +473,38 @@ void Renderer::DrawRectScreen(float x, float y, float w, float h, Color color) {
 
 void Renderer::DrawFilledCircleScreen(float centerX, float centerY, float radius,
                                     Color color) {
+  DrawRadialGradientScreen(centerX, centerY, radius, 0.f, color);
+}
+
+void Renderer::DrawRadialGradientScreen(float centerX, float centerY, float radius,
+                                        float falloff, Color color) {
   if (!s_impl || !s_impl->renderer || radius <= 0.5f)
     return;
+  const TextureHandle texture = GetRadialTexture(radius, falloff);
+  if (texture.valid()) {
+    SDL_Texture* tex = (SDL_Texture*)texture.opaque;
+    const float size = static_cast<float>(texture.width);
+    const SDL_FRect src = {0.f, 0.f, size, size};
+    const SDL_FRect dst = {centerX - radius, centerY - radius, radius * 2.f, radius * 2.f};
+    if (s_impl->batchDepth > 0) {
+      batchQuad(tex, size, size, src, dst, 0.0, SDL_FPoint{0.f, 0.f}, color,
+                s_impl->drawBlend, false, false);
+      return;
+    }
+    flushSpriteBatch();
+    SDL_BlendMode prevBlend;
+    ApplyTextureBlend(tex, s_impl->drawBlend, &prevBlend);
+    SDL_SetTextureColorMod(tex, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(tex, color.a);
+    SDL_RenderTexture(s_impl->renderer, tex, &src, &dst);
+    SDL_SetTextureColorMod(tex, 255, 255, 255);
+    SDL_SetTextureAlphaMod(tex, 255);
+    RestoreTextureBlend(tex, prevBlend);
+    return;
+  }
+
+  // No texture (creation failed): hard disk, one fill per scanline.
+  flushSpriteBatch();
   SDL_SetRenderDrawColorFromColor(s_impl->renderer, color);
   const int r = static_cast<int>(std::ceil(radius));
   const int cx = static_cast<int>(std::floor(centerX));
@@ -300,6 +523,46 @@ void Renderer::DrawFilledCircleScreen(float centerX, float centerY, float radius
   }
 }
 
+TextureHandle Renderer::GetRadialTexture(float radius, float falloff) {
+  if (!s_impl || !s_impl->renderer || !(radius > 0.f))
+    return {};
+  int size = kRadialTextureMinSize;
+  while (size < kRadialTextureMaxSize && static_cast<float>(size) < radius * 2.f)
+    size *= 2;
+  const int step = static_cast<int>(
+      std::lround(std::clamp(falloff, 0.f, 1.f) * static_cast<float>(kRadialFalloffSteps)));
+  const uint32_t key = (static_cast<uint32_t>(size) << 8) | static_cast<uint32_t>(step);
+  auto it = s_impl->radialTextures.find(key);
+  if (it != s_impl->radialTextures.end())
+    return it->second;
+
+  // White texels, alpha = coverage. The hard edge is antialiased over one texel.
+  const float half = static_cast<float>(size) * 0.5f;
+  const float ramp = static_cast<float>(step) / static_cast<float>(kRadialFalloffSteps);
+  std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      const float dx = static_cast<float>(x) + 0.5f - half;
+      const float dy = static_cast<float>(y) + 0.5f - half;
+      const float dist = std::sqrt(dx * dx + dy * dy);
+      float a = std::clamp(half - dist + 0.5f, 0.f, 1.f);
+      if (ramp > 0.f)
+        a *= std::clamp((1.f - dist / half) / ramp, 0.f, 1.f);
+      uint8_t* p = &pixels[(static_cast<size_t>(y) * size + x) * 4];
+      p[0] = p[1] = p[2] = 255;
+      p[3] = static_cast<uint8_t>(a * 255.f + 0.5f);
+    }
+  }
+  // Failures are cached too, so a renderer without texture support does not retry per draw.
+  TextureHandle texture = CreateTextureFromPixels(size, size, pixels.data());
+  s_impl->radialTextures.emplace(key, texture);
+  return texture;
+}
+
+size_t Renderer::GetRadialTextureCacheSize() const {
+  return s_impl ? s_impl->radialTextures.size() : 0;
+}
+
 void Renderer::DrawTextString(const std::string& text, int x, int y, int size,
                               Color color) {
   (void)text;
@@ -313,6 +576,7 @@ void Renderer::DrawTextString(const std::string& text, int x, int y, int size,
 void Renderer::DrawDebugText(float x, float y, const char* utf8) {
   if (!s_impl || !s_impl->renderer || !utf8)
     return;
+  flushSpriteBatch();
   SDL_SetRenderDrawColor(s_impl->renderer, 255, 255, 255, 255);
   SDL_RenderDebugText(s_impl->renderer, x, y, utf8);
 }
@@ -320,6 +584,7 @@ void Renderer::DrawDebugText(float x, float y, const char* utf8) {
 void Renderer::DrawTexture(TextureHandle texture, float x, float y) {
   if (!s_impl || !s_impl->renderer || !texture.valid())
     return;
+  flushSpriteBatch();
   SDL_Texture* tex = (SDL_Texture*)texture.opaque;
   float w = 0, h = 0;
   SDL_GetTextureSize(tex, &w, &h);
@@ -346,6 +611,12 @@ void Renderer::DrawTextureRec(TextureHandle texture, Rect source, Vec2 position,
                   s_impl->viewportH, dx, dy, flipY);
   }
   SDL_FRect dst = {dx, dy, source.width, source.height};
+  if (s_impl->batchDepth > 0) {
+    float tw = 0.f, th = 0.f;
+    textureSize(texture, tw, th);
+    batchQuad(tex, tw, th, src, dst, 0.0, SDL_FPoint{0.f, 0.f}, tint, blend, false, false);
+    return;
+  }
   SDL_BlendMode prevBlend;
   ApplyTextureBlend(tex, blend, &prevBlend);
   SDL_SetTextureColorMod(tex, tint.r, tint.g, tint.b);
@@ -361,19 +632,15 @@ void Renderer::DrawTexturePro(TextureHandle texture, Rect source, Rect dest,
                               TextureBlendMode blend) {
   if (!s_impl || !s_impl->renderer || !texture.valid())
     return;
+  if (s_impl->batchDepth > 0) {
+    SubmitSprite(texture, source, dest, origin, rotation, tint, blend);
+    return;
+  }
   SDL_Texture* tex = (SDL_Texture*)texture.opaque;
   SDL_FRect src = {source.x, source.y, source.width, source.height};
-  float dx = dest.x, dy = dest.y;
-  float dw = dest.width, dh = dest.height;
-  bool flipY = (s_impl->currentRenderTarget != nullptr);
-  if (s_impl->cameraActive) {
-    WorldToScreen(dest.x, dest.y, s_impl->camera, s_impl->viewportW,
-                  s_impl->viewportH, dx, dy, flipY);
-    float zoom = s_impl->camera.zoom;
-    dw = dest.width * zoom;
-    dh = dest.height * zoom;
-  }
-  SDL_FRect dst = {dx, dy, dw, dh};
+  SDL_FRect dst;
+  SDL_FPoint center;
+  spriteScreenRect(dest, origin, dst, center);
   SDL_BlendMode prevBlend;
   ApplyTextureBlend(tex, blend, &prevBlend);
   SDL_SetTextureColorMod(tex, tint.r, tint.g, tint.b);
@@ -381,13 +648,6 @@ void Renderer::DrawTexturePro(TextureHandle texture, Rect source, Rect dest,
   if (std::fabs(rotation) < 0.001f) {
     SDL_RenderTexture(s_impl->renderer, tex, &src, &dst);
   } else {
-    float ox = origin.x, oy = origin.y;
-    if (s_impl->cameraActive) {
-      float zoom = s_impl->camera.zoom;
-      ox = origin.x * zoom;
-      oy = origin.y * zoom;
-    }
-    SDL_FPoint center = {dx + ox, dy + oy};
     SDL_RenderTextureRotated(s_impl->renderer, tex, &src, &dst,
                              static_cast<double>(rotation), &center,
                              SDL_FLIP_NONE);
@@ -403,34 +663,23 @@ void Renderer::DrawTextureProFlipped(TextureHandle texture, Rect source, Rect de
                                      TextureBlendMode blend) {
   if (!s_impl || !s_impl->renderer || !texture.valid())
     return;
+  if (s_impl->batchDepth > 0) {
+    SubmitSprite(texture, source, dest, origin, rotation, tint, blend, flipH, flipV);
+    return;
+  }
   if (!flipH && !flipV) {
     DrawTexturePro(texture, source, dest, origin, rotation, tint, blend);
     return;
   }
   SDL_Texture* tex = (SDL_Texture*)texture.opaque;
   SDL_FRect src = {source.x, source.y, source.width, source.height};
-  float dx = dest.x, dy = dest.y;
-  float dw = dest.width, dh = dest.height;
-  bool flipY = (s_impl->currentRenderTarget != nullptr);
-  if (s_impl->cameraActive) {
-    WorldToScreen(dest.x, dest.y, s_impl->camera, s_impl->viewportW,
-                  s_impl->viewportH, dx, dy, flipY);
-    float zoom = s_impl->camera.zoom;
-    dw = dest.width * zoom;
-    dh = dest.height * zoom;
-  }
-  SDL_FRect dst = {dx, dy, dw, dh};
+  SDL_FRect dst;
+  SDL_FPoint center;
+  spriteScreenRect(dest, origin, dst, center);
   SDL_BlendMode prevBlend;
   ApplyTextureBlend(tex, blend, &prevBlend);
   SDL_SetTextureColorMod(tex, tint.r, tint.g, tint.b);
   SDL_SetTextureAlphaMod(tex, tint.a);
-  float ox = origin.x, oy = origin.y;
-  if (s_impl->cameraActive) {
-    float zoom = s_impl->camera.zoom;
-    ox = origin.x * zoom;
-    oy = origin.y * zoom;
-  }
-  SDL_FPoint center = {dx + ox, dy + oy};
   int flipMask = SDL_FLIP_NONE;
   if (flipH) flipMask |= SDL_FLIP_HORIZONTAL;
   if (flipV) flipMask |= SDL_FLIP_VERTICAL;
@@ -519,6 +768,7 @@ TextureHandle Renderer::CreateRenderTarget(int width, int height) {
 void Renderer::SetRenderTarget(TextureHandle target) {
   if (!s_impl || !s_impl->renderer)
     return;
+  flushSpriteBatch();
   SDL_Texture* tex = target.valid() ? (SDL_Texture*)target.opaque : nullptr;
   if (SDL_SetRenderTarget(s_impl->renderer, tex) == 0) {
     s_impl->currentRenderTarget = tex;
@@ -537,6 +787,7 @@ void Renderer::SetRenderTarget(TextureHandle target) {
 void Renderer::UnsetRenderTarget() {
   if (!s_impl || !s_impl->renderer)
     return;
+  flushSpriteBatch();
   SDL_SetRenderTarget(s_impl->renderer, nullptr);
   s_impl->currentRenderTarget = nullptr;
   int w = 0, h = 0;
@@ -545,9 +796,53 @@ void Renderer::UnsetRenderTarget() {
   s_impl->viewportH = h;
 }
 
+bool Renderer::IsRenderTargetActive() const {
+  return s_impl && s_impl->currentRenderTarget != nullptr;
+}
+
+void Renderer::PushRenderTarget(TextureHandle target, bool clear) {
+  if (!s_impl || !s_impl->renderer || !target.valid())
+    return;
+  flushSpriteBatch();
+  RendererImpl::SavedTarget saved;
+  saved.sdlTarget = SDL_GetRenderTarget(s_impl->renderer);
+  saved.currentRenderTarget = s_impl->currentRenderTarget;
+  saved.viewportW = s_impl->viewportW;
+  saved.viewportH = s_impl->viewportH;
+  saved.cameraActive = s_impl->cameraActive;
+  saved.camera = s_impl->camera;
+  s_impl->targetStack.push_back(saved);
+
+  SDL_Texture* tex = (SDL_Texture*)target.opaque;
+  SDL_SetRenderTarget(s_impl->renderer, tex);
+  s_impl->currentRenderTarget = tex;
+  s_impl->viewportW = target.width;
+  s_impl->viewportH = target.height;
+  s_impl->cameraActive = false;
+  if (clear) {
+    SDL_SetRenderDrawColor(s_impl->renderer, 0, 0, 0, 0);
+    SDL_RenderClear(s_impl->renderer);
+  }
+}
+
+void Renderer::PopRenderTarget() {
+  if (!s_impl || !s_impl->renderer || s_impl->targetStack.empty())
+    return;
+  flushSpriteBatch();
+  RendererImpl::SavedTarget saved = s_impl->targetStack.back();
+  s_impl->targetStack.pop_back();
+  SDL_SetRenderTarget(s_impl->renderer, saved.sdlTarget);
+  s_impl->currentRenderTarget = saved.currentRenderTarget;
+  s_impl->viewportW = saved.viewportW;
+  s_impl->viewportH = saved.viewportH;
+  s_impl->cameraActive = saved.cameraActive;
+  s_impl->camera = saved.camera;
+}
+
 void Renderer::DestroyRenderTarget(TextureHandle* target) {
   if (!target || !target->opaque)
     return;
+  flushSpriteBatch();
   if (s_impl && s_impl->currentRenderTarget == target->opaque)
     UnsetRenderTarget();
   SDL_DestroyTexture((SDL_Texture*)target->opaque);
@@ -592,9 +887,26 @@ TextureHandle Renderer::LoadTexture(const std::string& path) {
   return out;
 }
 
+TextureHandle Renderer::CreateTextureFromPixels(int width, int height, const uint8_t* rgba) {
+  TextureHandle out{};
+  if (!s_impl || !s_impl->renderer || width <= 0 || height <= 0 || !rgba)
+    return out;
+  SDL_Texture* tex = SDL_CreateTexture(s_impl->renderer, SDL_PIXELFORMAT_RGBA32,
+                                       SDL_TEXTUREACCESS_STATIC, width, height);
+  if (!tex)
+    return out;
+  SDL_UpdateTexture(tex, nullptr, rgba, width * 4);
+  SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+  out.opaque = tex;
+  out.width = width;
+  out.height = height;
+  return out;
+}
+
 void Renderer::UnloadTexture(TextureHandle* handle) {
   if (!handle || !handle->opaque)
     return;
+  flushSpriteBatch();
   SDL_DestroyTexture((SDL_Texture*)handle->opaque);
   handle->opaque = nullptr;
   handle->width = 0;
@@ -0,0 +1,192 @@
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace criogenio {
+
+namespace {
+
+bool RectsOverlap(const Rect &a, const Rect &b) {
+  return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height &&
+         a.y + a.height > b.y;
+}
+
+} // namespace
+
+SpatialHashGrid2D::SpatialHashGrid2D(float cellSize) { SetCellSize(cellSize); }
+
+void SpatialHashGrid2D::SetCellSize(float cellSize) {
+  cellSize_ = cellSize > 1.f ? cellSize : 1.f;
+  Clear();
+}
+
+void SpatialHashGrid2D::Clear() {
+  cells_.clear();
+  items_.clear();
+  live_.clear();
+}
+
+int SpatialHashGrid2D::CellCoord(float v) const {
+  return static_cast<int>(std::floor(v / cellSize_));
+}
+
+void SpatialHashGrid2D::LinkCells(ecs::EntityId id, const Item &item) {
+  for (int cy = item.minCy; cy <= item.maxCy; ++cy)
+    for (int cx = item.minCx; cx <= item.maxCx; ++cx)
+      cells_[CellKey(cx, cy)].push_back(id);
+}
+
+void SpatialHashGrid2D::UnlinkCells(ecs::EntityId id, const Item &item) {
+  for (int cy = item.minCy; cy <= item.maxCy; ++cy) {
+    for (int cx = item.minCx; cx <= item.maxCx; ++cx) {
+      auto it = cells_.find(CellKey(cx, cy));
+      if (it == cells_.end())
+        continue;
+      auto &v = it->second;
+      auto pos = std::find(v.begin(), v.end(), id);
+      if (pos != v.end()) {
+        *pos = v.back();
+        v.pop_back();
+      }
+      if (v.empty())
+        cells_.erase(it);
+    }
+  }
+}
+
+void SpatialHashGrid2D::Update(ecs::EntityId id, const Rect &bounds) {
+  if (id == ecs::NULL_ENTITY)
+    return;
+  if (id >= items_.size())
+    items_.resize(static_cast<size_t>(id) + 1);
+  Item &item = items_[id];
+  const int minCx = CellCoord(bounds.x);
+  const int minCy = CellCoord(bounds.y);
+  const int maxCx = CellCoord(bounds.x + std::max(0.f, bounds.width));
+  const int maxCy = CellCoord(bounds.y + std::max(0.f, bounds.height));
+  item.bounds = bounds;
+  item.syncStamp = syncStamp_;
+  if (item.present && item.minCx == minCx && item.minCy == minCy && item.maxCx == maxCx &&
+      item.maxCy == maxCy)
+    return;
+  if (item.present) {
+    UnlinkCells(id, item);
+  } else {
+    item.present = true;
+    item.liveIndex = static_cast<uint32_t>(live_.size());
+    live_.push_back(id);
+  }
+  item.minCx = minCx;
+  item.minCy = minCy;
+  item.maxCx = maxCx;
+  item.maxCy = maxCy;
+  LinkCells(id, item);
+}
+
+void SpatialHashGrid2D::Remove(ecs::EntityId id) {
+  if (!Contains(id))
+    return;
+  Item &item = items_[id];
+  UnlinkCells(id, item);
+  const ecs::EntityId moved = live_.back();
+  live_[item.liveIndex] = moved;
+  items_[moved].liveIndex = item.liveIndex;
+  live_.pop_back();
+  item.present = false;
+}
+
+bool SpatialHashGrid2D::Contains(ecs::EntityId id) const {
+  return id < items_.size() && items_[id].present;
+}
+
+const Rect *SpatialHashGrid2D::GetBounds(ecs::EntityId id) const {
+  return Contains(id) ? &items_[id].bounds : nullptr;
+}
+
+void SpatialHashGrid2D::BeginSync() { ++syncStamp_; }
+
+void SpatialHashGrid2D::EndSync() {
+  for (size_t i = live_.size(); i-- > 0;) {
+    const ecs::EntityId id = live_[i];
+    if (items_[id].syncStamp != syncStamp_)
+      Remove(id);
+  }
+}
+
+void SpatialHashGrid2D::VisitCell(int cx, int cy, const Rect &area,
+                                  std::vector<ecs::EntityId> &out) const {
+  auto it = cells_.find(CellKey(cx, cy));
+  if (it == cells_.end())
+    return;
+  for (ecs::EntityId id : it->second) {
+    const Item &item = items_[id];
+    if (item.queryStamp == queryStamp_)
+      continue;
+    item.queryStamp = queryStamp_;
+    if (RectsOverlap(item.bounds, area))
+      out.push_back(id);
+  }
+}
+
+void SpatialHashGrid2D::QueryRect(const Rect &area, std::vector<ecs::EntityId> &out) const {
+  if (live_.empty())
+    return;
+  ++queryStamp_;
+  const int minCx = CellCoord(area.x);
+  const int minCy = CellCoord(area.y);
+  const int maxCx = CellCoord(area.x + std::max(0.f, area.width));
+  const int maxCy = CellCoord(area.y + std::max(0.f, area.height));
+  const double rangeCells =
+      (static_cast<double>(maxCx) - minCx + 1.0) * (static_cast<double>(maxCy) - minCy + 1.0);
+  if (rangeCells > static_cast<double>(cells_.size()) * 2.0) {
+    // Area much larger than the populated grid (far zoom-out): scan entries instead.
+    for (ecs::EntityId id : live_) {
+      if (RectsOverlap(items_[id].bounds, area))
+        out.push_back(id);
+    }
+    return;
+  }
+  for (int cy = minCy; cy <= maxCy; ++cy)
+    for (int cx = minCx; cx <= maxCx; ++cx)
+      VisitCell(cx, cy, area, out);
+}
+
+float SpatialHashGrid2D::DistanceSqToRect(const Rect &r, float px, float py) {
+  const float dx = std::max({r.x - px, 0.f, px - (r.x + r.width)});
+  const float dy = std::max({r.y - py, 0.f, py - (r.y + r.height)});
+  return dx * dx + dy * dy;
+}
+
+void SpatialHashGrid2D::QueryRadius(float cx, float cy, float radius,
+                                    std::vector<ecs::EntityId> &out) const {
+  if (radius < 0.f)
+    return;
+  const size_t first = out.size();
+  QueryRect({cx - radius, cy - radius, radius * 2.f, radius * 2.f}, out);
+  const float r2 = radius * radius;
+  out.erase(std::remove_if(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+                           [&](ecs::EntityId id) {
+                             return DistanceSqToRect(items_[id].bounds, cx, cy) > r2;
+                           }),
+            out.end());
+}
+
+void SpatialHashGrid2D::QueryNearest(float cx, float cy, float maxRadius, size_t k,
+                                     std::vector<ecs::EntityId> &out) const {
+  if (k == 0)
+    return;
+  std::vector<ecs::EntityId> hits;
+  QueryRadius(cx, cy, maxRadius, hits);
+  std::vector<std::pair<float, ecs::EntityId>> ranked;
+  ranked.reserve(hits.size());
+  for (ecs::EntityId id : hits)
+    ranked.emplace_back(DistanceSqToRect(items_[id].bounds, cx, cy), id);
+  const size_t n = std::min(k, ranked.size());
+  std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(n),
+                    ranked.end());
+  for (size_t i = 0; i < n; ++i)
+    out.push_back(ranked[i].second);
+}
+
+} // namespace criogenio
@@ -29,6 +29,30 @@ void worldToChunkLocal(int worldTx, int worldTy, int chunkSize, int &outCx,
     outLy += chunkSize;
 }
 
+/** Inclusive tile range covering `view` (world pixels, relative to the terrain origin) plus a
+ *  one-tile margin. */
+void tileRangeForView(const Rect &view, float stepX, float stepY, int &minTx, int &minTy,
+                      int &maxTx, int &maxTy) {
+  minTx = static_cast<int>(std::floor(view.x / stepX)) - 1;
+  minTy = static_cast<int>(std::floor(view.y / stepY)) - 1;
+  maxTx = static_cast<int>(std::floor((view.x + view.width) / stepX)) + 1;
+  maxTy = static_cast<int>(std::floor((view.y + view.height) / stepY)) + 1;
+}
+
+/** Floor division for chunk coordinates of (possibly negative) tile coordinates. */
+int tileToChunk(int t, int chunkSize) {
+  return t >= 0 ? t / chunkSize : (t - chunkSize + 1) / chunkSize;
+}
+
+Color layerTint(float alpha) {
+  Color tint = Colors::White;
+  if (alpha < 1.0f) {
+    if (alpha < 0.0f) alpha = 0.0f;
+    tint.a = static_cast<uint8_t>(alpha * 255.0f);
+  }
+  return tint;
+}
+
 void renderTmxImageLayer(Renderer &renderer, const TiledImageLayerMeta &im, Vec2 terrainOrigin) {
   if (!im.visible || !im.image || !im.image->texture.valid())
     return;
@@ -90,6 +114,7 @@ void ComputeMovementBoundsPx(const Terrain2D *terrain, float entityW, float enti
 }
 
 void Terrain2D::SetAtlas(int layer, const char *path) {
+  chunkBakes_.Clear();
   tileset.atlas =
       AssetManager::instance().load<criogenio::TextureResource>(path);
   tileset.tilesetPath = path;
@@ -99,13 +124,12 @@ void Terrain2D::SetChunkSize(int size) {
   if (size < 1)
     size = 1;
   chunkSize_ = size;
+  chunkBakes_.Clear();
 }
 
 void Terrain2D::GetVisibleTileRange(const Camera2D &camera, float viewWidth,
                                     float viewHeight, int &minTx, int &minTy,
                                     int &maxTx, int &maxTy) const {
-  float tsx = static_cast<float>(GridStepX());
-  float tsy = static_cast<float>(GridStepY());
   Vec2 worldMin = ScreenToWorld2D({0, 0}, camera, viewWidth, viewHeight);
   Vec2 worldMax =
       ScreenToWorld2D({viewWidth, viewHeight}, camera, viewWidth, viewHeight);
@@ -113,110 +137,287 @@ void Terrain2D::GetVisibleTileRange(const Camera2D &camera, float viewWidth,
   float minWy = std::min(worldMin.y, worldMax.y) - origin.y;
   float maxWx = std::max(worldMin.x, worldMax.x) - origin.x;
   float maxWy = std::max(worldMin.y, worldMax.y) - origin.y;
-  minTx = static_cast<int>(std::floor(minWx / tsx)) - 1;
-  minTy = static_cast<int>(std::floor(minWy / tsy)) - 1;
-  maxTx = static_cast<int>(std::floor(maxWx / tsx)) + 1;
-  maxTy = static_cast<int>(std::floor(maxWy / tsy)) + 1;
+  tileRangeForView({minWx, minWy, maxWx - minWx, maxWy - minWy},
+                   static_cast<float>(GridStepX()), static_cast<float>(GridStepY()), minTx, minTy,
+                   maxTx, maxTy);
 }
 
-void Terrain2D::RenderChunkedLayerGid(Renderer &renderer,
-                                      const ChunkedLayer &layer,
-                                      float alpha) const {
-  const int stepX = GridStepX();
-  const int stepY = GridStepY();
-  Color tint = Colors::White;
-  if (alpha < 1.0f) {
-    if (alpha < 0.0f) alpha = 0.0f;
-    tint.a = static_cast<uint8_t>(alpha * 255.0f);
+bool Terrain2D::VisibleChunkCells(const Renderer &renderer, int stepX, int stepY,
+                                  ChunkCellRange &out) const {
+  Rect view;
+  if (!renderer.GetCameraWorldBounds(view) || stepX <= 0 || stepY <= 0 || chunkSize_ <= 0)
+    return false;
+  view.x -= origin.x;
+  view.y -= origin.y;
+  tileRangeForView(view, static_cast<float>(stepX), static_cast<float>(stepY), out.minTx,
+                   out.minTy, out.maxTx, out.maxTy);
+  out.minCx = tileToChunk(out.minTx, chunkSize_);
+  out.minCy = tileToChunk(out.minTy, chunkSize_);
+  out.maxCx = tileToChunk(out.maxTx, chunkSize_);
+  out.maxCy = tileToChunk(out.maxTy, chunkSize_);
+  return true;
+}
+
+template <typename ChunkFn>
+void Terrain2D::ForEachVisibleChunk(const Renderer &renderer, const ChunkedLayer &layer,
+                                    int stepX, int stepY, ChunkFn &&fn) const {
+  const int n = chunkSize_ * chunkSize_;
+  ChunkCellRange r;
+  if (!VisibleChunkCells(renderer, stepX, stepY, r)) {
+    // No camera: draw everything (screen-space callers, thumbnails).
+    for (const auto &[key, tiles] : layer.chunks) {
+      if (static_cast<int>(tiles.size()) == n)
+        fn(key.first, key.second, tiles, 0, 0, chunkSize_ - 1, chunkSize_ - 1);
+    }
+    return;
+  }
+  auto visit = [&](int cx, int cy, const std::vector<int> &tiles) {
+    if (static_cast<int>(tiles.size()) != n)
+      return;
+    // Clip edge chunks to the visible cells.
+    const int baseTx = cx * chunkSize_;
+    const int baseTy = cy * chunkSize_;
+    const int lx0 = std::max(0, r.minTx - baseTx);
+    const int ly0 = std::max(0, r.minTy - baseTy);
+    const int lx1 = std::min(chunkSize_ - 1, r.maxTx - baseTx);
+    const int ly1 = std::min(chunkSize_ - 1, r.maxTy - baseTy);
+    if (lx0 > lx1 || ly0 > ly1)
+      return;
+    fn(cx, cy, tiles, lx0, ly0, lx1, ly1);
+  };
+  const long long viewChunks = (static_cast<long long>(r.maxCx) - r.minCx + 1) *
+                               (static_cast<long long>(r.maxCy) - r.minCy + 1);
+  if (viewChunks <= static_cast<long long>(layer.chunks.size())) {
+    // Direct lookup of the chunks under the view: cost scales with screen size.
+    for (int cy = r.minCy; cy <= r.maxCy; ++cy) {
+      for (int cx = r.minCx; cx <= r.maxCx; ++cx) {
+        auto it = layer.chunks.find(ChunkKey{cx, cy});
+        if (it != layer.chunks.end())
+          visit(cx, cy, it->second);
+      }
+    }
+    return;
   }
+  // Sparse layer (fewer chunks than the view spans, e.g. zoomed far out): walk the map.
   for (const auto &[key, tiles] : layer.chunks) {
-    int cx = key.first;
-    int cy = key.second;
-    if (static_cast<int>(tiles.size()) != chunkSize_ * chunkSize_)
+    if (key.first < r.minCx || key.first > r.maxCx || key.second < r.minCy ||
+        key.second > r.maxCy)
       continue;
-    for (int ly = 0; ly < chunkSize_; ly++) {
-      for (int lx = 0; lx < chunkSize_; lx++) {
-        int stored = tiles[ly * chunkSize_ + lx];
-        // 0 = empty cell (still 0 with no flip bits). A non-zero stored value
-        // may be negative (H-flip sets bit 31); decode the base gid via TileGid.
-        if (stored == 0)
-          continue;
-        const uint32_t gid = TileGid(stored);
-        if (gid == 0)
-          continue;
-        const TmxTilesetEntry *ts = FindTmxTileset(gid);
-        if (!ts || !ts->sheet.atlas)
-          continue;
-        int local = static_cast<int>(gid) - ts->firstGid;
-        if (local < 0)
-          continue;
-        int tw = ts->tilePixelW;
-        int th = ts->tilePixelH;
-        int col = local % ts->sheet.columns;
-        int row = local / ts->sheet.columns;
-        int m = ts->margin;
-        int sp = ts->spacing;
-        float sx = static_cast<float>(m + col * (tw + sp));
-        float sy = static_cast<float>(m + row * (th + sp));
-        Rect sourceRect = {sx, sy, static_cast<float>(tw), static_cast<float>(th)};
-        float worldX = static_cast<float>((cx * chunkSize_ + lx) * stepX);
-        float worldY = static_cast<float>((cy * chunkSize_ + ly) * stepY);
-        Rect destRect = {origin.x + worldX, origin.y + worldY,
-                         static_cast<float>(stepX), static_cast<float>(stepY)};
-        const bool fH = TileFlipH(stored);
-        const bool fV = TileFlipV(stored);
-        // TODO: support diagonal flip (bit 29). Tiled defines it as
-        // rotate-90-CW followed by H-flip-of-result; SDL3's flip-then-rotate
-        // order requires a small case table to emulate. H+V flips cover the
-        // common case (mirror tiles for symmetric maps).
-        if (fH || fV) {
-          renderer.DrawTextureProFlipped(ts->sheet.atlas->texture, sourceRect,
-                                         destRect, {0.f, 0.f}, 0.f, tint, fH, fV);
-        } else {
-          renderer.DrawTexturePro(ts->sheet.atlas->texture, sourceRect, destRect,
-                                  {0.f, 0.f}, 0.f, tint);
-        }
+    visit(key.first, key.second, tiles);
+  }
+}
+
+void Terrain2D::DrawChunkCellsGid(Renderer &renderer, const std::vector<int> &tiles, int lx0,
+                                  int ly0, int lx1, int ly1, float baseX, float baseY,
+                                  Color tint) const {
+  const int stepX = GridStepX();
+  const int stepY = GridStepY();
+  for (int ly = ly0; ly <= ly1; ly++) {
+    for (int lx = lx0; lx <= lx1; lx++) {
+      int stored = tiles[ly * chunkSize_ + lx];
+      // 0 = empty cell (still 0 with no flip bits). A non-zero stored value
+      // may be negative (H-flip sets bit 31); decode the base gid via TileGid.
+      if (stored == 0)
+        continue;
+      const TmxGidEntry *g = LookupTmxGid(TileGid(stored));
+      if (!g || !g->atlas)
+        continue;
+      Rect destRect = {baseX + static_cast<float>(lx * stepX),
+                       baseY + static_cast<float>(ly * stepY), static_cast<float>(stepX),
+                       static_cast<float>(stepY)};
+      const bool fH = TileFlipH(stored);
+      const bool fV = TileFlipV(stored);
+      // TODO: support diagonal flip (bit 29). Tiled defines it as
+      // rotate-90-CW followed by H-flip-of-result; SDL3's flip-then-rotate
+      // order requires a small case table to emulate. H+V flips cover the
+      // common case (mirror tiles for symmetric maps).
+      if (fH || fV) {
+        renderer.DrawTextureProFlipped(g->atlas->texture, g->source, destRect, {0.f, 0.f},
+                                       0.f, tint, fH, fV);
+      } else {
+        renderer.DrawTexturePro(g->atlas->texture, g->source, destRect, {0.f, 0.f}, 0.f,
+                                tint);
       }
     }
   }
 }
 
-void Terrain2D::RenderChunkedLayerTileIndex(Renderer &renderer,
-                                            const ChunkedLayer &layer,
-                                            float alpha) const {
+void Terrain2D::DrawChunkCellsTileIndex(Renderer &renderer, const std::vector<int> &tiles,
+                                        int lx0, int ly0, int lx1, int ly1, float baseX,
+                                        float baseY, Color tint) const {
+  const int ts = tileset.tileSize;
+  for (int ly = ly0; ly <= ly1; ly++) {
+    for (int lx = lx0; lx <= lx1; lx++) {
+      int tileIndex = tiles[ly * chunkSize_ + lx];
+      if (tileIndex < 0)
+        continue;
+      int tileX = (tileIndex % tileset.columns) * ts;
+      int tileY = (tileIndex / tileset.columns) * ts;
+      Rect sourceRect = {static_cast<float>(tileX), static_cast<float>(tileY),
+                         static_cast<float>(ts), static_cast<float>(ts)};
+      Vec2 position = {baseX + static_cast<float>(lx * ts), baseY + static_cast<float>(ly * ts)};
+      renderer.DrawTextureRec(tileset.atlas->texture, sourceRect, position, tint);
+    }
+  }
+}
+
+void Terrain2D::RenderChunkedLayerGid(Renderer &renderer, int layerIndex, float alpha) {
+  const int stepX = GridStepX();
+  const int stepY = GridStepY();
+  const Color tint = layerTint(alpha);
+  const ChunkedLayer &layer = layers[static_cast<size_t>(layerIndex)];
+  ForEachVisibleChunk(renderer, layer, stepX, stepY,
+                      [&](int cx, int cy, const std::vector<int> &tiles, int lx0, int ly0,
+                          int lx1, int ly1) {
+    if (chunkBakingThisFrame_ && DrawBakedChunk(renderer, layerIndex, cx, cy, tiles, tint))
+      return;
+    DrawChunkCellsGid(renderer, tiles, lx0, ly0, lx1, ly1,
+                      origin.x + static_cast<float>(cx * chunkSize_ * stepX),
+                      origin.y + static_cast<float>(cy * chunkSize_ * stepY), tint);
+  });
+}
+
+void Terrain2D::RenderChunkedLayerTileIndex(Renderer &renderer, int layerIndex, float alpha) {
   if (!tileset.atlas)
     return;
-  Color tint = Colors::White;
-  if (alpha < 1.0f) {
-    if (alpha < 0.0f) alpha = 0.0f;
-    tint.a = static_cast<uint8_t>(alpha * 255.0f);
-  }
+  const Color tint = layerTint(alpha);
   const int ts = tileset.tileSize;
-  for (const auto &[key, tiles] : layer.chunks) {
-    int cx = key.first;
-    int cy = key.second;
-    int n = chunkSize_ * chunkSize_;
-    if (static_cast<int>(tiles.size()) != n)
-      continue;
-    for (int ly = 0; ly < chunkSize_; ly++) {
-      for (int lx = 0; lx < chunkSize_; lx++) {
-        int tileIndex = tiles[ly * chunkSize_ + lx];
-        if (tileIndex < 0)
-          continue;
-        int worldX = (cx * chunkSize_ + lx) * ts;
-        int worldY = (cy * chunkSize_ + ly) * ts;
-        int tileX = (tileIndex % tileset.columns) * ts;
-        int tileY = (tileIndex / tileset.columns) * ts;
-        Rect sourceRect = {static_cast<float>(tileX),
-                           static_cast<float>(tileY),
-                           static_cast<float>(ts), static_cast<float>(ts)};
-        Vec2 position = {origin.x + static_cast<float>(worldX),
-                         origin.y + static_cast<float>(worldY)};
-        renderer.DrawTextureRec(tileset.atlas->texture, sourceRect, position,
-                                tint);
+  const ChunkedLayer &layer = layers[static_cast<size_t>(layerIndex)];
+  ForEachVisibleChunk(renderer, layer, ts, ts,
+                      [&](int cx, int cy, const std::vector<int> &tiles, int lx0, int ly0,
+                          int lx1, int ly1) {
+    if (chunkBakingThisFrame_ && DrawBakedChunk(renderer, layerIndex, cx, cy, tiles, tint))
+      return;
+    DrawChunkCellsTileIndex(renderer, tiles, lx0, ly0, lx1, ly1,
+                            origin.x + static_cast<float>(cx * chunkSize_ * ts),
+                            origin.y + static_cast<float>(cy * chunkSize_ * ts), tint);
+  });
+}
+
+void TerrainChunkBakeCache::Release(Entry &e) {
+  // Textures die with the SDL renderer; only destroy them while it is alive.
+  if (e.target.valid() && renderer && renderer->GetRendererHandle())
+    renderer->DestroyRenderTarget(&e.target);
+  e.target = TextureHandle{};
+}
+
+void TerrainChunkBakeCache::Clear() {
+  for (auto &[ref, e] : entries)
+    Release(e);
+  entries.clear();
+}
+
+void Terrain2D::SetChunkBakeBudget(size_t maxChunks) {
+  chunkBakeBudget_ = maxChunks;
+  while (chunkBakes_.entries.size() > chunkBakeBudget_ && EvictChunkBakeForInsert()) {
+  }
+  if (chunkBakeBudget_ == 0)
+    chunkBakes_.Clear();
+}
+
+Terrain2D::ChunkBakeStats Terrain2D::GetChunkBakeStats() const {
+  ChunkBakeStats s;
+  s.cached = chunkBakes_.entries.size();
+  s.bakes = chunkBakes_.bakes;
+  s.evictions = chunkBakes_.evictions;
+  return s;
+}
+
+bool Terrain2D::BeginChunkBakeFrame(Renderer &renderer) {
+  TerrainChunkBakeCache &c = chunkBakes_;
+  if (c.renderer && c.renderer->GetRendererHandle() != renderer.GetRendererHandle())
+    c.Clear();
+  c.renderer = &renderer;
+  ++c.frame;
+  c.bakesThisFrame = 0;
+  const uint64_t generation = AssetManager::instance().generation();
+  if (c.assetGeneration != generation || c.layerCount != layers.size() ||
+      c.chunkSize != chunkSize_ || c.stepX != GridStepX() || c.stepY != GridStepY() ||
+      c.gidMode != gidMode_) {
+    c.Clear();
+    c.assetGeneration = generation;
+    c.layerCount = layers.size();
+    c.chunkSize = chunkSize_;
+    c.stepX = GridStepX();
+    c.stepY = GridStepY();
+    c.gidMode = gidMode_;
+  }
+  if (chunkBakeBudget_ == 0 || renderer.IsRenderTargetActive())
+    return false;
+  Rect view;
+  return renderer.GetCameraWorldBounds(view);
+}
+
+bool Terrain2D::EvictChunkBakeForInsert() {
+  TerrainChunkBakeCache &c = chunkBakes_;
+  auto victim = c.entries.end();
+  for (auto it = c.entries.begin(); it != c.entries.end(); ++it) {
+    if (it->second.lastUsedFrame == c.frame)
+      continue; // on screen this frame
+    if (victim == c.entries.end() || it->second.lastUsedFrame < victim->second.lastUsedFrame)
+      victim = it;
+  }
+  if (victim == c.entries.end())
+    return false;
+  c.Release(victim->second);
+  c.entries.erase(victim);
+  ++c.evictions;
+  return true;
+}
+
+bool Terrain2D::DrawBakedChunk(Renderer &renderer, int layerIndex, int cx, int cy,
+                               const std::vector<int> &tiles, Color tint) {
+  TerrainChunkBakeCache &c = chunkBakes_;
+  const int stepX = GridStepX();
+  const int stepY = GridStepY();
+  const int texW = chunkSize_ * stepX;
+  const int texH = chunkSize_ * stepY;
+  const TerrainChunkRef ref{layerIndex, ChunkKey{cx, cy}};
+  auto it = c.entries.find(ref);
+  if (it == c.entries.end() || it->second.dirty) {
+    if (c.bakesThisFrame >= kMaxChunkBakesPerFrame)
+      return false;
+    if (it == c.entries.end()) {
+      if (c.entries.size() >= chunkBakeBudget_ && !EvictChunkBakeForInsert())
+        return false;
+      it = c.entries.emplace(ref, TerrainChunkBakeCache::Entry{}).first;
+    }
+    TerrainChunkBakeCache::Entry &e = it->second;
+    e.empty = std::all_of(tiles.begin(), tiles.end(),
+                          [&](int v) { return gidMode_ ? TileGid(v) == 0 : v < 0; });
+    if (!e.empty) {
+      ++c.bakesThisFrame; // failed target creation counts too, so it is not retried per chunk
+      if (!e.target.valid())
+        e.target = renderer.CreateRenderTarget(texW, texH);
+      if (!e.target.valid()) {
+        c.entries.erase(it);
+        return false;
       }
+      renderer.PushRenderTarget(e.target);
+      if (gidMode_)
+        DrawChunkCellsGid(renderer, tiles, 0, 0, chunkSize_ - 1, chunkSize_ - 1, 0.f, 0.f,
+                          Colors::White);
+      else
+        DrawChunkCellsTileIndex(renderer, tiles, 0, 0, chunkSize_ - 1, chunkSize_ - 1, 0.f,
+                                0.f, Colors::White);
+      renderer.PopRenderTarget();
+      ++c.bakes;
     }
+    e.dirty = false;
   }
+  TerrainChunkBakeCache::Entry &e = it->second;
+  e.lastUsedFrame = c.frame;
+  if (e.empty)
+    return true;
+  // The bake blended onto transparent black, so its colour is premultiplied by alpha; scale
+  // colour with the layer opacity to match.
+  const Color quadTint{tint.a, tint.a, tint.a, tint.a};
+  const Rect src{0.f, 0.f, static_cast<float>(texW), static_cast<float>(texH)};
+  const Rect dst{origin.x + static_cast<float>(cx * texW), origin.y + static_cast<float>(cy * texH),
+                 static_cast<float>(texW), static_cast<float>(texH)};
+  renderer.DrawTexturePro(e.target, src, dst, {0.f, 0.f}, 0.f, quadTint,
+                          TextureBlendMode::Premultiplied);
+  return true;
 }
 
 void Terrain2D::Render(Renderer &renderer) {
@@ -228,6 +429,17 @@ void Terrain2D::Render(Renderer &renderer) {
   auto layerAlpha = [this](size_t i) -> float {
     return i >= tmxMeta.layerInfo.size() ? 1.0f : tmxMeta.layerInfo[i].opacity;
   };
+  if (gidMode_ && tmxGidLookupFingerprint_ != TmxTilesetsFingerprint()) {
+    RebuildTmxGidLookup();
+    chunkBakes_.Clear();
+  }
+  chunkBakingThisFrame_ = BeginChunkBakeFrame(renderer);
+  // All tile and chunk quads go through one sprite batch (runs split per atlas).
+  struct BatchScope {
+    Renderer &r;
+    ~BatchScope() { r.EndSpriteBatch(); }
+  } batchScope{renderer};
+  renderer.BeginSpriteBatch();
 
   if (gidMode_) {
     if (!tmxMeta.drawLayerOrder.empty()) {
@@ -236,7 +448,7 @@ void Terrain2D::Render(Renderer &renderer) {
           if (step.index >= 0 && step.index < static_cast<int>(layers.size())) {
             const size_t li = static_cast<size_t>(step.index);
             if (!layerVisible(li)) continue;
-            RenderChunkedLayerGid(renderer, layers[li], layerAlpha(li));
+            RenderChunkedLayerGid(renderer, static_cast<int>(li), layerAlpha(li));
           }
         } else {
           if (step.index >= 0 &&
@@ -252,7 +464,7 @@ void Terrain2D::Render(Renderer &renderer) {
     if (!sortLayers) {
       for (size_t i = 0; i < layers.size(); ++i) {
         if (!layerVisible(i)) continue;
-        RenderChunkedLayerGid(renderer, layers[i], layerAlpha(i));
+        RenderChunkedLayerGid(renderer, static_cast<int>(i), layerAlpha(i));
       }
     } else {
       std::vector<size_t> order(layers.size());
@@ -267,7 +479,7 @@ void Terrain2D::Render(Renderer &renderer) {
                        });
       for (size_t idx : order) {
         if (!layerVisible(idx)) continue;
-        RenderChunkedLayerGid(renderer, layers[idx], layerAlpha(idx));
+        RenderChunkedLayerGid(renderer, static_cast<int>(idx), layerAlpha(idx));
       }
     }
     return;
@@ -281,7 +493,7 @@ void Terrain2D::Render(Renderer &renderer) {
   if (!sortLayers) {
     for (size_t i = 0; i < layers.size(); ++i) {
       if (!layerVisible(i)) continue;
-      RenderChunkedLayerTileIndex(renderer, layers[i], layerAlpha(i));
+      RenderChunkedLayerTileIndex(renderer, static_cast<int>(i), layerAlpha(i));
     }
   } else {
     std::vector<size_t> order(layers.size());
@@ -296,7 +508,7 @@ void Terrain2D::Render(Renderer &renderer) {
                      });
     for (size_t idx : order) {
       if (!layerVisible(idx)) continue;
-      RenderChunkedLayerTileIndex(renderer, layers[idx], layerAlpha(idx));
+      RenderChunkedLayerTileIndex(renderer, static_cast<int>(idx), layerAlpha(idx));
     }
   }
 }
@@ -336,9 +548,68 @@ Terrain2D &Terrain2D::SetTile(int layerIndex, int worldTx, int worldTy,
     tiles.assign(chunkSize_ * chunkSize_, emptyFill);
   }
   tiles[ly * chunkSize_ + lx] = tileId;
+  if (trackChunkChanges_)
+    MarkChunkChanged(layerIndex, key);
+  MarkChunkBakeDirty(layerIndex, key);
   return *this;
 }
 
+void Terrain2D::MarkChunkBakeDirty(int layerIndex, ChunkKey key) {
+  auto it = chunkBakes_.entries.find(TerrainChunkRef{layerIndex, key});
+  if (it != chunkBakes_.entries.end())
+    it->second.dirty = true;
+}
+
+void Terrain2D::MarkLayerBakesDirty(int layerIndex) {
+  for (auto &[ref, e] : chunkBakes_.entries) {
+    if (ref.layer == layerIndex)
+      e.dirty = true;
+  }
+}
+
+void Terrain2D::MarkChunkChanged(int layerIndex, ChunkKey key) {
+  const TerrainChunkRef ref{layerIndex, key};
+  dirtyChunks_.insert(ref);
+  editedChunks_.insert(ref);
+}
+
+void Terrain2D::SetChunkChangeTracking(bool enabled) {
+  trackChunkChanges_ = enabled;
+  dirtyChunks_.clear();
+  editedChunks_.clear();
+}
+
+bool Terrain2D::ConsumeDirtyChunks(std::vector<TerrainChunkRef> &out) {
+  out.clear();
+  if (dirtyChunks_.empty())
+    return false;
+  out.assign(dirtyChunks_.begin(), dirtyChunks_.end());
+  dirtyChunks_.clear();
+  return true;
+}
+
+const std::vector<int> *Terrain2D::FindChunkTiles(int layerIndex, ChunkKey key) const {
+  if (layerIndex < 0 || layerIndex >= static_cast<int>(layers.size()))
+    return nullptr;
+  const auto &chunks = layers[static_cast<size_t>(layerIndex)].chunks;
+  auto it = chunks.find(key);
+  return it == chunks.end() ? nullptr : &it->second;
+}
+
+void Terrain2D::ApplyChunkTiles(int layerIndex, ChunkKey key, std::vector<int> tiles) {
+  if (layerIndex < 0 || layerIndex >= static_cast<int>(layers.size()))
+    return;
+  auto &chunks = layers[static_cast<size_t>(layerIndex)].chunks;
+  if (!tiles.empty() && static_cast<int>(tiles.size()) != chunkSize_ * chunkSize_)
+    return;
+  MarkChunkBakeDirty(layerIndex, key);
+  if (tiles.empty()) {
+    chunks.erase(key);
+    return;
+  }
+  chunks[key] = std::move(tiles);
+}
+
 bool Terrain2D::CellHasTile(int layerIndex, int worldTx, int worldTy) const {
   int v = GetTile(layerIndex, worldTx, worldTy);
   if (gidMode_) {
@@ -404,6 +675,7 @@ bool tiledLayerFeedsCollisionMask(const TiledLayerMeta &meta) {
 
 void Terrain2D::RebuildCollisionMaskFromTmxRules() {
   TmxMapMetadata &meta = tmxMeta;
+  ++meta.collisionRevision;
   meta.collisionSolid.clear();
   meta.collisionStrideTiles = 0;
   meta.collisionHeightTiles = 0;
@@ -519,10 +791,13 @@ void Terrain2D::InferTmxContentBoundsFromTiles() {
 }
 
 void Terrain2D::ClearTmxState() {
+  chunkBakes_.Clear();
   gidMode_ = false;
   mapTilePxW_ = mapTilePxH_ = 0;
   logicalMapTilesW_ = logicalMapTilesH_ = 0;
   tmxTilesets.clear();
+  tmxGidLookup_.clear();
+  tmxGidLookupFingerprint_ = 0;
   tmxMeta.clear();
 }
 
@@ -540,16 +815,64 @@ void Terrain2D::BeginTmxMode(int mapTileW, int mapTileH,
   tmxTilesets = std::move(entries);
   if (!tmxTilesets.empty())
     tileset = tmxTilesets[0].sheet;
+  RebuildTmxGidLookup();
 }
 
-const TmxTilesetEntry *Terrain2D::FindTmxTileset(uint32_t gid) const {
-  if (gid == 0)
-    return nullptr;
-  for (int i = static_cast<int>(tmxTilesets.size()) - 1; i >= 0; --i) {
-    if (gid >= static_cast<uint32_t>(tmxTilesets[static_cast<size_t>(i)].firstGid))
-      return &tmxTilesets[static_cast<size_t>(i)];
+uint64_t Terrain2D::TmxTilesetsFingerprint() const {
+  // FNV-1a over the fields the lookup table is derived from.
+  uint64_t h = 1469598103934665603ull;
+  auto mix = [&h](uint64_t v) {
+    h ^= v;
+    h *= 1099511628211ull;
+  };
+  mix(tmxTilesets.size());
+  for (const TmxTilesetEntry &ts : tmxTilesets) {
+    mix(static_cast<uint64_t>(ts.firstGid));
+    mix(static_cast<uint64_t>(ts.sheet.columns));
+    mix(static_cast<uint64_t>(ts.sheet.rows));
+    mix(static_cast<uint64_t>(ts.tilePixelW) << 32 | static_cast<uint32_t>(ts.tilePixelH));
+    mix(static_cast<uint64_t>(ts.margin) << 32 | static_cast<uint32_t>(ts.spacing));
+    mix(reinterpret_cast<uintptr_t>(ts.sheet.atlas.get()));
+    if (ts.sheet.atlas)
+      mix(static_cast<uint64_t>(ts.sheet.atlas->texture.width) << 32 |
+          static_cast<uint32_t>(ts.sheet.atlas->texture.height));
+  }
+  return h;
+}
+
+void Terrain2D::RebuildTmxGidLookup() {
+  tmxGidLookup_.clear();
+  tmxGidLookupFingerprint_ = TmxTilesetsFingerprint();
+  // Entries are sorted by firstGid. A tileset owns GIDs up to the next one's firstGid (matching
+  // the old reverse scan); the last owns as many as its declared grid or atlas can hold.
+  for (size_t i = 0; i < tmxTilesets.size(); ++i) {
+    const TmxTilesetEntry &ts = tmxTilesets[i];
+    const int cols = ts.sheet.columns;
+    if (cols <= 0 || ts.firstGid <= 0 || ts.tilePixelW <= 0 || ts.tilePixelH <= 0)
+      continue;
+    long long count = static_cast<long long>(cols) * std::max(1, ts.sheet.rows);
+    if (ts.sheet.atlas && ts.sheet.atlas->texture.height > 0) {
+      const int atlasRows = (ts.sheet.atlas->texture.height - ts.margin + ts.spacing) /
+                            (ts.tilePixelH + ts.spacing);
+      count = std::max(count, static_cast<long long>(cols) * atlasRows);
+    }
+    if (i + 1 < tmxTilesets.size() && tmxTilesets[i + 1].firstGid > ts.firstGid)
+      count = tmxTilesets[i + 1].firstGid - ts.firstGid;
+    const size_t end = static_cast<size_t>(ts.firstGid + count);
+    if (tmxGidLookup_.size() < end)
+      tmxGidLookup_.resize(end);
+    for (int local = 0; local < count; ++local) {
+      TmxGidEntry &e = tmxGidLookup_[static_cast<size_t>(ts.firstGid + local)];
+      e.atlas = ts.sheet.atlas.get();
+      e.tilesetIndex = static_cast<int>(i);
+      e.localId = local;
+      const int col = local % cols;
+      const int row = local / cols;
+      e.source = {static_cast<float>(ts.margin + col * (ts.tilePixelW + ts.spacing)),
+                  static_cast<float>(ts.margin + row * (ts.tilePixelH + ts.spacing)),
+                  static_cast<float>(ts.tilePixelW), static_cast<float>(ts.tilePixelH)};
+    }
   }
-  return nullptr;
 }
 
 void Terrain2D::FillLayer(int layerIndex, int tileId) {
@@ -557,7 +880,10 @@ void Terrain2D::FillLayer(int layerIndex, int tileId) {
     return;
   for (auto &[key, tiles] : layers[layerIndex].chunks) {
     std::fill(tiles.begin(), tiles.end(), tileId);
+    if (trackChunkChanges_)
+      MarkChunkChanged(layerIndex, key);
   }
+  MarkLayerBakesDirty(layerIndex);
 }
 
 void Terrain2D::AddLayer() {
@@ -571,6 +897,7 @@ void Terrain2D::RemoveLayer(int layerIndex) {
   if (layerIndex < 0 || layerIndex >= static_cast<int>(layers.size()))
     return;
   layers.erase(layers.begin() + layerIndex);
+  chunkBakes_.Clear(); // later layers shift down an index
   if (layerIndex < static_cast<int>(tmxMeta.layerInfo.size()))
     tmxMeta.layerInfo.erase(tmxMeta.layerInfo.begin() + layerIndex);
 }
@@ -578,11 +905,17 @@ void Terrain2D::RemoveLayer(int layerIndex) {
 void Terrain2D::ClearLayer(int layerIndex) {
   if (layerIndex < 0 || layerIndex >= static_cast<int>(layers.size()))
     return;
+  if (trackChunkChanges_) {
+    for (const auto &[key, tiles] : layers[layerIndex].chunks)
+      MarkChunkChanged(layerIndex, key);
+  }
   layers[layerIndex].chunks.clear();
+  MarkLayerBakesDirty(layerIndex);
 }
 
 void Terrain2D::ClearAllLayers() {
   layers.clear();
+  chunkBakes_.Clear();
 }
 
 void Terrain2D::MoveLayer(int from, int to) {
@@ -592,6 +925,7 @@ void Terrain2D::MoveLayer(int from, int to) {
   if (to < 0) to = 0;
   if (to >= n) to = n - 1;
   if (from == to) return;
+  chunkBakes_.Clear(); // bakes are keyed by layer index
   // Move the chunked layer.
   ChunkedLayer moved = std::move(layers[from]);
   layers.erase(layers.begin() + from);
@@ -611,6 +945,7 @@ void Terrain2D::DuplicateLayer(int index) {
   if (index < 0 || index >= n) return;
   ChunkedLayer copy = layers[index]; // deep copy via map<vector<int>>
   layers.insert(layers.begin() + index + 1, std::move(copy));
+  chunkBakes_.Clear();
   if (index < static_cast<int>(tmxMeta.layerInfo.size())) {
     TiledLayerMeta lm = tmxMeta.layerInfo[index];
     lm.name += " (copy)";
@@ -618,10 +953,14 @@ void Terrain2D::DuplicateLayer(int index) {
   }
 }
 
-void Terrain2D::SetTileset(const Tileset &newTileset) { tileset = newTileset; }
+void Terrain2D::SetTileset(const Tileset &newTileset) {
+  tileset = newTileset;
+  chunkBakes_.Clear();
+}
 
 void Terrain2D::SetTileSize(int newTileSize) {
   tileset.tileSize = newTileSize;
+  chunkBakes_.Clear();
 }
 
 SerializedTerrain2D Terrain2D::Serialize() const {
@@ -0,0 +1,224 @@
+#include "texture_atlas.h"
+#include "asset_manager.h"
+#include "render.h"
+#include "resources.h"
+#include <algorithm>
+#include <climits>
+
+namespace criogenio {
+
+SkylinePacker::SkylinePacker(int width, int height) { Reset(width, height); }
+
+void SkylinePacker::Reset(int width, int height) {
+  width_ = std::max(0, width);
+  height_ = std::max(0, height);
+  usedArea_ = 0;
+  skyline_.clear();
+  if (width_ > 0)
+    skyline_.push_back(Segment{0, 0, width_});
+}
+
+bool SkylinePacker::Fit(size_t index, int w, int h, int &outY) const {
+  const int x = skyline_[index].x;
+  if (x + w > width_)
+    return false;
+  int y = skyline_[index].y;
+  int remaining = w;
+  for (size_t j = index; remaining > 0; ++j) {
+    if (j >= skyline_.size())
+      return false;
+    y = std::max(y, skyline_[j].y);
+    if (y + h > height_)
+      return false;
+    remaining -= skyline_[j].width;
+  }
+  outY = y;
+  return true;
+}
+
+bool SkylinePacker::Insert(int w, int h, int &outX, int &outY) {
+  if (w <= 0 || h <= 0)
+    return false;
+  size_t bestIndex = skyline_.size();
+  int bestY = 0;
+  int bestTop = INT_MAX;
+  int bestWidth = INT_MAX;
+  for (size_t i = 0; i < skyline_.size(); ++i) {
+    int y = 0;
+    if (!Fit(i, w, h, y))
+      continue;
+    const int top = y + h;
+    if (top < bestTop || (top == bestTop && skyline_[i].width < bestWidth)) {
+      bestIndex = i;
+      bestY = y;
+      bestTop = top;
+      bestWidth = skyline_[i].width;
+    }
+  }
+  if (bestIndex == skyline_.size())
+    return false;
+
+  outX = skyline_[bestIndex].x;
+  outY = bestY;
+  skyline_.insert(skyline_.begin() + static_cast<std::ptrdiff_t>(bestIndex),
+                  Segment{outX, bestY + h, w});
+  // Trim the segments now shadowed by the new one.
+  for (size_t i = bestIndex + 1; i < skyline_.size();) {
+    const Segment &prev = skyline_[i - 1];
+    Segment &cur = skyline_[i];
+    const int prevEnd = prev.x + prev.width;
+    if (cur.x >= prevEnd)
+      break;
+    const int shrink = prevEnd - cur.x;
+    if (cur.width <= shrink) {
+      skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i));
+      continue;
+    }
+    cur.x += shrink;
+    cur.width -= shrink;
+    break;
+  }
+  for (size_t i = 0; i + 1 < skyline_.size();) {
+    if (skyline_[i].y == skyline_[i + 1].y) {
+      skyline_[i].width += skyline_[i + 1].width;
+      skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i + 1));
+    } else {
+      ++i;
+    }
+  }
+  usedArea_ += static_cast<long long>(w) * h;
+  return true;
+}
+
+float SkylinePacker::Occupancy() const {
+  const long long area = static_cast<long long>(width_) * height_;
+  return area > 0 ? static_cast<float>(static_cast<double>(usedArea_) / area) : 0.f;
+}
+
+RuntimeTextureAtlas &RuntimeTextureAtlas::instance() {
+  static RuntimeTextureAtlas atlas;
+  return atlas;
+}
+
+void RuntimeTextureAtlas::SetEnabled(bool enabled) {
+  if (enabled_ == enabled)
+    return;
+  enabled_ = enabled;
+  if (!enabled_)
+    Clear();
+}
+
+void RuntimeTextureAtlas::Clear() {
+  entries_.clear();
+  pages_.clear();
+  pagesUnavailable_ = false;
+}
+
+RuntimeTextureAtlas::Page *RuntimeTextureAtlas::CreatePage(Renderer &renderer) {
+  TextureHandle target = renderer.CreateRenderTarget(kPageSize, kPageSize);
+  if (!target.valid()) {
+    pagesUnavailable_ = true;
+    return nullptr;
+  }
+  renderer.PushRenderTarget(target); // clears to transparent
+  renderer.PopRenderTarget();
+  Page page;
+  page.texture = std::make_shared<TextureResource>(
+      "atlas:page" + std::to_string(pages_.size()), target, &renderer);
+  page.packer.Reset(kPageSize, kPageSize);
+  pages_.push_back(std::move(page));
+  return &pages_.back();
+}
+
+RuntimeTextureAtlas::Entry &
+RuntimeTextureAtlas::PackSource(Renderer &renderer,
+                                const std::shared_ptr<TextureResource> &source) {
+  Entry &e = entries_[source.get()];
+  e.source = source;
+  const TextureHandle &tex = source->texture;
+  const int w = tex.width;
+  const int h = tex.height;
+  if (w <= 0 || h <= 0 || w > kMaxPackedSide || h > kMaxPackedSide || pagesUnavailable_)
+    return e;
+
+  const int paddedW = w + kPadding * 2;
+  const int paddedH = h + kPadding * 2;
+  Page *page = nullptr;
+  int x = 0, y = 0;
+  for (Page &p : pages_) {
+    if (p.packer.Insert(paddedW, paddedH, x, y)) {
+      page = &p;
+      break;
+    }
+  }
+  if (!page) {
+    page = CreatePage(renderer);
+    if (!page || !page->packer.Insert(paddedW, paddedH, x, y))
+      return e;
+  }
+
+  // GPU copy into the page: no blending, camera suspended by the push.
+  const TextureHandle pageTex = page->texture->texture;
+  renderer.PushRenderTarget(pageTex, false);
+  renderer.DrawTexturePro(tex, {0.f, 0.f, static_cast<float>(w), static_cast<float>(h)},
+                          {static_cast<float>(x + kPadding), static_cast<float>(y + kPadding),
+                           static_cast<float>(w), static_cast<float>(h)},
+                          {0.f, 0.f}, 0.f, Colors::White, TextureBlendMode::None);
+  renderer.PopRenderTarget();
+
+  e.placement.page = page->texture;
+  e.placement.x = x + kPadding;
+  e.placement.y = y + kPadding;
+  e.placement.width = w;
+  e.placement.height = h;
+  e.packed = true;
+  return e;
+}
+
+const AtlasPlacement *
+RuntimeTextureAtlas::Resolve(Renderer &renderer,
+                             const std::shared_ptr<TextureResource> &source) {
+  if (!enabled_ || !source || !source->texture.valid())
+    return nullptr;
+  const uint64_t generation = AssetManager::instance().generation();
+  if (generation != assetGeneration_) {
+    Clear();
+    assetGeneration_ = generation;
+  }
+  auto it = entries_.find(source.get());
+  Entry &e = it != entries_.end() ? it->second : PackSource(renderer, source);
+  return e.packed ? &e.placement : nullptr;
+}
+
+bool RuntimeTextureAtlas::Remap(Renderer &renderer,
+                                const std::shared_ptr<TextureResource> &source,
+                                TextureHandle &texture, Rect &rect) {
+  const AtlasPlacement *p = Resolve(renderer, source);
+  if (!p)
+    return false;
+  if (rect.x < 0.f || rect.y < 0.f || rect.x + rect.width > static_cast<float>(p->width) ||
+      rect.y + rect.height > static_cast<float>(p->height))
+    return false; // would sample a neighbour on the page
+  texture = p->page->texture;
+  rect.x += static_cast<float>(p->x);
+  rect.y += static_cast<float>(p->y);
+  return true;
+}
+
+RuntimeTextureAtlas::Stats RuntimeTextureAtlas::GetStats() const {
+  Stats s;
+  s.pages = pages_.size();
+  for (const auto &[key, e] : entries_) {
+    if (e.packed)
+      ++s.packed;
+    else
+      ++s.standalone;
+  }
+  for (const Page &p : pages_)
+    s.occupancy += p.packer.Occupancy();
+  if (!pages_.empty())
+    s.occupancy /= static_cast<float>(pages_.size());
+  return s;
+}
+
+} // namespace criogenio
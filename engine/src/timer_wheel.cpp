@@ -0,0 +1,68 @@
+#include "timer_wheel.h"
+
+namespace criogenio {
+
+void TimerWheel::Clear(uint64_t now) {
+  for (auto &level : slots_) {
+    for (auto &slot : level)
+      slot.clear();
+  }
+  now_ = now;
+  pending_ = 0;
+}
+
+void TimerWheel::file(const Timer &t) {
+  const uint64_t delta = t.due - now_;
+  int level = 0;
+  while (level < kLevels - 1 && delta >= (uint64_t{1} << (kSlotBits * (level + 1))))
+    ++level;
+  uint64_t at = t.due;
+  const uint64_t span = uint64_t{1} << (kSlotBits * kLevels);
+  if (delta >= span)
+    at = now_ + span - 1; // parked; re-filed when its top-level slot turns
+  slots_[level][(at >> (kSlotBits * level)) & (kSlots - 1)].push_back(t);
+}
+
+void TimerWheel::Schedule(uint64_t key, uint64_t due) {
+  file({key, due > now_ ? due : now_ + 1});
+  ++pending_;
+}
+
+void TimerWheel::Advance(uint64_t now, std::vector<uint64_t> &fired) {
+  static thread_local std::vector<Timer> moving;
+  while (now_ < now) {
+    if (pending_ == 0) {
+      now_ = now;
+      return;
+    }
+    ++now_;
+    // Cascade higher levels whose slot boundary this tick crosses (top first).
+    for (int level = kLevels - 1; level > 0; --level) {
+      const uint64_t mask = (uint64_t{1} << (kSlotBits * level)) - 1;
+      if ((now_ & mask) != 0)
+        continue;
+      std::vector<Timer> &slot = slots_[level][(now_ >> (kSlotBits * level)) & (kSlots - 1)];
+      if (slot.empty())
+        continue;
+      moving.swap(slot);
+      for (const Timer &t : moving)
+        file(t);
+      moving.clear();
+    }
+    std::vector<Timer> &slot = slots_[0][now_ & (kSlots - 1)];
+    if (slot.empty())
+      continue;
+    size_t kept = 0;
+    for (const Timer &t : slot) {
+      if (t.due <= now_) {
+        fired.push_back(t.key);
+        --pending_;
+      } else {
+        slot[kept++] = t; // due on a later turn of this slot
+      }
+    }
+    slot.resize(kept);
+  }
+}
+
+} // namespace criogenio
@@ -2,6 +2,7 @@
 #include "level_metadata_json.h"
 #include "map_authoring_components.h"
 #include "object_layer.h"
+#include "profiler.h"
 #include "animated_component.h"
 #include "animation_database.h"
 #include "asset_manager.h"
@@ -19,7 +20,7 @@ namespace criogenio {
 World::World() = default;
 
 World::~World() {
-  systems.clear(); // Clear all systems explicitly
+  ClearSystems(); // Clear all systems explicitly
   ecs::Registry::instance().clear();
 }
 
@@ -42,6 +43,7 @@ void World::DeleteEntity(ecs::EntityId id) {
   }
   ecs::Registry::instance().destroy_entity(id);
   entity_names.erase(id);
+  MarkSpatialDirty(id);
 }
 
 bool World::HasEntity(ecs::EntityId id) const {
@@ -50,21 +52,155 @@ bool World::HasEntity(ecs::EntityId id) const {
 
 void World::OnUpdate(std::function<void(float)> fn) { userUpdate = fn; }
 
-void World::ClearSystems() { systems.clear(); }
+void World::ClearSystems() {
+  systems.clear();
+  systemTimings_.clear();
+}
+
+const SystemTiming *World::FindSystemTiming(const std::string &name) const {
+  for (const SystemTiming &t : systemTimings_)
+    if (t.name == name)
+      return &t;
+  return nullptr;
+}
+
+void World::ResetSystemTimings() {
+  for (SystemTiming &t : systemTimings_) {
+    t.update.Reset();
+    t.render.Reset();
+  }
+}
+
+namespace {
+
+/** Conservative world AABB of a sprite drawn at `dest`, rotated about dest.xy + origin. */
+Rect SpriteCullBounds(const Rect &dest, Vec2 origin, float rotation) {
+  if (std::fabs(rotation) < 0.001f)
+    return dest;
+  const float px = dest.x + origin.x;
+  const float py = dest.y + origin.y;
+  const float ex = std::max(origin.x, dest.width - origin.x);
+  const float ey = std::max(origin.y, dest.height - origin.y);
+  const float r = std::sqrt(ex * ex + ey * ey);
+  return {px - r, py - r, 2.f * r, 2.f * r};
+}
+
+Rect RectUnion(const Rect &a, const Rect &b) {
+  const float x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+  const float x1 = std::max(a.x + a.width, b.x + b.width);
+  const float y1 = std::max(a.y + a.height, b.y + b.height);
+  return {x0, y0, x1 - x0, y1 - y0};
+}
+
+/** Draw bounds as SpriteSystem (centre pivot) / RenderSystem (top-left pivot) place them. */
+bool SpriteDrawBounds(const ecs::Registry &reg, ecs::EntityId id, const Transform &tr,
+                      Rect &out) {
+  const float sx = (tr.scale_x > 0.0f) ? tr.scale_x : 1.0f;
+  const float sy = (tr.scale_y > 0.0f) ? tr.scale_y : 1.0f;
+  bool any = false;
+  if (const auto *sp = reg.get_component<Sprite>(id)) {
+    const float w = static_cast<float>(sp->spriteSize) * sx;
+    const float h = static_cast<float>(sp->spriteSize) * sy;
+    out = SpriteCullBounds({tr.x, tr.y, w, h}, {w * 0.5f, h * 0.5f}, tr.rotation);
+    any = true;
+  }
+  if (const auto *asp = reg.get_component<AnimatedSprite>(id)) {
+    if (const auto *def = AnimationDatabase::instance().getAnimation(asp->animationId)) {
+      const Rect b = SpriteCullBounds(
+          {tr.x, tr.y, def->maxFrameSize.x * sx, def->maxFrameSize.y * sy}, {0.f, 0.f},
+          tr.rotation);
+      out = any ? RectUnion(out, b) : b;
+      any = true;
+    }
+  }
+  return any;
+}
+
+} // namespace
+
+void World::SyncSpatialIndices() {
+  const uint64_t animGen = AnimationDatabase::instance().generation();
+  if (animGen != spriteAnimGeneration_) {
+    // Clip edits can change any animation's largest frame.
+    spriteAnimGeneration_ = animGen;
+    static thread_local std::vector<ecs::EntityId> animated;
+    ecs::Registry::instance().view<AnimatedSprite>(animated);
+    for (ecs::EntityId id : animated)
+      MarkSpatialDirty(id);
+  }
+  if (spatialDirty_.empty())
+    return;
+  CRIO_PROFILE_ZONE("World::SpatialIndexSync");
+  // Const registry access: reading here must not mark the entities dirty again.
+  const ecs::Registry &reg = ecs::Registry::instance();
+  for (ecs::EntityId id : spatialDirty_) {
+    spatialDirtyFlags_[id] = 0;
+    const auto *tr = reg.has_entity(id) ? reg.get_component<Transform>(id) : nullptr;
+    if (!tr) {
+      spatialIndex_.Remove(id);
+      spriteIndex_.Remove(id);
+      continue;
+    }
+    Rect bounds{tr->x, tr->y, 0.f, 0.f};
+    if (const auto *box = reg.get_component<BoxCollider>(id))
+      bounds = {tr->x + box->offsetX, tr->y + box->offsetY, box->width, box->height};
+    else if (const auto *pk = reg.get_component<WorldPickup>(id))
+      bounds = {tr->x, tr->y, pk->width, pk->height};
+    spatialIndex_.Update(id, bounds);
+    if (SpriteDrawBounds(reg, id, *tr, bounds))
+      spriteIndex_.Update(id, bounds);
+    else
+      spriteIndex_.Remove(id);
+  }
+  spatialDirty_.clear();
+}
+
+const SpatialHashGrid2D &World::GetSpatialIndex() {
+  SyncSpatialIndices();
+  return spatialIndex_;
+}
+
+const SpatialHashGrid2D &World::GetSpriteIndex() {
+  SyncSpatialIndices();
+  return spriteIndex_;
+}
+
+void World::QuerySpritesInRect(const Rect &area, std::vector<ecs::EntityId> &out) {
+  GetSpriteIndex().QueryRect(area, out);
+}
+
+void World::QueryEntitiesInRect(const Rect &area, std::vector<ecs::EntityId> &out) {
+  GetSpatialIndex().QueryRect(area, out);
+}
+
+void World::QueryEntitiesInRadius(Vec2 center, float radius, std::vector<ecs::EntityId> &out) {
+  GetSpatialIndex().QueryRadius(center.x, center.y, radius, out);
+}
+
+void World::QueryNearestEntities(Vec2 center, float maxRadius, size_t k,
+                                 std::vector<ecs::EntityId> &out) {
+  GetSpatialIndex().QueryNearest(center.x, center.y, maxRadius, k, out);
+}
 
 void World::Update(float dt) {
+  CRIO_PROFILE_ZONE("World::Update");
   // Run user update callback
   if (userUpdate) {
     userUpdate(dt);
   }
 
-  // Update systems
-  for (auto &system : systems) {
-    system->Update(dt);
+  // Update systems. Timings are stored after each call: a system may AddSystem, which can
+  // reallocate systemTimings_ under a held reference.
+  for (size_t i = 0; i < systems.size(); ++i) {
+    CRIO_PROFILE_ZONE(systems[i]->SystemName());
+    CRIO_TIME_START(elapsed);
+    systems[i]->Update(dt);
+    CRIO_TIME_STORE(elapsed, systemTimings_[i].update);
   }
 }
 
 void World::Render(Renderer& renderer) {
+  CRIO_PROFILE_ZONE("World::Render");
   renderer.BeginCamera2D(*GetActiveCamera());
   // Only draw the default grid when there is no terrain; otherwise the editor
   // draws a single terrain-aligned grid to avoid two overlapping grids.
@@ -73,11 +209,16 @@ void World::Render(Renderer& renderer) {
     renderer.DrawCircle(0, 0, 6, Colors::Red);
   }
 
-  if (terrain)
+  if (terrain) {
+    CRIO_PROFILE_ZONE("Terrain2D::Render");
     terrain->Render(renderer);
+  }
 
-  for (auto& system : systems) {
-    system->Render(renderer);
+  for (size_t i = 0; i < systems.size(); ++i) {
+    CRIO_PROFILE_ZONE(systems[i]->SystemName());
+    CRIO_TIME_START(elapsed);
+    systems[i]->Render(renderer);
+    CRIO_TIME_STORE(elapsed, systemTimings_[i].render);
   }
 
   renderer.EndCamera2D();
@@ -257,6 +398,10 @@ SerializedWorld World::Serialize(const std::string &world_file_dir_for_level_exp
 void World::Deserialize(const SerializedWorld &data,
                         const std::string &asset_root_dir) {
   ecs::Registry::instance().clear();
+  spatialIndex_.Clear();
+  spriteIndex_.Clear();
+  spatialDirty_.clear();
+  spatialDirtyFlags_.clear();
   mainCameraEntity = ecs::NULL_ENTITY;
   mainCamera3DEntity = ecs::NULL_ENTITY;
   terrain = nullptr;
@@ -598,7 +743,7 @@ ecs::EntityId World::FindEntityByReplicatedNetId(uint32_t netId) const {
 bool World::TryGetEntityCenter2D(ecs::EntityId id, float width, float height, Vec2 *outCenter) const {
   if (!outCenter || id == ecs::NULL_ENTITY)
     return false;
-  auto *tr = const_cast<World *>(this)->GetComponent<Transform>(id);
+  const auto *tr = ReadComponent<Transform>(id);
   if (!tr)
     return false;
   outCenter->x = tr->x + width * 0.5f;
@@ -384,6 +384,23 @@ filter("system:linux")
 links({ "GL", "pthread", "m", "dl", "X11", "z" })
 filter({})
 
+-- Headless ECS / systems / replication micro-benchmarks; writes JSON (see campsur_bench.cpp).
+project("campsur_bench")
+kind("ConsoleApp")
+language("C++")
+cppdialect("C++23")
+location("./")
+targetname("campsur_bench")
+files({ "campsur_bench.cpp" })
+includedirs({ "engine/include", "engine/", "." })
+link_to("engine")
+link_sdl3()
+filter("configurations:Debug")
+optimize("Speed")
+filter("system:linux")
+links({ "GL", "pthread", "m", "dl", "X11", "z" })
+filter({})
+
 if os.isfile("enet-1.3.18/premake5.lua") then
 	include("enet-1.3.18")
 end
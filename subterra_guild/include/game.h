@@ -35,6 +35,7 @@ public:
   explicit MapBoundsSystem(criogenio::World &w) : world(w) {}
   void Update(float dt) override;
   void Render(criogenio::Renderer &renderer) override;
+  const char *SystemName() const override { return "MapBounds"; }
 };
 
 class CameraFollowSystem : public criogenio::ISystem {
@@ -44,6 +45,7 @@ public:
   CameraFollowSystem(criogenio::World &w, SubterraSession &s) : world(w), session(s) {}
   void Update(float dt) override;
   void Render(criogenio::Renderer &renderer) override;
+  const char *SystemName() const override { return "CameraFollow"; }
 };
 
 /** E to pick up nearest item in range; 1–5 action bar, U use consumable; draws pickup markers. */
@@ -53,6 +55,7 @@ public:
   explicit PickupSystem(SubterraSession &s) : session(s) {}
   void Update(float dt) override;
   void Render(criogenio::Renderer &renderer) override;
+  const char *SystemName() const override { return "Pickup"; }
 };
 
 /** Vitals + status effects tick (after movement/animation). */
@@ -62,6 +65,7 @@ public:
   explicit VitalsSystem(SubterraSession &s) : session(s) {}
   void Update(float dt) override;
   void Render(criogenio::Renderer &renderer) override;
+  const char *SystemName() const override { return "Vitals"; }
 };
 
 class MobBrainSystem : public criogenio::ISystem {
@@ -70,6 +74,7 @@ public:
   explicit MobBrainSystem(SubterraSession &s) : session(s) {}
   void Update(float dt) override;
   void Render(criogenio::Renderer &renderer) override;
+  const char *SystemName() const override { return "MobBrain"; }
 };
 
 class ItemEventDispatchSystem : public criogenio::ISystem {
@@ -78,6 +83,7 @@ public:
   explicit ItemEventDispatchSystem(SubterraSession &s) : session(s) {}
   void Update(float dt) override;
   void Render(criogenio::Renderer &renderer) override;
+  const char *SystemName() const override { return "ItemEventDispatch"; }
 };
 
 class ItemLightSyncSystem : public criogenio::ISystem {
@@ -86,6 +92,7 @@ public:
   explicit ItemLightSyncSystem(SubterraSession &s) : session(s) {}
   void Update(float dt) override;
   void Render(criogenio::Renderer &renderer) override;
+  const char *SystemName() const override { return "ItemLightSync"; }
 };
 
 } // namespace subterra
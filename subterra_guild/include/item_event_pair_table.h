@@ -0,0 +1,65 @@
+#pragma once
+
+#include "subterra_event_symbols.h"
+#include "timer_wheel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace subterra {
+
+enum class ItemEventTarget : uint8_t { Interactable, Mob };
+
+/** 64-bit FNV-1a of an item prefab id, computed once per emitter rather than per pair. */
+uint64_t ItemEventPrefabHash(std::string_view prefab);
+/** Hashed (source entity, item prefab, event, target) key; 0 is never returned. */
+uint64_t ItemEventPairKey(uint32_t sourceEntity, uint64_t prefabHash, EventSymbol event,
+                          ItemEventTarget target, uint32_t targetId);
+
+/**
+ * Emitter/target overlap state for `SubterraItemEventDispatchTick`: an open-addressing set of
+ * pair keys stamped with the frame generation that last touched them, plus dispatch
+ * cooldowns expired by a TimerWheel in milliseconds. A pair neither touched last frame nor
+ * cooling is dead and its slot is reused; the table is rebuilt from live pairs when it fills,
+ * so memory follows current overlaps rather than every pair ever seen.
+ */
+class ItemEventPairTable {
+public:
+  /** Start a frame at session time `nowMs`: bump the generation and expire cooldowns. */
+  void BeginFrame(uint64_t nowMs);
+  /** Mark `key` inside this frame; returns whether it was inside the previous frame. */
+  bool Touch(uint64_t key);
+  bool Cooling(uint64_t key) const;
+  /** Suppress dispatch for `key` until `untilMs` (no-op if it is not in the table). */
+  void StartCooldown(uint64_t key, uint64_t untilMs);
+  void Clear();
+
+  size_t InsideCount() const { return inside_; }
+  size_t CoolingCount() const { return cooling_; }
+  size_t Capacity() const { return entries_.size(); }
+  /** Keys touched this frame (table order). */
+  void InsideKeys(std::vector<uint64_t> &out) const;
+
+private:
+  struct Entry {
+    uint64_t key = 0; // 0 = never used
+    uint64_t coolUntil = 0;
+    uint32_t seen = 0;
+    bool wasInside = false;
+    bool cooling = false;
+  };
+  bool live(const Entry &e) const { return e.cooling || e.seen + 1 >= generation_; }
+  int find(uint64_t key) const;
+  void rebuild(size_t liveCount);
+
+  std::vector<Entry> entries_;
+  size_t used_ = 0;
+  size_t inside_ = 0;
+  size_t cooling_ = 0;
+  uint32_t generation_ = 1;
+  criogenio::TimerWheel wheel_;
+};
+
+} // namespace subterra
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "graphics_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace subterra {
+
+/** Last item event dispatch tick (debug overlay / `itempairs`). */
+struct ItemLightPairStats {
+  size_t emitters = 0;
+  size_t targets = 0;
+  /** Emitter/target pairs from the grid (before the radius test). */
+  size_t candidates = 0;
+  /** Candidates inside the emitter radius. */
+  size_t pairs = 0;
+};
+
+/**
+ * Per-tick broadphase for item light dispatch. Emitters are bucketed in a uniform grid whose
+ * cell size is the largest emission radius, so a target only tests the emitters of the 3x3
+ * cells around it. Cells are a sorted (cell, emitter) list: rebuilding every tick reuses its
+ * storage and needs no hashing.
+ */
+class ItemLightBroadphase {
+public:
+  struct Pair {
+    uint32_t emitter = 0;
+    uint32_t target = 0;
+  };
+
+  /** Index emitters at `centers` (world pixels) reaching `radii` pixels. */
+  void Build(const std::vector<criogenio::Vec2> &centers, const std::vector<float> &radii);
+  /** Append (emitter, `target`) for every emitter whose radius reaches (x, y). */
+  void Collect(float x, float y, uint32_t target, std::vector<Pair> &out);
+
+  float CellSize() const { return cell_; }
+  /** Counters since the last Build (targets = Collect calls). */
+  const ItemLightPairStats &Stats() const { return stats_; }
+
+private:
+  static constexpr float kMinCell = 32.f;
+  int64_t cellKey(int32_t cx, int32_t cy) const;
+
+  float cell_ = kMinCell;
+  std::vector<criogenio::Vec2> centers_;
+  std::vector<float> radii2_;
+  std::vector<std::pair<int64_t, uint32_t>> cells_;
+  ItemLightPairStats stats_;
+};
+
+} // namespace subterra
@@ -13,6 +13,7 @@ public:
   explicit MapEventSystem(SubterraSession &s) : session(&s) {}
   void Update(float dt) override;
   void Render(criogenio::Renderer &renderer) override;
+  const char *SystemName() const override { return "MapEvent"; }
 };
 
 } // namespace subterra
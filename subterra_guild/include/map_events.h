@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ecs_core.h"
+#include "subterra_event_symbols.h"
 #include "terrain.h"
 #include "tmx_metadata.h"
 #include "json.hpp"
@@ -12,6 +14,7 @@
 namespace subterra {
 
 struct SubterraSession;
+class PropertyBlock;
 
 struct MapEventPayload {
   std::string event_id;
@@ -28,10 +31,18 @@ struct MapEventPayload {
   bool is_point = false;
   int spawn_count = 0;
   bool manual = false;
+  /** Tracked entity (a player) whose box entered / left the trigger; NULL_ENTITY when manual. */
+  criogenio::ecs::EntityId instigator = criogenio::ecs::NULL_ENTITY;
   /** Optional JSON: array of action ids or `{"id":"…","param":…}`; overrides legacy branching when non-empty. */
   std::string gameplay_actions;
   /** Optional event data for listener filters (e.g. light payload). */
   nlohmann::json event_data = nlohmann::json::object();
+  /** Interned trigger / id / type; valid when `symbols_resolved` (see ResolveSymbols). */
+  EventSymbolSet symbols;
+  bool symbols_resolved = false;
+
+  /** Look up `symbols` from the strings; call after filling them, before dispatch. */
+  void ResolveSymbols();
 };
 
 struct MapEventTrigger {
@@ -54,11 +65,16 @@ struct MapEventTrigger {
 class MapEventBus {
 public:
   void addListener(std::function<void(const MapEventPayload &)> fn);
+  /** Called when a tracked entity leaves a trigger (enter listeners never see exits). */
+  void addExitListener(std::function<void(const MapEventPayload &)> fn);
   void clear();
   void dispatch(const MapEventPayload &p) const;
+  void dispatchExit(const MapEventPayload &p) const;
+  bool hasExitListeners() const { return !exitListeners_.empty(); }
 
 private:
   std::vector<std::function<void(const MapEventPayload &)>> listeners_;
+  std::vector<std::function<void(const MapEventPayload &)>> exitListeners_;
 };
 
 std::vector<MapEventTrigger> BuildMapEventTriggers(const criogenio::Terrain2D &terrain);
@@ -81,10 +97,11 @@ std::string InteractableStateKey(const std::string &mapPath,
 /** Stored flags for this interactable key (0 when never toggled). */
 std::uint8_t InteractableFlagsEffective(const SubterraSession &session,
                                         const criogenio::TiledInteractable &it);
-nlohmann::json &EnsureInteractableEntityData(SubterraSession &session,
-                                             const criogenio::TiledInteractable &it);
-const nlohmann::json *FindInteractableEntityData(const SubterraSession &session,
-                                                 const criogenio::TiledInteractable &it);
+/** Runtime state for this interactable, created from its prefab schema + defaults on first use. */
+PropertyBlock &EnsureInteractableProperties(SubterraSession &session,
+                                           const criogenio::TiledInteractable &it);
+const PropertyBlock *FindInteractableProperties(const SubterraSession &session,
+                                                const criogenio::TiledInteractable &it);
 bool InteractableEntityDataBoolEffective(const SubterraSession &session,
                                          const criogenio::TiledInteractable &it,
                                          const char *key, bool defaultValue);
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ecs_core.h"
+#include "graphics_types.h"
+#include "spatial_grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace subterra {
+
+struct MapEventTrigger;
+
+/**
+ * `SubterraSession::triggers` compiled for per-frame overlap tests. Trigger ids are indices
+ * into the list passed to Compile. Each tracked entity (every player) keeps an inside bitset;
+ * Update sets the bits of the triggers its box overlaps (candidates from a spatial grid) and
+ * reports entered / exited ids as bit diffs against the previous frame. Steady state does no
+ * allocation and no string work.
+ */
+class MapTriggerTable {
+public:
+  /** Rebuild from `triggers`; clears every tracker's inside state. */
+  void Compile(const std::vector<MapEventTrigger> &triggers);
+  size_t Size() const { return bounds_.size(); }
+  /** Bumped by Compile, so callers can notice a rebuild from inside an event listener. */
+  uint32_t Generation() const { return generation_; }
+
+  const criogenio::Rect &Bounds(uint32_t id) const { return bounds_[id]; }
+  /** Teleport-like trigger (`TriggerStringIsTeleport` on trigger, type or object type). */
+  bool IsTeleport(uint32_t id) const { return teleport_[id] != 0; }
+
+  /**
+   * Move `entity`'s box to `box`; ids that it now overlaps but did not last update go to
+   * `entered`, the reverse to `exited` (both ascending, appended).
+   */
+  void Update(criogenio::ecs::EntityId entity, const criogenio::Rect &box,
+              std::vector<uint32_t> &entered, std::vector<uint32_t> &exited);
+  bool Inside(criogenio::ecs::EntityId entity, uint32_t id) const;
+  /** Drop trackers for entities not in `live` (sorted ascending). */
+  void RetainTrackers(const std::vector<criogenio::ecs::EntityId> &live);
+  size_t TrackerCount() const { return trackers_.size(); }
+  /** Forget inside state for every tracker (next Update re-enters what it overlaps). */
+  void ResetInside();
+
+  /** Ids whose bounds overlap `area`, ascending. */
+  void Query(const criogenio::Rect &area, std::vector<size_t> &out) const;
+
+private:
+  struct Tracker {
+    criogenio::ecs::EntityId entity = criogenio::ecs::NULL_ENTITY;
+    std::vector<uint64_t> inside;
+  };
+  Tracker &TrackerFor(criogenio::ecs::EntityId entity);
+
+  std::vector<criogenio::Rect> bounds_;
+  std::vector<uint8_t> teleport_;
+  criogenio::SpatialHashGrid2D grid_{128.f}; // id + 1
+  std::vector<Tracker> trackers_;
+  std::vector<uint64_t> now_; // scratch bitset for Update
+  size_t words_ = 0;
+  uint32_t generation_ = 0;
+};
+
+} // namespace subterra
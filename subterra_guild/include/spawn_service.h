@@ -26,7 +26,7 @@ void SpawnTiledMapPrefabs(SubterraSession &session);
 void SpawnEntityPrefabMarkers(SubterraSession &session);
 
 /**
- * Fill `mobPrefabByEntity` / `mobEntityDataByEntity` for mobs already in the world
+ * Fill `mobPrefabByEntity` / `MobProperties` for mobs already in the world
  * (e.g. editor-placed `PrefabInstance` + `MobTag`) so brains and gameplay match spawned mobs.
  * Skips entities already registered and the session player.
  */
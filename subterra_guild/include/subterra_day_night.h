@@ -1,6 +1,7 @@
 #pragma once
 
 #include "graphics_types.h"
+#include <cstddef>
 #include <string>
 
 namespace criogenio {
@@ -27,6 +28,25 @@ struct SubterraDayNight {
   float effectTime = 0.f;
 };
 
+/**
+ * Light accumulation buffer for the atmosphere pass. Each map light / item emitter is one
+ * additive quad of a pre-generated radial falloff texture drawn into a low-res render target
+ * (1/kDownscale of the viewport), which is then composited over the scene once. Cost scales
+ * with light count instead of lit pixel area. Textures are created lazily on first render.
+ */
+struct SubterraLightMap {
+  static constexpr int kDownscale = 4;
+  static constexpr int kFalloffSize = 128;
+  criogenio::TextureHandle target;
+  criogenio::TextureHandle falloff;
+  /** Falloff generation failed (headless / no renderer); use the disk-stack fallback. */
+  bool falloffUnavailable = false;
+  size_t lightsLastFrame = 0;
+};
+
+/** Free the light map textures; call while the renderer is still alive. */
+void SubterraReleaseLightMap(SubterraLightMap &lm, criogenio::Renderer &renderer);
+
 /** ~1 at noon, ~0 at midnight (sin curve). */
 float SubterraDayAmbientBrightness(double dayTime);
 
@@ -50,7 +70,7 @@ std::string SubterraDayTimeClockLabel(double dayTime);
 
 /**
  * Composites atmosphere after the world draw: multiply dim (cave + night), sky tint when outdoors,
- * subtle additive lantern halo at low sun (matches reference feel; not a full light-map RT).
+ * then map lights and item emitters accumulated in `session.lightMap` and added over the scene.
  */
 void SubterraRenderAtmosphere(SubterraSession &session, criogenio::Renderer &renderer);
 
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "json.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace subterra {
+
+/**
+ * Interned event name / trigger / type, compared case-insensitively (ASCII lowercase before
+ * interning). 0 is "none". The table only grows at load time (prefab listeners, item dispatch
+ * defs); payload strings are looked up with FindEventSymbol so arbitrary triggers never add
+ * entries. Main thread only.
+ */
+using EventSymbol = uint32_t;
+constexpr EventSymbol kNoEventSymbol = 0;
+
+EventSymbol InternEventSymbol(std::string_view name);
+/** Symbol for `name` if it was ever interned, else kNoEventSymbol. */
+EventSymbol FindEventSymbol(std::string_view name);
+/** Lowercased name of `sym` (empty for kNoEventSymbol / unknown). */
+const std::string &EventSymbolName(EventSymbol sym);
+
+/** Symbols of a payload's trigger, id and type; a listener matches any of the three. */
+struct EventSymbolSet {
+  EventSymbol trigger = kNoEventSymbol;
+  EventSymbol id = kNoEventSymbol;
+  EventSymbol type = kNoEventSymbol;
+
+  bool Has(EventSymbol s) const {
+    return s != kNoEventSymbol && (s == trigger || s == id || s == type);
+  }
+};
+
+/**
+ * Listener `required_data` compiled to a flat instruction list: one typed compare per
+ * non-null key (bool / number / string without building json values, json equality for
+ * arrays and objects). Same semantics as comparing each key of the object with `==`.
+ */
+class EventPredicate {
+public:
+  static EventPredicate Compile(const nlohmann::json &required);
+  bool Matches(const nlohmann::json &eventData) const;
+  size_t Size() const { return code_.size(); }
+
+private:
+  enum class Op : uint8_t { Bool, Number, String, Json };
+  struct Instr {
+    Op op = Op::Json;
+    std::string key;
+    bool flag = false;
+    double number = 0.0;
+    std::string text;
+    nlohmann::json value;
+  };
+  bool requiresObject_ = false;
+  std::vector<Instr> code_;
+};
+
+/**
+ * Prefab listeners keyed by event symbol, so a dispatch only visits listeners whose event
+ * can match the payload. Refs point at (prefab key, index into that prefab's listener list).
+ */
+class EventListenerIndex {
+public:
+  struct Ref {
+    std::string prefab;
+    uint32_t listener = 0;
+  };
+
+  void Clear() { byEvent_.clear(); }
+  void Add(EventSymbol event, const std::string &prefab, uint32_t listener);
+  bool Empty() const { return byEvent_.empty(); }
+  /** Refs listening to any symbol in `syms`, ordered by (prefab, listener), no duplicates. */
+  void Collect(const EventSymbolSet &syms, std::vector<const Ref *> &out) const;
+
+private:
+  std::unordered_map<EventSymbol, std::vector<Ref>> byEvent_;
+};
+
+} // namespace subterra
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "json.hpp"
+#include "subterra_event_symbols.h"
+#include "subterra_property_store.h"
 
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -20,12 +23,17 @@ struct SubterraInteractableEventListenerDef {
   std::string event;
   nlohmann::json required_data = nlohmann::json::object();
   std::string action;
+  /** `event` interned and `required_data` compiled at load. */
+  EventSymbol event_sym = kNoEventSymbol;
+  EventPredicate predicate;
 };
 
 struct SubterraInteractablePrefabDef {
   bool is_event_listener_only = false;
   nlohmann::json default_entity_data = nlohmann::json::object();
   std::vector<SubterraInteractableEventListenerDef> event_listeners;
+  /** Slots for `default_entity_data` plus open / burning / locked; built at load. */
+  std::shared_ptr<const PropertySchema> property_schema;
 };
 
 /**
@@ -42,9 +50,19 @@ void SubterraInteractablePrefabsClear();
 
 bool SubterraInteractableTryGetRest(std::string_view interactable_type_normalized,
                                     SubterraInteractableRestDef &out);
+/** Largest `rest_emission.radius` over loaded prefabs (proximity query bound), 0 if none. */
+float SubterraInteractableMaxRestRadius();
 
 bool SubterraInteractableTryGetPrefabDef(std::string_view interactable_type_normalized,
                                          SubterraInteractablePrefabDef &out);
+/** Registered def without copying; nullptr when unknown. Valid until the next load / clear. */
+const SubterraInteractablePrefabDef *
+SubterraInteractableFindPrefabDef(std::string_view interactable_type_normalized);
+/** Listeners of every interactable prefab, keyed by event symbol (prefab keys lowercase). */
+const EventListenerIndex &SubterraInteractableEventListeners();
+/** `def->property_schema`, or the open / burning / locked schema for unknown types. */
+std::shared_ptr<const PropertySchema>
+SubterraInteractablePropertySchema(const SubterraInteractablePrefabDef *def);
 bool SubterraInteractableTryGetDefaultEntityData(std::string_view interactable_type_normalized,
                                                  nlohmann::json &out);
 bool SubterraInteractableTypeCanDirectUse(std::string_view interactable_type_normalized);
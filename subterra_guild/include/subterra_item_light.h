@@ -1,6 +1,7 @@
 #pragma once
 
 #include "json.hpp"
+#include "subterra_event_symbols.h"
 
 #include <string>
 #include <string_view>
@@ -19,12 +20,18 @@ struct ItemLightEmission {
   bool lantern_style = false;
 };
 
+enum class ItemEventWhen : uint8_t { Enter, Stay, Never };
+
 struct ItemEventDispatchDef {
   std::string event;
   std::string event_trigger_when;
   std::string event_action_get_data;
   nlohmann::json params = nlohmann::json::object();
   int cooldown_ms = 0;
+  /** `event` interned at load; dispatched payloads carry it as trigger and id. */
+  EventSymbol event_sym = kNoEventSymbol;
+  /** `event_trigger_when` parsed at load: empty = on_collision_enter, unknown = never. */
+  ItemEventWhen when = ItemEventWhen::Enter;
 };
 
 namespace SubterraItemLight {
@@ -1,9 +1,71 @@
 #pragma once
 
+#include "components.h"
+#include "ecs_core.h"
+
+#include <cstddef>
+#include <cstdint>
+
 namespace subterra {
 
 struct SubterraSession;
 
+/** Brain update rate, from the distance to the nearest player. */
+enum class MobBrainLod : std::uint8_t { Near, Far, Suspended };
+
+struct MobBrainLodConfig {
+  /** Brains within this many pixels of a player tick every frame. */
+  float near_radius = 480.f;
+  /** Brains beyond this are suspended and the mob idles in place. */
+  float active_radius = 1600.f;
+  /** A far brain is due once this much time has accumulated since it last ran. */
+  float far_interval_sec = 0.25f;
+  /** Wall-clock budget for due far brains per frame (at least one always runs). */
+  float far_budget_ms = 0.5f;
+};
+
+/** Last `SubterraMobBrainsTick` (debug overlay / `brainlod`). */
+struct MobBrainLodStats {
+  size_t near = 0;
+  size_t far = 0;
+  /** Far brains whose interval had elapsed. */
+  size_t far_due = 0;
+  /** Due far brains that ran within the budget; the rest wait for a later frame. */
+  size_t far_ticked = 0;
+  size_t suspended = 0;
+  double far_ms = 0.;
+};
+
+/** Session-side scheduler state: tuning, stats, the far round-robin cursor and prune clock. */
+struct MobBrainScheduler {
+  MobBrainLodConfig config;
+  MobBrainLodStats stats;
+  /** Last far mob that ran; the next frame resumes after it. */
+  criogenio::ecs::EntityId cursor = criogenio::ecs::NULL_ENTITY;
+  /** Time since `mobPrefabByEntity` was last swept for destroyed mobs. */
+  float prune_accum_sec = 0.f;
+};
+
+/** Per-mob LOD tier and time since its brain last ran; not saved with the world. */
+class MobBrainClock : public criogenio::Component {
+public:
+  float pending_dt = 0.f;
+  MobBrainLod lod = MobBrainLod::Near;
+
+  std::string TypeName() const override { return "MobBrainClock"; }
+  criogenio::SerializedComponent Serialize() const override {
+    criogenio::SerializedComponent o;
+    o.type = TypeName();
+    return o;
+  }
+  void Deserialize(const criogenio::SerializedComponent &) override {}
+};
+
+/**
+ * Run mob brains by LOD: near brains every frame, due far brains round-robin within
+ * `config.far_budget_ms`, suspended brains not at all. Brains get the time elapsed since they
+ * last ran. With no player every brain is near.
+ */
 void SubterraMobBrainsTick(SubterraSession &session, float dt);
 
 } // namespace subterra
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "json.hpp"
+#include "subterra_event_symbols.h"
+#include "subterra_property_store.h"
 
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -12,6 +15,9 @@ struct SubterraMobEventListenerDef {
   std::string event;
   nlohmann::json required_data = nlohmann::json::object();
   std::string action;
+  /** `event` interned and `required_data` compiled at load. */
+  EventSymbol event_sym = kNoEventSymbol;
+  EventPredicate predicate;
 };
 
 struct SubterraMobPrefabDef {
@@ -24,6 +30,8 @@ struct SubterraMobPrefabDef {
   std::string animation_path;
   nlohmann::json default_entity_data = nlohmann::json::object();
   std::vector<SubterraMobEventListenerDef> event_listeners;
+  /** Slots for `default_entity_data` plus the brain / action keys; built at load. */
+  std::shared_ptr<const PropertySchema> property_schema;
 };
 
 void SubterraMobPrefabsClear();
@@ -33,5 +41,11 @@ bool SubterraMobPrefabsReadListFromPath(const std::string &path,
                                         std::vector<SubterraMobPrefabDef> &out);
 bool SubterraMobPrefabNameIsRegistered(std::string_view prefabName);
 bool SubterraMobTryGetPrefabDef(std::string_view prefabName, SubterraMobPrefabDef &out);
+/** Registered def without copying; nullptr when unknown. Valid until the next load / clear. */
+const SubterraMobPrefabDef *SubterraMobFindPrefabDef(std::string_view prefabName);
+/** Listeners of every registered mob prefab, keyed by event symbol (prefab keys lowercase). */
+const EventListenerIndex &SubterraMobEventListeners();
+/** `def->property_schema`, or the runtime-keys-only schema for mobs without a prefab. */
+std::shared_ptr<const PropertySchema> SubterraMobPropertySchema(const SubterraMobPrefabDef *def);
 
 } // namespace subterra
@@ -20,7 +20,7 @@ public:
   bool sprint_locked_until_full_stamina = false;
   bool dead = false;
   /** Runtime buff/debuff instances (not serialized; rebuilt from host in MP later). */
-  std::vector<ActiveStatusInstance> active_statuses;
+  StatusEffectSet active_statuses;
 
   std::string TypeName() const override { return "PlayerVitals"; }
   criogenio::SerializedComponent Serialize() const override;
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "components.h"
+#include "json.hpp"
+#include "serialization.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace subterra {
+
+/**
+ * Interned property name (`entity_data` key), case-sensitive like the JSON it replaces. 0 is
+ * "none". Names are interned at load (prefab schemas, file-level ids in brains / actions);
+ * FindPropertyName never grows the table. Main thread only.
+ */
+using PropertyId = uint32_t;
+constexpr PropertyId kNoProperty = 0;
+
+PropertyId InternPropertyName(std::string_view name);
+/** Id for `name` if it was ever interned, else kNoProperty. */
+PropertyId FindPropertyName(std::string_view name);
+const std::string &PropertyName(PropertyId id);
+
+enum class PropertyType : uint8_t { Bool, Number, String };
+
+/**
+ * Typed slot layout for one prefab's runtime state: scalar keys of `entity_data` plus the
+ * runtime keys the game reads (brains, use actions). Numbers are 8-byte aligned doubles and
+ * bools single bytes in a flat buffer; strings index a side vector. Shared by every instance.
+ */
+class PropertySchema {
+public:
+  static constexpr size_t kMaxSlots = 64;
+
+  struct Slot {
+    PropertyId id = kNoProperty;
+    PropertyType type = PropertyType::Bool;
+    /** Byte offset into the block buffer (Bool / Number) or index into its strings. */
+    uint16_t offset = 0;
+  };
+
+  /** Adds a slot unless `id` is already declared or the schema is full. */
+  bool Declare(PropertyId id, PropertyType type);
+  /** Declares every bool / number / string key of `defaults` (other values stay dynamic). */
+  void DeclareFrom(const nlohmann::json &defaults);
+
+  /** Slot index of `id`, or -1. */
+  int Find(PropertyId id) const {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      if (slots_[i].id == id)
+        return static_cast<int>(i);
+    }
+    return -1;
+  }
+  const Slot &At(size_t i) const { return slots_[i]; }
+  size_t Size() const { return slots_.size(); }
+  size_t DataBytes() const { return dataBytes_; }
+  size_t StringCount() const { return stringCount_; }
+
+private:
+  std::vector<Slot> slots_;
+  size_t dataBytes_ = 0;
+  size_t stringCount_ = 0;
+};
+
+/**
+ * Runtime property values for one mob / interactable. Declared keys live in typed slots
+ * (no allocation on read); undeclared keys and values whose type does not match their slot
+ * fall back to a JSON object. Getters follow the old `jsonBool` / `jsonFloat` rules: bools
+ * also accept integers, numbers never accept bools. JSON is only built by ToJson (inspection,
+ * action params) and parsed by Assign / SetJson (prefab defaults, `set_interactable_state`).
+ */
+class PropertyBlock {
+public:
+  PropertyBlock() = default;
+  explicit PropertyBlock(std::shared_ptr<const PropertySchema> schema);
+
+  const PropertySchema *Schema() const { return schema_.get(); }
+
+  bool Has(PropertyId id) const;
+  bool GetBool(PropertyId id, bool fallback) const;
+  float GetFloat(PropertyId id, float fallback) const;
+  const std::string &GetString(PropertyId id, const std::string &fallback) const;
+
+  void SetBool(PropertyId id, bool v);
+  void SetFloat(PropertyId id, double v);
+  void SetString(PropertyId id, std::string_view v);
+  void SetJson(const std::string &key, const nlohmann::json &v);
+  void Erase(PropertyId id);
+
+  /** SetJson for every key of `obj` (non-objects are ignored). */
+  void Assign(const nlohmann::json &obj);
+  nlohmann::json ToJson() const;
+
+private:
+  int slotOf(PropertyId id, PropertyType type) const;
+  bool present(int slot) const { return slot >= 0 && ((present_ >> slot) & 1u); }
+  void mark(int slot, bool integral);
+  /** Drops a dynamic value shadowed by a slot write. */
+  void dropExtra(PropertyId id);
+  const nlohmann::json *extra(PropertyId id) const;
+
+  std::shared_ptr<const PropertySchema> schema_;
+  std::vector<unsigned char> data_;
+  std::vector<std::string> strings_;
+  uint64_t present_ = 0;
+  /** Number slots set from JSON integers (round-trip as integers, usable as bools). */
+  uint64_t integral_ = 0;
+  nlohmann::json extra_;
+};
+
+/** Runtime mob state (prefab `entity_data` + brain / action values); not saved with the world. */
+class MobProperties : public criogenio::Component {
+public:
+  PropertyBlock props;
+
+  MobProperties() = default;
+  explicit MobProperties(std::shared_ptr<const PropertySchema> schema) : props(std::move(schema)) {}
+
+  std::string TypeName() const override { return "MobProperties"; }
+  criogenio::SerializedComponent Serialize() const override {
+    criogenio::SerializedComponent o;
+    o.type = TypeName();
+    return o;
+  }
+  void Deserialize(const criogenio::SerializedComponent &) override {}
+};
+
+} // namespace subterra
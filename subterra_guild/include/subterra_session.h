@@ -3,17 +3,25 @@
 #include "animation_database.h"
 #include "ecs_core.h"
 #include "delayed_command_queue.h"
+#include "item_event_pair_table.h"
+#include "item_light_broadphase.h"
 #include "map_events.h"
+#include "map_trigger_table.h"
+#include "path_service.h"
+#include "spatial_grid.h"
 #include "subterra_gameplay_actions.h"
 #include "subterra_camera.h"
 #include "subterra_day_night.h"
+#include "subterra_mob_brains.h"
 #include "subterra_input_config.h"
+#include "subterra_property_store.h"
 #include "subterra_status_effects.h"
 #include "subterra_world_rules.h"
 #include "tmx_metadata.h"
 #include "world.h"
 #include "json.hpp"
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -52,7 +60,8 @@ struct SubterraSession {
   /** Triggers added at runtime (console / game); merged in `rebuildTriggers`. Cleared on `loadMap`. */
   std::vector<MapEventTrigger> runtimeTriggers;
   int runtimeTriggerSeq = 1;
-  std::unordered_set<std::string> triggerInsidePrevFrame;
+  /** `triggers` compiled for MapEventSystem (bounds grid, per-player inside bitsets). */
+  MapTriggerTable triggerTable;
   MapEventBus mapEvents;
   GameplayActionRegistry gameplay;
   criogenio::DelayedCommandQueue gameplayCommandQueue;
@@ -68,20 +77,33 @@ struct SubterraSession {
   criogenio::ecs::EntityId nearestPickupEntity = criogenio::ecs::NULL_ENTITY;
   /** Cached from current terrain TMX (`rebuildTriggers`). */
   std::vector<criogenio::TiledInteractable> tiledInteractables;
+  /**
+   * Bounds of `tiledInteractables` (point interactables as zero-size rects), keyed by vector
+   * index + 1; rebuilt with the list in `rebuildTriggers`.
+   */
+  criogenio::SpatialHashGrid2D interactableIndex{128.f};
+  /**
+   * Async tile paths over the current map; closed doors (`InteractableBlocksMovement`) are
+   * published as blockers so toggling one rebuilds only the clusters around it.
+   */
+  std::unique_ptr<criogenio::PathService> paths;
   /** Index into `tiledInteractables` within use radius, or -1. */
   int nearestInteractableIndex = -1;
   /** Per `InteractableStateKey`: door/chest open, campfire burning, etc. */
   std::unordered_map<std::string, std::uint8_t> interactableStateFlags;
-  /** Per interactable instance key: dynamic JSON state initialized from prefab `entity_data`. */
-  std::unordered_map<std::string, nlohmann::json> interactableEntityDataByKey;
-  /** Runtime mob state by entity id (prefab defaults + dynamic values). */
-  std::unordered_map<criogenio::ecs::EntityId, nlohmann::json> mobEntityDataByEntity;
+  /**
+   * Per interactable instance key: typed runtime state initialized from prefab `entity_data`
+   * (mob state lives on the entity as `MobProperties`).
+   */
+  std::unordered_map<std::string, PropertyBlock> interactablePropertiesByKey;
   /** Runtime mob prefab id by entity id. */
   std::unordered_map<criogenio::ecs::EntityId, std::string> mobPrefabByEntity;
-  /** Item event dispatcher overlap cache (`source|event|target`). */
-  std::unordered_set<std::string> itemEventPairsInside;
-  /** Item event dispatcher cooldown expiry (seconds, session clock). */
-  std::unordered_map<std::string, float> itemEventCooldownUntilSec;
+  /** Mob brain LOD tuning, round-robin cursor and last-tick stats. */
+  MobBrainScheduler mobBrains;
+  /** Item event dispatcher overlap pairs and cooldowns (hashed source / event / target keys). */
+  ItemEventPairTable itemEventPairs;
+  /** Emitter grid for item event dispatch, rebuilt each tick; Stats() feeds the debug overlay. */
+  ItemLightBroadphase itemLightBroadphase;
   float itemEventDispatchClockSec = 0.f;
   /** Key = TMX filename (e.g. `City.tmx`). If present, `loadMap` restores pickups instead of TMX prefab spawn. */
   std::unordered_map<std::string, std::vector<PersistedPickup>> persistedPickupsByBasename;
@@ -89,6 +111,7 @@ struct SubterraSession {
   std::string interactHint;
 
   SubterraDayNight dayNight;
+  SubterraLightMap lightMap;
   SubterraWorldRules worldRules;
   SubterraStatusRegistry statusRegistry;
   SubterraCameraBundle camera;
@@ -103,6 +126,14 @@ struct SubterraSession {
   bool runHeldPrev = false;
 
   void rebuildTriggers();
+  /** Indices into `triggers` whose zone overlaps `area`, ascending (list order). */
+  void queryTriggers(const criogenio::Rect &area, std::vector<size_t> &out) const;
+  /** Indices into `tiledInteractables` whose bounds overlap `area`, ascending. */
+  void queryInteractables(const criogenio::Rect &area, std::vector<size_t> &out) const;
+  /** Indices into `tiledInteractables` whose bounds come within `radius` of (cx, cy), ascending. */
+  void queryInteractablesInRadius(float cx, float cy, float radius, std::vector<size_t> &out) const;
+  /** Keep `paths` in step with terrain collision and door state, then deliver finished paths. */
+  void syncPathService();
   /** Append a trigger zone; assigns `storage_key` if empty (`rt_N`). Refreshes `triggers`. */
   std::string addRuntimeTrigger(MapEventTrigger t);
   void clearRuntimeTriggers();
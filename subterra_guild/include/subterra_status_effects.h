@@ -9,6 +9,10 @@
 #include <unordered_map>
 #include <vector>
 
+namespace criogenio {
+class World;
+}
+
 namespace subterra {
 
 struct SubterraSession;
@@ -34,6 +38,8 @@ bool SubterraLoadStatusEffectsFromPaths(const char *const *bufferPaths, size_t b
 bool SubterraStatusApply(SubterraSession &session, PlayerVitals &vitals,
                          const std::string &player_effect_flag);
 void SubterraStatusTickPlayer(SubterraSession &session, PlayerVitals &vitals, float dt);
+/** Tick the status effects of every entity with PlayerVitals (player, other players, mobs). */
+void SubterraStatusTickAll(SubterraSession &session, criogenio::World &world, float dt);
 void SubterraStatusRefreshStarving(SubterraSession &session, PlayerVitals &vitals);
 
 bool SubterraStatusPlayerHasActiveIncreaseLine(const PlayerVitals &vitals,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -33,24 +34,44 @@ struct StatusEffectDef {
   std::vector<StatusEffectLineDef> lines;
 };
 
-struct StatusInstanceLine {
-  StatusLineKind kind = StatusLineKind::None;
-  std::uint8_t target_mask = 0;
-  float amount_total = 0.f;
-  double duration_sec = 0.;
-  float applied = 0.f;
-  bool remove_debuffs_done = false;
-};
+/**
+ * Active buff/debuff instances of one PlayerVitals, stored column-wise. Instance columns are
+ * indexed by slot (application order); timed and rate-mode Increase/Decrease lines live in
+ * their own columns tagged with the owning slot, so the tick is one flat pass per entity.
+ * `prevent_regen` and `increasing` OR the per-instance masks and are only recomputed when an
+ * instance is added or removed.
+ */
+struct StatusEffectSet {
+  std::vector<std::string> flag;
+  std::vector<int> def_index;
+  std::vector<double> time_remaining;
+  std::vector<std::uint8_t> time_is_inert;
+  /** kTargetMask* bits of PreventRegen lines. */
+  std::vector<std::uint8_t> prevent_regen_mask;
+  /** kTargetMask* bits of non-zero Increase lines. */
+  std::vector<std::uint8_t> increase_mask;
+
+  std::vector<std::uint32_t> line_owner;
+  std::vector<std::uint8_t> line_target_mask;
+  /** +1 for Increase, -1 for Decrease. */
+  std::vector<float> line_sign;
+  /** Amount per second (>= 0). */
+  std::vector<float> line_rate;
+  /** Amount still to apply; infinity for rate-mode lines. */
+  std::vector<float> line_remaining;
+
+  std::uint8_t prevent_regen = 0;
+  std::uint8_t increasing = 0;
 
-struct ActiveStatusInstance {
-  std::string flag;
-  int def_index = -1;
-  double time_remaining = 0.;
-  bool time_is_inert = false;
-  std::vector<StatusInstanceLine> lines;
-  bool prevent_regen_health = false;
-  bool prevent_regen_stamina = false;
-  bool prevent_regen_food = false;
+  size_t Size() const { return def_index.size(); }
+  bool Empty() const { return def_index.empty(); }
+  size_t LineCount() const { return line_owner.size(); }
+  /** Slot of the instance of `defIndex`, or -1. */
+  int Find(int defIndex) const;
+  void Clear();
+  /** Remove instance `slot` and its lines; later slots shift down by one. */
+  void Erase(size_t slot);
+  void RecomputeAggregates();
 };
 
 } // namespace subterra
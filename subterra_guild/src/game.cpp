@@ -216,10 +216,15 @@ void PickupSystem::Update(float /*dt*/) {
   criogenio::ecs::EntityId best = criogenio::ecs::NULL_ENTITY;
   float bestD2 = r2;
 
-  auto ids = session.world->GetEntitiesWith<WorldPickup, criogenio::Transform>();
+  // A pickup whose centre is in range has its footprint in range, so the index query is a
+  // superset; sorting keeps the tie-break on equal distances independent of grid layout.
+  static thread_local std::vector<criogenio::ecs::EntityId> ids;
+  ids.clear();
+  session.world->QueryEntitiesInRadius({pcx, pcy}, kInteractPickupRadiusPx, ids);
+  std::sort(ids.begin(), ids.end());
   for (criogenio::ecs::EntityId id : ids) {
-    auto *pk = session.world->GetComponent<WorldPickup>(id);
-    auto *tr = session.world->GetComponent<criogenio::Transform>(id);
+    const auto *pk = session.world->ReadComponent<WorldPickup>(id);
+    const auto *tr = session.world->ReadComponent<criogenio::Transform>(id);
     if (!pk || !tr || pk->item_id.empty() || pk->count <= 0)
       continue;
     if (SubterraInteractablePrefabNameIsRegistered(pk->item_id))
@@ -236,8 +241,12 @@ void PickupSystem::Update(float /*dt*/) {
   const float useR2 = kInteractableUseRadiusPx * kInteractableUseRadiusPx;
   int bestInteract = -1;
   float bestInteractD2 = useR2;
-  for (int i = 0; i < static_cast<int>(session.tiledInteractables.size()); ++i) {
-    const criogenio::TiledInteractable &it = session.tiledInteractables[static_cast<size_t>(i)];
+  static thread_local std::vector<size_t> nearInteractables;
+  nearInteractables.clear();
+  session.queryInteractablesInRadius(pcx, pcy, kInteractableUseRadiusPx, nearInteractables);
+  for (size_t idx : nearInteractables) {
+    const int i = static_cast<int>(idx);
+    const criogenio::TiledInteractable &it = session.tiledInteractables[idx];
     if (!SubterraInteractableTypeCanDirectUse(it.interactable_type))
       continue;
     float icx = 0.f, icy = 0.f;
@@ -365,8 +374,8 @@ void PickupSystem::Render(criogenio::Renderer &renderer) {
   }
   auto ids = session.world->GetEntitiesWith<WorldPickup, criogenio::Transform>();
   for (criogenio::ecs::EntityId id : ids) {
-    auto *pk = session.world->GetComponent<WorldPickup>(id);
-    auto *tr = session.world->GetComponent<criogenio::Transform>(id);
+    const auto *pk = session.world->ReadComponent<WorldPickup>(id);
+    const auto *tr = session.world->ReadComponent<criogenio::Transform>(id);
     if (!pk || !tr)
       continue;
     if (SubterraInteractablePrefabNameIsRegistered(pk->item_id))
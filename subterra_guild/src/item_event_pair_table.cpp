@@ -0,0 +1,152 @@
+#include "item_event_pair_table.h"
+
+namespace subterra {
+namespace {
+
+uint64_t mix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+size_t slotOf(uint64_t key, size_t mask) { return static_cast<size_t>(key ^ (key >> 29)) & mask; }
+
+} // namespace
+
+uint64_t ItemEventPrefabHash(std::string_view prefab) {
+  uint64_t h = 1469598103934665603ull;
+  for (char c : prefab) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+uint64_t ItemEventPairKey(uint32_t sourceEntity, uint64_t prefabHash, EventSymbol event,
+                          ItemEventTarget target, uint32_t targetId) {
+  uint64_t h = mix64(prefabHash);
+  h = mix64(h ^ ((uint64_t{sourceEntity} << 32) | event));
+  h = mix64(h ^ ((uint64_t{static_cast<uint8_t>(target)} << 32) | targetId));
+  return h != 0 ? h : 1;
+}
+
+int ItemEventPairTable::find(uint64_t key) const {
+  if (entries_.empty())
+    return -1;
+  const size_t mask = entries_.size() - 1;
+  for (size_t i = slotOf(key, mask);; i = (i + 1) & mask) {
+    if (entries_[i].key == key)
+      return static_cast<int>(i);
+    if (entries_[i].key == 0)
+      return -1;
+  }
+}
+
+void ItemEventPairTable::rebuild(size_t liveCount) {
+  size_t cap = 64;
+  while (cap < (liveCount + 1) * 2)
+    cap <<= 1;
+  std::vector<Entry> old;
+  old.swap(entries_);
+  entries_.assign(cap, Entry{});
+  used_ = 0;
+  const size_t mask = cap - 1;
+  for (const Entry &e : old) {
+    if (e.key == 0 || !live(e))
+      continue;
+    size_t i = slotOf(e.key, mask);
+    while (entries_[i].key != 0)
+      i = (i + 1) & mask;
+    entries_[i] = e;
+    ++used_;
+  }
+}
+
+bool ItemEventPairTable::Touch(uint64_t key) {
+  if (entries_.empty() || (used_ + 1) * 4 > entries_.size() * 3) {
+    size_t liveCount = 0;
+    for (const Entry &e : entries_)
+      liveCount += (e.key != 0 && live(e)) ? 1 : 0;
+    rebuild(liveCount);
+  }
+  const size_t mask = entries_.size() - 1;
+  size_t reuse = entries_.size();
+  size_t i = slotOf(key, mask);
+  for (; entries_[i].key != 0; i = (i + 1) & mask) {
+    Entry &e = entries_[i];
+    if (e.key == key) {
+      if (e.seen == generation_)
+        return e.wasInside;
+      e.wasInside = e.seen + 1 == generation_;
+      e.seen = generation_;
+      ++inside_;
+      return e.wasInside;
+    }
+    if (reuse == entries_.size() && !live(e))
+      reuse = i;
+  }
+  if (reuse == entries_.size()) {
+    reuse = i;
+    ++used_;
+  }
+  Entry &e = entries_[reuse];
+  e = Entry{};
+  e.key = key;
+  e.seen = generation_;
+  ++inside_;
+  return false;
+}
+
+bool ItemEventPairTable::Cooling(uint64_t key) const {
+  const int i = find(key);
+  return i >= 0 && entries_[static_cast<size_t>(i)].cooling;
+}
+
+void ItemEventPairTable::StartCooldown(uint64_t key, uint64_t untilMs) {
+  const int i = find(key);
+  if (i < 0)
+    return;
+  Entry &e = entries_[static_cast<size_t>(i)];
+  if (!e.cooling)
+    ++cooling_;
+  e.cooling = true;
+  e.coolUntil = untilMs;
+  wheel_.Schedule(key, untilMs);
+}
+
+void ItemEventPairTable::BeginFrame(uint64_t nowMs) {
+  ++generation_;
+  inside_ = 0;
+  static thread_local std::vector<uint64_t> fired;
+  fired.clear();
+  wheel_.Advance(nowMs, fired);
+  for (uint64_t key : fired) {
+    const int i = find(key);
+    if (i < 0)
+      continue;
+    Entry &e = entries_[static_cast<size_t>(i)];
+    if (e.cooling && e.coolUntil <= nowMs) {
+      e.cooling = false;
+      --cooling_;
+    }
+  }
+}
+
+void ItemEventPairTable::Clear() {
+  entries_.clear();
+  used_ = 0;
+  inside_ = 0;
+  cooling_ = 0;
+  generation_ = 1;
+  wheel_.Clear();
+}
+
+void ItemEventPairTable::InsideKeys(std::vector<uint64_t> &out) const {
+  for (const Entry &e : entries_) {
+    if (e.key != 0 && e.seen == generation_)
+      out.push_back(e.key);
+  }
+}
+
+} // namespace subterra
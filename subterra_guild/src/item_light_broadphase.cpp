@@ -0,0 +1,58 @@
+#include "item_light_broadphase.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace subterra {
+
+int64_t ItemLightBroadphase::cellKey(int32_t cx, int32_t cy) const {
+  return (static_cast<int64_t>(cx) << 32) | static_cast<uint32_t>(cy);
+}
+
+void ItemLightBroadphase::Build(const std::vector<criogenio::Vec2> &centers,
+                                const std::vector<float> &radii) {
+  centers_ = centers;
+  radii2_.clear();
+  float maxRadius = 0.f;
+  for (float r : radii) {
+    const float rr = std::max(0.f, r);
+    radii2_.push_back(rr * rr);
+    maxRadius = std::max(maxRadius, rr);
+  }
+  cell_ = std::max(kMinCell, maxRadius);
+  cells_.clear();
+  for (size_t i = 0; i < centers_.size(); ++i) {
+    const int32_t cx = static_cast<int32_t>(std::floor(centers_[i].x / cell_));
+    const int32_t cy = static_cast<int32_t>(std::floor(centers_[i].y / cell_));
+    cells_.push_back({cellKey(cx, cy), static_cast<uint32_t>(i)});
+  }
+  std::sort(cells_.begin(), cells_.end());
+  stats_ = {};
+  stats_.emitters = centers_.size();
+}
+
+void ItemLightBroadphase::Collect(float x, float y, uint32_t target, std::vector<Pair> &out) {
+  ++stats_.targets;
+  if (cells_.empty())
+    return;
+  const int32_t cx = static_cast<int32_t>(std::floor(x / cell_));
+  const int32_t cy = static_cast<int32_t>(std::floor(y / cell_));
+  for (int32_t gx = cx - 1; gx <= cx + 1; ++gx) {
+    for (int32_t gy = cy - 1; gy <= cy + 1; ++gy) {
+      const int64_t key = cellKey(gx, gy);
+      auto it = std::lower_bound(cells_.begin(), cells_.end(), std::make_pair(key, uint32_t{0}));
+      for (; it != cells_.end() && it->first == key; ++it) {
+        ++stats_.candidates;
+        const criogenio::Vec2 &c = centers_[it->second];
+        const float dx = c.x - x;
+        const float dy = c.y - y;
+        if (dx * dx + dy * dy > radii2_[it->second])
+          continue;
+        ++stats_.pairs;
+        out.push_back({it->second, target});
+      }
+    }
+  }
+}
+
+} // namespace subterra
@@ -1,55 +1,63 @@
 #include "map_event_system.h"
 #include "components.h"
 #include "map_events.h"
+#include "subterra_components.h"
 #include "subterra_session.h"
 #include <algorithm>
 
 namespace subterra {
 
-static bool aabbOverlap(float ax, float ay, float aw, float ah, float bx, float by, float bw,
-                        float bh) {
-  return ax < bx + bw && ax + aw > bx && ay < by + bh && ay + ah > by;
-}
-
-static bool triggerLooksLikeTeleport(const MapEventTrigger &trg) {
-  return TriggerStringIsTeleport(trg.event_trigger) || TriggerStringIsTeleport(trg.event_type) ||
-         TriggerStringIsTeleport(trg.object_type);
-}
-
 void MapEventSystem::Update(float /*dt*/) {
-  if (!session || !session->world || session->player == criogenio::ecs::NULL_ENTITY)
-    return;
-  criogenio::Terrain2D *ter = session->world->GetTerrain();
-  if (!ter)
-    return;
-  auto *tr = session->world->GetComponent<criogenio::Transform>(session->player);
-  if (!tr)
+  if (!session || !session->world || !session->world->GetTerrain())
     return;
+  MapTriggerTable &table = session->triggerTable;
+
+  // Every player is tracked; `session.player` counts even without a PlayerTag.
+  static thread_local std::vector<criogenio::ecs::EntityId> tracked;
+  session->world->GetEntitiesWith<PlayerTag, criogenio::Transform>(tracked);
+  if (session->player != criogenio::ecs::NULL_ENTITY &&
+      std::find(tracked.begin(), tracked.end(), session->player) == tracked.end() &&
+      session->world->HasComponent<criogenio::Transform>(session->player))
+    tracked.push_back(session->player);
+  std::sort(tracked.begin(), tracked.end());
+  table.RetainTrackers(tracked);
 
-  const float px = tr->x;
-  const float py = tr->y;
   const float pw = static_cast<float>(session->playerW);
   const float ph = static_cast<float>(session->playerH);
-
-  std::unordered_set<std::string> insideNow;
-  for (const auto &trg : session->triggers) {
-    bool inside = aabbOverlap(px, py, pw, ph, trg.x, trg.y, trg.w, trg.h);
-    if (!inside)
+  const uint32_t generation = table.Generation();
+  static thread_local std::vector<uint32_t> entered;
+  static thread_local std::vector<uint32_t> exited;
+  for (criogenio::ecs::EntityId id : tracked) {
+    const auto *tr = session->world->ReadComponent<criogenio::Transform>(id);
+    if (!tr)
       continue;
-    insideNow.insert(trg.storage_key);
-    if (session->triggerInsidePrevFrame.count(trg.storage_key))
-      continue;
-    if (triggerLooksLikeTeleport(trg)) {
-      const float tw = std::max(trg.w, 1.f);
-      const float th = std::max(trg.h, 1.f);
-      if (ClosedDoorOverlapsRect(*session, trg.x, trg.y, tw, th))
-        continue;
+    entered.clear();
+    exited.clear();
+    table.Update(id, {tr->x, tr->y, pw, ph}, entered, exited);
+    if (session->mapEvents.hasExitListeners()) {
+      for (uint32_t idx : exited) {
+        MapEventPayload p = MakePayloadFromTrigger(session->triggers[idx], false);
+        p.instigator = id;
+        session->mapEvents.dispatchExit(p);
+        if (table.Generation() != generation)
+          return; // a listener rebuilt the trigger list (map change)
+      }
+    }
+    for (uint32_t idx : entered) {
+      const MapEventTrigger &trg = session->triggers[idx];
+      if (table.IsTeleport(idx)) {
+        const float tw = std::max(trg.w, 1.f);
+        const float th = std::max(trg.h, 1.f);
+        if (ClosedDoorOverlapsRect(*session, trg.x, trg.y, tw, th))
+          continue;
+      }
+      MapEventPayload p = MakePayloadFromTrigger(trg, false);
+      p.instigator = id;
+      session->mapEvents.dispatch(p);
+      if (table.Generation() != generation)
+        return;
     }
-
-    MapEventPayload p = MakePayloadFromTrigger(trg, false);
-    session->mapEvents.dispatch(p);
   }
-  session->triggerInsidePrevFrame = std::move(insideNow);
 }
 
 void MapEventSystem::Render(criogenio::Renderer &renderer) {
@@ -97,45 +97,16 @@ static void spawnWorldCenterForObject(const criogenio::TiledMapObject &o,
   }
 }
 
-static bool jsonBool(const nlohmann::json &obj, const char *key, bool fallback) {
-  if (!obj.is_object() || !key)
-    return fallback;
-  auto it = obj.find(key);
-  if (it == obj.end())
-    return fallback;
-  if (it->is_boolean())
-    return it->get<bool>();
-  if (it->is_number_integer())
-    return it->get<int>() != 0;
-  return fallback;
-}
-
-static bool jsonRequirementsMatch(const nlohmann::json &required, const nlohmann::json &eventData) {
-  if (!required.is_object())
-    return true;
-  if (!eventData.is_object())
-    return false;
-  for (auto it = required.begin(); it != required.end(); ++it) {
-    if (it->is_null())
-      continue;
-    auto jt = eventData.find(it.key());
-    if (jt == eventData.end())
-      return false;
-    if (*jt != *it)
-      return false;
-  }
-  return true;
-}
-
-static bool payloadMatchesListenerEvent(const MapEventPayload &p, std::string eventLower) {
-  eventLower = toLower(std::move(eventLower));
-  if (!p.event_trigger.empty() && toLower(p.event_trigger) == eventLower)
-    return true;
-  if (!p.event_id.empty() && toLower(p.event_id) == eventLower)
-    return true;
-  if (!p.event_type.empty() && toLower(p.event_type) == eventLower)
-    return true;
-  return false;
+const PropertyId kPropOpen = InternPropertyName("open");
+const PropertyId kPropBurning = InternPropertyName("burning");
+const PropertyId kPropLocked = InternPropertyName("locked");
+
+/** Payload symbols, looked up on the fly for payloads built without ResolveSymbols. */
+static EventSymbolSet payloadSymbols(const MapEventPayload &p) {
+  if (p.symbols_resolved)
+    return p.symbols;
+  return {FindEventSymbol(p.event_trigger), FindEventSymbol(p.event_id),
+          FindEventSymbol(p.event_type)};
 }
 
 } // namespace
@@ -250,20 +221,38 @@ MapEventPayload MakePayloadFromTrigger(const MapEventTrigger &t, bool manual) {
   p.spawn_count = t.spawn_count;
   p.manual = manual;
   p.gameplay_actions = t.gameplay_actions;
+  p.ResolveSymbols();
   return p;
 }
 
+void MapEventPayload::ResolveSymbols() {
+  symbols = {FindEventSymbol(event_trigger), FindEventSymbol(event_id), FindEventSymbol(event_type)};
+  symbols_resolved = true;
+}
+
 void MapEventBus::addListener(std::function<void(const MapEventPayload &)> fn) {
   listeners_.push_back(std::move(fn));
 }
 
-void MapEventBus::clear() { listeners_.clear(); }
+void MapEventBus::addExitListener(std::function<void(const MapEventPayload &)> fn) {
+  exitListeners_.push_back(std::move(fn));
+}
+
+void MapEventBus::clear() {
+  listeners_.clear();
+  exitListeners_.clear();
+}
 
 void MapEventBus::dispatch(const MapEventPayload &p) const {
   for (const auto &fn : listeners_)
     fn(p);
 }
 
+void MapEventBus::dispatchExit(const MapEventPayload &p) const {
+  for (const auto &fn : exitListeners_)
+    fn(p);
+}
+
 bool FindSpawnCenter(const criogenio::TmxMapMetadata &meta, const std::string &name,
                      float &outCx, float &outCy) {
   const std::string key = trimKey(name);
@@ -308,33 +297,34 @@ std::uint8_t InteractableFlagsEffective(const SubterraSession &session,
   return 0;
 }
 
-nlohmann::json &EnsureInteractableEntityData(SubterraSession &session,
-                                             const criogenio::TiledInteractable &it) {
+PropertyBlock &EnsureInteractableProperties(SubterraSession &session,
+                                           const criogenio::TiledInteractable &it) {
   const std::string key = InteractableStateKey(session.mapPath, it);
-  auto found = session.interactableEntityDataByKey.find(key);
-  if (found != session.interactableEntityDataByKey.end())
+  auto found = session.interactablePropertiesByKey.find(key);
+  if (found != session.interactablePropertiesByKey.end())
     return found->second;
 
-  nlohmann::json def = nlohmann::json::object();
-  SubterraInteractableTryGetDefaultEntityData(toLower(it.interactable_type), def);
-  if (!def.is_object())
-    def = nlohmann::json::object();
+  const SubterraInteractablePrefabDef *def =
+      SubterraInteractableFindPrefabDef(toLower(it.interactable_type));
+  PropertyBlock props(SubterraInteractablePropertySchema(def));
+  if (def)
+    props.Assign(def->default_entity_data);
 
   std::uint8_t flags = InteractableFlagsEffective(session, it);
-  if (!def.contains("open") && (flags & InteractableState::Open) != 0)
-    def["open"] = true;
-  if (!def.contains("burning") && (flags & InteractableState::Burning) != 0)
-    def["burning"] = true;
+  if (!props.Has(kPropOpen) && (flags & InteractableState::Open) != 0)
+    props.SetBool(kPropOpen, true);
+  if (!props.Has(kPropBurning) && (flags & InteractableState::Burning) != 0)
+    props.SetBool(kPropBurning, true);
 
-  auto inserted = session.interactableEntityDataByKey.emplace(key, std::move(def));
+  auto inserted = session.interactablePropertiesByKey.emplace(key, std::move(props));
   return inserted.first->second;
 }
 
-const nlohmann::json *FindInteractableEntityData(const SubterraSession &session,
-                                                 const criogenio::TiledInteractable &it) {
+const PropertyBlock *FindInteractableProperties(const SubterraSession &session,
+                                                const criogenio::TiledInteractable &it) {
   const std::string key = InteractableStateKey(session.mapPath, it);
-  auto found = session.interactableEntityDataByKey.find(key);
-  if (found == session.interactableEntityDataByKey.end())
+  auto found = session.interactablePropertiesByKey.find(key);
+  if (found == session.interactablePropertiesByKey.end())
     return nullptr;
   return &found->second;
 }
@@ -344,8 +334,8 @@ bool InteractableEntityDataBoolEffective(const SubterraSession &session,
                                          const char *key, bool defaultValue) {
   if (!key || key[0] == '\0')
     return defaultValue;
-  if (const nlohmann::json *ed = FindInteractableEntityData(session, it))
-    return jsonBool(*ed, key, defaultValue);
+  if (const PropertyBlock *props = FindInteractableProperties(session, it))
+    return props->GetBool(FindPropertyName(key), defaultValue);
   const std::uint8_t flags = InteractableFlagsEffective(session, it);
   const std::string low = toLower(key);
   if (low == "open")
@@ -369,7 +359,11 @@ bool ClosedDoorOverlapsRect(const SubterraSession &session, float rectLeft, floa
                             float rectW, float rectH) {
   if (rectW <= 0.f || rectH <= 0.f)
     return false;
-  for (const auto &it : session.tiledInteractables) {
+  static thread_local std::vector<size_t> near;
+  near.clear();
+  session.queryInteractables({rectLeft, rectTop, rectW, rectH}, near);
+  for (size_t idx : near) {
+    const criogenio::TiledInteractable &it = session.tiledInteractables[idx];
     if (!InteractableBlocksMovement(session, it))
       continue;
     const bool overlap = rectLeft < (it.x + it.w) && (rectLeft + rectW) > it.x &&
@@ -384,17 +378,17 @@ void ApplyInteractableUse(SubterraSession &session, const criogenio::TiledIntera
   const std::string kindLower = toLower(it.interactable_type);
   const std::string key = InteractableStateKey(session.mapPath, it);
   std::uint8_t &flags = session.interactableStateFlags[key];
-  nlohmann::json &entityData = EnsureInteractableEntityData(session, it);
+  PropertyBlock &props = EnsureInteractableProperties(session, it);
 
   auto setOpenState = [&](bool open) {
-    entityData["open"] = open;
+    props.SetBool(kPropOpen, open);
     if (open)
       flags |= InteractableState::Open;
     else
       flags &= static_cast<std::uint8_t>(~InteractableState::Open);
   };
   auto setBurningState = [&](bool burning) {
-    entityData["burning"] = burning;
+    props.SetBool(kPropBurning, burning);
     if (burning)
       flags |= InteractableState::Burning;
     else
@@ -402,29 +396,29 @@ void ApplyInteractableUse(SubterraSession &session, const criogenio::TiledIntera
   };
 
   if (kindLower == "door") {
-    if (jsonBool(entityData, "locked", false)) {
+    if (props.GetBool(kPropLocked, false)) {
       sessionLog(session, "Door is locked.");
       return;
     }
-    const bool nextOpen = !jsonBool(entityData, "open", (flags & InteractableState::Open) != 0);
+    const bool nextOpen = !props.GetBool(kPropOpen, (flags & InteractableState::Open) != 0);
     setOpenState(nextOpen);
     sessionLog(session, nextOpen ? "Door opened." : "Door closed.");
     return;
   }
   if (kindLower == "chest") {
-    if (jsonBool(entityData, "locked", false)) {
+    if (props.GetBool(kPropLocked, false)) {
       sessionLog(session, "Chest is locked.");
       return;
     }
-    const bool nextOpen = !jsonBool(entityData, "open", (flags & InteractableState::Open) != 0);
+    const bool nextOpen = !props.GetBool(kPropOpen, (flags & InteractableState::Open) != 0);
     setOpenState(nextOpen);
     sessionLog(session, nextOpen ? "Chest opened." : "Chest closed.");
     return;
   }
   if (kindLower == "campfire") {
     const bool nextBurning =
-        !jsonBool(entityData, "burning", (InteractableFlagsEffective(session, it) &
-                                          InteractableState::Burning) != 0);
+        !props.GetBool(kPropBurning, (InteractableFlagsEffective(session, it) &
+                                      InteractableState::Burning) != 0);
     setBurningState(nextBurning);
     sessionLog(session, nextBurning ? "Campfire lit." : "Campfire extinguished.");
     return;
@@ -451,13 +445,14 @@ void ApplyInteractableUse(SubterraSession &session, const criogenio::TiledIntera
       }
       const std::string dkey = InteractableStateKey(session.mapPath, *target);
       std::uint8_t &dflags = session.interactableStateFlags[dkey];
-      nlohmann::json &targetData = EnsureInteractableEntityData(session, *target);
-      if (jsonBool(targetData, "locked", false)) {
+      PropertyBlock &targetProps = EnsureInteractableProperties(session, *target);
+      if (targetProps.GetBool(kPropLocked, false)) {
         sessionLog(session, "Lever pulled: door is locked.");
         return;
       }
-      const bool openNow = !jsonBool(targetData, "open", (dflags & InteractableState::Open) != 0);
-      targetData["open"] = openNow;
+      const bool openNow =
+          !targetProps.GetBool(kPropOpen, (dflags & InteractableState::Open) != 0);
+      targetProps.SetBool(kPropOpen, openNow);
       if (openNow)
         dflags |= InteractableState::Open;
       else
@@ -478,29 +473,36 @@ void ApplyInteractableUse(SubterraSession &session, const criogenio::TiledIntera
 }
 
 void EvaluateInteractableEventListeners(SubterraSession &session, const MapEventPayload &p) {
+  static thread_local std::vector<const EventListenerIndex::Ref *> refs;
+  refs.clear();
+  SubterraInteractableEventListeners().Collect(payloadSymbols(p), refs);
+  if (refs.empty())
+    return;
   for (const criogenio::TiledInteractable &it : session.tiledInteractables) {
-    SubterraInteractablePrefabDef def;
-    if (!SubterraInteractableTryGetPrefabDef(toLower(it.interactable_type), def))
+    const std::string typeKey = toLower(it.interactable_type);
+    auto first = std::lower_bound(refs.begin(), refs.end(), typeKey,
+                                  [](const EventListenerIndex::Ref *r, const std::string &k) {
+                                    return r->prefab < k;
+                                  });
+    if (first == refs.end() || (*first)->prefab != typeKey)
       continue;
-    if (def.event_listeners.empty())
+    const SubterraInteractablePrefabDef *def = SubterraInteractableFindPrefabDef(typeKey);
+    if (!def)
       continue;
     const std::string ikey = InteractableStateKey(session.mapPath, it);
-    for (const SubterraInteractableEventListenerDef &listener : def.event_listeners) {
-      if (listener.event.empty() || listener.action.empty())
+    for (auto r = first; r != refs.end() && (*r)->prefab == typeKey; ++r) {
+      const SubterraInteractableEventListenerDef &listener = def->event_listeners[(*r)->listener];
+      if (listener.action.empty() || !listener.predicate.Matches(p.event_data))
         continue;
-      if (!payloadMatchesListenerEvent(p, listener.event))
-        continue;
-      if (!jsonRequirementsMatch(listener.required_data, p.event_data))
-        continue;
-      nlohmann::json &entityData = EnsureInteractableEntityData(session, it);
+      PropertyBlock &props = EnsureInteractableProperties(session, it);
       SubterraGameplayContext ctx{session, &p, nlohmann::json::object()};
       ctx.actionParams["interactable_key"] = ikey;
-      ctx.actionParams["interactable_type"] = toLower(it.interactable_type);
+      ctx.actionParams["interactable_type"] = typeKey;
       ctx.actionParams["interactable_object_id"] = it.tiled_object_id;
       ctx.actionParams["event"] = listener.event;
       ctx.actionParams["required_data"] = listener.required_data;
       ctx.actionParams["event_data"] = p.event_data;
-      ctx.actionParams["entity_data"] = entityData;
+      ctx.actionParams["entity_data"] = props.ToJson();
       session.gameplay.runAction(listener.action, ctx);
     }
   }
@@ -509,30 +511,36 @@ void EvaluateInteractableEventListeners(SubterraSession &session, const MapEvent
 void EvaluateMobEventListeners(SubterraSession &session, const MapEventPayload &p) {
   if (!session.world)
     return;
+  static thread_local std::vector<const EventListenerIndex::Ref *> refs;
+  refs.clear();
+  SubterraMobEventListeners().Collect(payloadSymbols(p), refs);
+  if (refs.empty())
+    return;
   for (const auto &kv : session.mobPrefabByEntity) {
     const criogenio::ecs::EntityId mobId = kv.first;
     const std::string &prefabId = kv.second;
-    if (!session.world->HasEntity(mobId))
+    const std::string prefabKey = toLower(prefabId);
+    auto first = std::lower_bound(refs.begin(), refs.end(), prefabKey,
+                                  [](const EventListenerIndex::Ref *r, const std::string &k) {
+                                    return r->prefab < k;
+                                  });
+    if (first == refs.end() || (*first)->prefab != prefabKey)
       continue;
-    SubterraMobPrefabDef def;
-    if (!SubterraMobTryGetPrefabDef(prefabId, def))
+    if (!session.world->HasEntity(mobId))
       continue;
-    if (def.event_listeners.empty())
+    const SubterraMobPrefabDef *def = SubterraMobFindPrefabDef(prefabKey);
+    if (!def)
       continue;
-    nlohmann::json &mobState = session.mobEntityDataByEntity[mobId];
-    if (!mobState.is_object())
-      mobState = nlohmann::json::object();
-    for (const SubterraMobEventListenerDef &listener : def.event_listeners) {
-      if (listener.event.empty() || listener.action.empty())
-        continue;
-      if (!payloadMatchesListenerEvent(p, listener.event))
-        continue;
-      if (!jsonRequirementsMatch(listener.required_data, p.event_data))
+    const auto *mobProps = session.world->GetComponent<MobProperties>(mobId);
+    for (auto r = first; r != refs.end() && (*r)->prefab == prefabKey; ++r) {
+      const SubterraMobEventListenerDef &listener = def->event_listeners[(*r)->listener];
+      if (listener.action.empty() || !listener.predicate.Matches(p.event_data))
         continue;
       SubterraGameplayContext ctx{session, &p, nlohmann::json::object()};
       ctx.actionParams["mob_entity_id"] = static_cast<int>(mobId);
       ctx.actionParams["mob_prefab_id"] = prefabId;
-      ctx.actionParams["mob_entity_data"] = mobState;
+      ctx.actionParams["mob_entity_data"] =
+          mobProps ? mobProps->props.ToJson() : nlohmann::json::object();
       ctx.actionParams["event_data"] = p.event_data;
       ctx.actionParams["event"] = listener.event;
       session.gameplay.runAction(listener.action, ctx);
@@ -0,0 +1,109 @@
+#include "map_trigger_table.h"
+#include "map_events.h"
+#include <algorithm>
+#include <bit>
+
+namespace subterra {
+
+namespace {
+
+bool aabbOverlap(const criogenio::Rect &a, const criogenio::Rect &b) {
+  return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height &&
+         a.y + a.height > b.y;
+}
+
+/** Append the ids of the set bits of `bits` (word `w` of a bitset), ascending. */
+void appendBits(uint64_t bits, size_t w, std::vector<uint32_t> &out) {
+  while (bits) {
+    out.push_back(static_cast<uint32_t>(w * 64 + static_cast<size_t>(std::countr_zero(bits))));
+    bits &= bits - 1;
+  }
+}
+
+} // namespace
+
+void MapTriggerTable::Compile(const std::vector<MapEventTrigger> &triggers) {
+  bounds_.clear();
+  teleport_.clear();
+  grid_.Clear();
+  bounds_.reserve(triggers.size());
+  teleport_.reserve(triggers.size());
+  for (size_t i = 0; i < triggers.size(); ++i) {
+    const MapEventTrigger &trg = triggers[i];
+    bounds_.push_back({trg.x, trg.y, trg.w, trg.h});
+    teleport_.push_back(TriggerStringIsTeleport(trg.event_trigger) ||
+                                TriggerStringIsTeleport(trg.event_type) ||
+                                TriggerStringIsTeleport(trg.object_type)
+                            ? 1
+                            : 0);
+    grid_.Update(static_cast<criogenio::ecs::EntityId>(i + 1), bounds_.back());
+  }
+  words_ = (bounds_.size() + 63) / 64;
+  ++generation_;
+  ResetInside();
+}
+
+void MapTriggerTable::ResetInside() {
+  for (Tracker &t : trackers_)
+    t.inside.assign(words_, 0);
+}
+
+MapTriggerTable::Tracker &MapTriggerTable::TrackerFor(criogenio::ecs::EntityId entity) {
+  for (Tracker &t : trackers_) {
+    if (t.entity == entity)
+      return t;
+  }
+  Tracker &t = trackers_.emplace_back();
+  t.entity = entity;
+  t.inside.assign(words_, 0);
+  return t;
+}
+
+void MapTriggerTable::Update(criogenio::ecs::EntityId entity, const criogenio::Rect &box,
+                             std::vector<uint32_t> &entered, std::vector<uint32_t> &exited) {
+  Tracker &t = TrackerFor(entity);
+  now_.assign(words_, 0);
+  static thread_local std::vector<criogenio::ecs::EntityId> ids;
+  ids.clear();
+  grid_.QueryRect(box, ids);
+  for (criogenio::ecs::EntityId gid : ids) {
+    const uint32_t id = static_cast<uint32_t>(gid - 1);
+    if (aabbOverlap(box, bounds_[id]))
+      now_[id / 64] |= uint64_t{1} << (id % 64);
+  }
+  for (size_t w = 0; w < words_; ++w) {
+    appendBits(now_[w] & ~t.inside[w], w, entered);
+    appendBits(t.inside[w] & ~now_[w], w, exited);
+  }
+  t.inside.swap(now_);
+}
+
+bool MapTriggerTable::Inside(criogenio::ecs::EntityId entity, uint32_t id) const {
+  if (id >= bounds_.size())
+    return false;
+  for (const Tracker &t : trackers_) {
+    if (t.entity == entity)
+      return (t.inside[id / 64] >> (id % 64)) & 1u;
+  }
+  return false;
+}
+
+void MapTriggerTable::RetainTrackers(const std::vector<criogenio::ecs::EntityId> &live) {
+  trackers_.erase(std::remove_if(trackers_.begin(), trackers_.end(),
+                                 [&](const Tracker &t) {
+                                   return !std::binary_search(live.begin(), live.end(), t.entity);
+                                 }),
+                  trackers_.end());
+}
+
+void MapTriggerTable::Query(const criogenio::Rect &area, std::vector<size_t> &out) const {
+  static thread_local std::vector<criogenio::ecs::EntityId> ids;
+  ids.clear();
+  grid_.QueryRect(area, ids);
+  const size_t first = out.size();
+  for (criogenio::ecs::EntityId id : ids)
+    out.push_back(static_cast<size_t>(id) - 1);
+  std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+}
+
+} // namespace subterra
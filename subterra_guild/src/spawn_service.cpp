@@ -2,6 +2,7 @@
 #include "map_authoring_components.h"
 #include "subterra_interactable_prefabs.h"
 #include "subterra_mob_prefabs.h"
+#include "subterra_property_store.h"
 #include "animated_component.h"
 #include "animation_database.h"
 #include "components.h"
@@ -24,6 +25,10 @@ namespace {
 constexpr float kMobGrid = 48.f;
 namespace fs = std::filesystem;
 std::unordered_map<std::string, criogenio::AssetId> g_mobAnimByPrefab;
+const PropertyId kPropBrainType = InternPropertyName("brain_type");
+const PropertyId kPropPrefabName = InternPropertyName("prefab_name");
+const PropertyId kPropBaseScaleX = InternPropertyName("base_scale_x");
+const PropertyId kPropBaseScaleY = InternPropertyName("base_scale_y");
 
 std::string lowerAscii(std::string s) {
   for (char &c : s)
@@ -141,16 +146,17 @@ void SpawnMobAt(SubterraSession &session, float centerX, float centerY,
   ai.velocity = {90.f, 90.f};
   ai.brainState = criogenio::AIBrainState::ENEMY;
   ai.entityTarget = static_cast<int>(session.player);
+  ai.pathAnchor = {dw * 0.5f, dh * 0.8f}; // feet, where the body meets the floor
   session.mobPrefabByEntity[e] = hasPrefab ? def.prefab_name : lowerAscii(mob_prefab_id);
-  nlohmann::json state = nlohmann::json::object();
-  if (hasPrefab && def.default_entity_data.is_object())
-    state = def.default_entity_data;
-  if (!state.contains("brain_type"))
-    state["brain_type"] = hasPrefab ? "simple_chase_player" : "simple";
-  state["base_scale_x"] = tr ? tr->scale_x : 1.f;
-  state["base_scale_y"] = tr ? tr->scale_y : 1.f;
-  state["prefab_name"] = hasPrefab ? def.prefab_name : lowerAscii(mob_prefab_id);
-  session.mobEntityDataByEntity[e] = std::move(state);
+  PropertyBlock &props =
+      w.AddComponent<MobProperties>(e, SubterraMobPropertySchema(hasPrefab ? &def : nullptr)).props;
+  if (hasPrefab)
+    props.Assign(def.default_entity_data);
+  if (!props.Has(kPropBrainType))
+    props.SetString(kPropBrainType, hasPrefab ? "simple_chase_player" : "simple");
+  props.SetFloat(kPropBaseScaleX, tr ? tr->scale_x : 1.f);
+  props.SetFloat(kPropBaseScaleY, tr ? tr->scale_y : 1.f);
+  props.SetString(kPropPrefabName, session.mobPrefabByEntity[e]);
 }
 
 void SpawnMobsAround(SubterraSession &session, float cx, float cy, int count) {
@@ -263,17 +269,19 @@ void RegisterAuthoringMobSessionState(SubterraSession &session) {
     SubterraMobPrefabDef def{};
     const bool hasPrefab = SubterraMobTryGetPrefabDef(prefabKey, def);
     session.mobPrefabByEntity[id] = hasPrefab ? def.prefab_name : prefabKey;
-    nlohmann::json state = nlohmann::json::object();
-    if (hasPrefab && def.default_entity_data.is_object())
-      state = def.default_entity_data;
+    PropertyBlock &props =
+        session.world
+            ->AddComponent<MobProperties>(id, SubterraMobPropertySchema(hasPrefab ? &def : nullptr))
+            .props;
+    if (hasPrefab)
+      props.Assign(def.default_entity_data);
     if (auto *tr = session.world->GetComponent<Transform>(id)) {
-      state["base_scale_x"] = tr->scale_x;
-      state["base_scale_y"] = tr->scale_y;
+      props.SetFloat(kPropBaseScaleX, tr->scale_x);
+      props.SetFloat(kPropBaseScaleY, tr->scale_y);
     }
-    if (!state.contains("brain_type"))
-      state["brain_type"] = hasPrefab ? "simple_chase_player" : "simple";
-    state["prefab_name"] = session.mobPrefabByEntity[id];
-    session.mobEntityDataByEntity[id] = std::move(state);
+    if (!props.Has(kPropBrainType))
+      props.SetString(kPropBrainType, hasPrefab ? "simple_chase_player" : "simple");
+    props.SetString(kPropPrefabName, session.mobPrefabByEntity[id]);
     if (session.player != ecs::NULL_ENTITY) {
       if (auto *ai = session.world->GetComponent<AIController>(id))
         ai->entityTarget = static_cast<int>(session.player);
@@ -7,6 +7,7 @@
 #include "map_events.h"
 #include "spawn_service.h"
 #include "subterra_interactable_prefabs.h"
+#include "subterra_mob_brains.h"
 #include "subterra_mob_prefabs.h"
 #include "subterra_components.h"
 #include "subterra_day_night.h"
@@ -307,6 +308,7 @@ void RegisterSubterraConsoleCommands(SubterraEngine &engine) {
     p.event_type = "manual";
     p.manual = true;
     p.event_data = std::move(data);
+    p.ResolveSymbols();
     session.mapEvents.dispatch(p);
     c.AddLogLine("Emitted manual trigger with event_data.");
   });
@@ -337,17 +339,28 @@ void RegisterSubterraConsoleCommands(SubterraEngine &engine) {
     p.event_data["light_color"] = nlohmann::json::array({r, g, b});
     p.event_data["light_radius"] = radius;
     p.event_data["light_intensity"] = intensity;
+    p.ResolveSymbols();
     session.mapEvents.dispatch(p);
     c.AddLogLine("Emitted light event payload.");
   });
 
   c.RegisterCommand("itempairs", [&c, &session](criogenio::Engine &,
                                                 const std::vector<std::string> &) {
-    c.AddLogLine("Item light overlap pairs: " +
-                 std::to_string(static_cast<int>(session.itemEventPairsInside.size())));
+    const ItemEventPairTable &pairs = session.itemEventPairs;
+    c.AddLogLine("Item light overlap pairs: " + std::to_string(pairs.InsideCount()) +
+                 " (cooling " + std::to_string(pairs.CoolingCount()) + ", capacity " +
+                 std::to_string(pairs.Capacity()) + ")");
+    const ItemLightPairStats &lp = session.itemLightBroadphase.Stats();
+    c.AddLogLine("Broadphase: " + std::to_string(lp.emitters) + " emitters, " +
+                 std::to_string(lp.targets) + " targets, " + std::to_string(lp.candidates) +
+                 " candidates, " + std::to_string(lp.pairs) + " in radius");
+    std::vector<uint64_t> keys;
+    pairs.InsideKeys(keys);
     int shown = 0;
-    for (const std::string &k : session.itemEventPairsInside) {
-      c.AddLogLine(" - " + k);
+    for (uint64_t k : keys) {
+      char buf[32];
+      std::snprintf(buf, sizeof buf, " - %016llx", static_cast<unsigned long long>(k));
+      c.AddLogLine(buf);
       shown++;
       if (shown >= 20) {
         c.AddLogLine(" ...");
@@ -356,6 +369,35 @@ void RegisterSubterraConsoleCommands(SubterraEngine &engine) {
     }
   });
 
+  c.RegisterCommand("brainlod", [&c, &session](criogenio::Engine &,
+                                               const std::vector<std::string> &args) {
+    MobBrainLodConfig &cfg = session.mobBrains.config;
+    if (args.size() >= 3) {
+      const float v = static_cast<float>(std::atof(args[2].c_str()));
+      if (args[1] == "near")
+        cfg.near_radius = std::max(0.f, v);
+      else if (args[1] == "active")
+        cfg.active_radius = std::max(0.f, v);
+      else if (args[1] == "interval")
+        cfg.far_interval_sec = std::max(0.f, v);
+      else if (args[1] == "budget")
+        cfg.far_budget_ms = std::max(0.f, v);
+      else {
+        c.AddLogLine("Usage: brainlod [near|active|interval|budget <value>]");
+        return;
+      }
+    }
+    const MobBrainLodStats &st = session.mobBrains.stats;
+    char buf[200];
+    std::snprintf(buf, sizeof buf, "near %.0f px  active %.0f px  far every %.2f s  budget %.2f ms",
+                  cfg.near_radius, cfg.active_radius, cfg.far_interval_sec, cfg.far_budget_ms);
+    c.AddLogLine(buf);
+    std::snprintf(buf, sizeof buf,
+                  "brains: near %zu  far %zu (due %zu, ran %zu in %.3f ms)  suspended %zu",
+                  st.near, st.far, st.far_due, st.far_ticked, st.far_ms, st.suspended);
+    c.AddLogLine(buf);
+  });
+
   c.RegisterCommand("istate", [&c, &session](criogenio::Engine &,
                                              const std::vector<std::string> &args) {
     const criogenio::TiledInteractable *target = nullptr;
@@ -379,9 +421,9 @@ void RegisterSubterraConsoleCommands(SubterraEngine &engine) {
       return;
     }
     const std::string key = InteractableStateKey(session.mapPath, *target);
-    nlohmann::json &entityData = EnsureInteractableEntityData(session, *target);
+    const PropertyBlock &props = EnsureInteractableProperties(session, *target);
     c.AddLogLine("Interactable key: " + key + " type: " + target->interactable_type);
-    c.AddLogLine("entity_data: " + entityData.dump());
+    c.AddLogLine("entity_data: " + props.ToJson().dump());
   });
 
   c.RegisterCommand("mstate", [&c, &session](criogenio::Engine &,
@@ -403,10 +445,9 @@ void RegisterSubterraConsoleCommands(SubterraEngine &engine) {
       return;
     }
     auto pit = session.mobPrefabByEntity.find(target);
-    auto dit = session.mobEntityDataByEntity.find(target);
+    const auto *mp = session.world->GetComponent<MobProperties>(target);
     const std::string prefab = pit != session.mobPrefabByEntity.end() ? pit->second : "(unknown)";
-    const std::string data =
-        dit != session.mobEntityDataByEntity.end() ? dit->second.dump() : std::string("{}");
+    const std::string data = mp ? mp->props.ToJson().dump() : std::string("{}");
     c.AddLogLine("mob #" + std::to_string(static_cast<int>(target)) + " prefab=" + prefab);
     c.AddLogLine("mob_state: " + data);
   });
@@ -715,7 +756,7 @@ void RegisterSubterraConsoleCommands(SubterraEngine &engine) {
       c.AddLogLine("No PlayerVitals component.");
       return;
     }
-    vit->active_statuses.clear();
+    vit->active_statuses.Clear();
     SubterraInitPlayerVitals(*vit, session.worldRules);
     if (ctrl)
       ctrl->movement_frozen = false;
@@ -741,7 +782,7 @@ void RegisterSubterraConsoleCommands(SubterraEngine &engine) {
     for (char &ch : sub)
       ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
     if (sub == "clear") {
-      vit->active_statuses.clear();
+      vit->active_statuses.Clear();
       c.AddLogLine("Cleared active statuses.");
       return;
     }
@@ -774,7 +815,7 @@ void RegisterSubterraConsoleCommands(SubterraEngine &engine) {
       char b[200];
       std::snprintf(b, sizeof b, "HP %.0f/%.0f  ST %.0f/%.0f  Food %.0f/%.0f  dead=%d  statuses=%zu",
                     vit->health, vit->health_max, vit->stamina, vit->stamina_max, vit->food_satiety,
-                    vit->food_satiety_max, vit->dead ? 1 : 0, vit->active_statuses.size());
+                    vit->food_satiety_max, vit->dead ? 1 : 0, vit->active_statuses.Size());
       c.AddLogLine(b);
       return;
     }
@@ -13,6 +13,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 namespace subterra {
 
@@ -35,46 +36,143 @@ float lightMapDarkenMatch(float outdoorFactor, double dayTime) {
   return std::clamp(x, 0.f, 1.f);
 }
 
-void drawMapLightStackScreen(criogenio::Renderer &r, const criogenio::Vec2 &screen, float wx,
-                            float wy, float radius, unsigned char rr, unsigned char gg,
-                            unsigned char bb, float effect_t, const criogenio::Camera2D &cam,
-                            float lit_mul, float rad_mul) {
-  const float flicker =
-      1.f + 0.06f * std::sin(effect_t * 7.3f + wx * 0.01f + wy * 0.007f);
+/** One additive light in window pixels; `tint.a` scales the falloff (255 = full). */
+struct LightQuad {
+  float x = 0.f;
+  float y = 0.f;
+  float radius = 0.f;
+  criogenio::Color tint;
+};
+
+float lightFlicker(float effect_t, float wx, float wy) {
+  return 1.f + 0.06f * std::sin(effect_t * 7.3f + wx * 0.01f + wy * 0.007f);
+}
+
+/*
+ * The halo used to be five concentric additive disks at radius (1 - 0.16 i) with alpha
+ * (28 - 4 i) * lit. The falloff texture bakes the same cumulative profile (100 at the centre,
+ * edges softened) so one quad tinted with alpha 100 * lit reproduces it.
+ */
+constexpr float kHaloPeak = 100.f;
+
+LightQuad mapLightQuad(const criogenio::Vec2 &screen, float wx, float wy, float radius,
+                       unsigned char rr, unsigned char gg, unsigned char bb, float effect_t,
+                       const criogenio::Camera2D &cam, float lit_mul, float rad_mul) {
   const float zoom = cam.zoom > 1e-4f ? cam.zoom : 1.f;
-  const float base_r =
-      std::clamp(radius * zoom * flicker * rad_mul * 1.1f, 10.f, 720.f);
-  r.SetRenderDrawBlendMode(criogenio::TextureBlendMode::Add);
+  LightQuad q;
+  q.x = screen.x;
+  q.y = screen.y;
+  q.radius = std::clamp(radius * zoom * lightFlicker(effect_t, wx, wy) * rad_mul * 1.1f, 10.f,
+                        720.f);
+  q.tint = {rr, gg, bb,
+            static_cast<unsigned char>(std::clamp(kHaloPeak * lit_mul, 0.f, 255.f))};
+  return q;
+}
+
+LightQuad emitterQuad(const criogenio::Vec2 &screen, float wx, float wy,
+                      const ItemLightEmitterEntry &em, float effect_t,
+                      const criogenio::Camera2D &cam, float lit_mul) {
+  const float zoom = cam.zoom > 1e-4f ? cam.zoom : 1.f;
+  LightQuad q;
+  q.x = screen.x;
+  q.y = screen.y;
+  q.radius = std::clamp(em.radius * zoom * lightFlicker(effect_t, wx, wy) * lit_mul *
+                            em.intensity * 0.55f,
+                        10.f, 640.f);
+  q.tint = {em.r, em.g, em.b,
+            static_cast<unsigned char>(
+                std::clamp(kHaloPeak * lit_mul * em.intensity, 0.f, 255.f))};
+  return q;
+}
+
+/** Cumulative disk-stack profile at normalized distance d in [0, 1], 0..1 at the centre. */
+float haloProfile(float d) {
+  constexpr float kSoft = 0.08f;
+  float sum = 0.f;
   for (int i = 0; i < 5; ++i) {
-    const float rr2 = base_r * (1.f - 0.16f * static_cast<float>(i));
-    const float a_f =
-        std::clamp((28.f - static_cast<float>(i * 4)) * lit_mul, 4.f, 230.f);
-    criogenio::Color c{rr, gg, bb, static_cast<unsigned char>(a_f)};
-    r.DrawFilledCircleScreen(screen.x, screen.y, rr2, c);
+    const float edge = 1.f - 0.16f * static_cast<float>(i);
+    const float w = 28.f - static_cast<float>(i * 4);
+    sum += w * std::clamp((edge - d) / kSoft, 0.f, 1.f);
   }
-  r.SetRenderDrawBlendMode(criogenio::TextureBlendMode::Alpha);
+  return sum / kHaloPeak;
 }
 
-void drawEmitterStackScreen(criogenio::Renderer &r, const criogenio::Vec2 &screen, float wx,
-                            float wy, const ItemLightEmission &em, float effect_t,
-                            const criogenio::Camera2D &cam, float lit_mul) {
-  const float flicker =
-      1.f + 0.06f * std::sin(effect_t * 7.3f + wx * 0.01f + wy * 0.007f);
-  const float zoom = cam.zoom > 1e-4f ? cam.zoom : 1.f;
-  const float base_r =
-      std::clamp(em.radius * zoom * flicker * lit_mul * em.intensity * 0.55f, 10.f, 640.f);
+bool ensureFalloff(SubterraLightMap &lm, criogenio::Renderer &r) {
+  if (lm.falloff.valid())
+    return true;
+  if (lm.falloffUnavailable)
+    return false;
+  constexpr int n = SubterraLightMap::kFalloffSize;
+  std::vector<uint8_t> px(static_cast<size_t>(n) * n * 4);
+  const float half = static_cast<float>(n) * 0.5f;
+  for (int y = 0; y < n; ++y) {
+    for (int x = 0; x < n; ++x) {
+      const float dx = (static_cast<float>(x) + 0.5f - half) / half;
+      const float dy = (static_cast<float>(y) + 0.5f - half) / half;
+      const float a = haloProfile(std::sqrt(dx * dx + dy * dy));
+      uint8_t *p = &px[(static_cast<size_t>(y) * n + x) * 4];
+      p[0] = p[1] = p[2] = 255;
+      p[3] = static_cast<uint8_t>(std::clamp(a * 255.f + 0.5f, 0.f, 255.f));
+    }
+  }
+  lm.falloff = r.CreateTextureFromPixels(n, n, px.data());
+  lm.falloffUnavailable = !lm.falloff.valid();
+  return lm.falloff.valid();
+}
+
+/** Fallback when no falloff texture exists: the original five-disk stack per light. */
+void drawLightDisks(criogenio::Renderer &r, const std::vector<LightQuad> &lights) {
   r.SetRenderDrawBlendMode(criogenio::TextureBlendMode::Add);
-  for (int i = 0; i < 5; ++i) {
-    const float rr = base_r * (1.f - 0.16f * static_cast<float>(i));
-    const float a_f =
-        std::clamp((28.f - static_cast<float>(i * 4)) * lit_mul * em.intensity, 4.f, 230.f);
-    criogenio::Color c{em.r, em.g, em.b,
-                         static_cast<unsigned char>(a_f)};
-    r.DrawFilledCircleScreen(screen.x, screen.y, rr, c);
+  for (const LightQuad &q : lights) {
+    const float lit = static_cast<float>(q.tint.a) / kHaloPeak;
+    for (int i = 0; i < 5; ++i) {
+      const float a_f = std::clamp((28.f - static_cast<float>(i * 4)) * lit, 4.f, 230.f);
+      r.DrawFilledCircleScreen(q.x, q.y, q.radius * (1.f - 0.16f * static_cast<float>(i)),
+                               {q.tint.r, q.tint.g, q.tint.b, static_cast<unsigned char>(a_f)});
+    }
   }
   r.SetRenderDrawBlendMode(criogenio::TextureBlendMode::Alpha);
 }
 
+void drawLightQuads(criogenio::Renderer &r, criogenio::TextureHandle falloff,
+                    const std::vector<LightQuad> &lights, float scale) {
+  const float fs = static_cast<float>(SubterraLightMap::kFalloffSize);
+  for (const LightQuad &q : lights) {
+    const float rad = q.radius * scale;
+    r.DrawTexturePro(falloff, {0.f, 0.f, fs, fs},
+                     {q.x * scale - rad, q.y * scale - rad, rad * 2.f, rad * 2.f}, {0.f, 0.f},
+                     0.f, q.tint, criogenio::TextureBlendMode::Add);
+  }
+}
+
+/** Accumulate `lights` into the low-res light map and add it over the frame. */
+void renderLightMap(SubterraLightMap &lm, criogenio::Renderer &r,
+                    const std::vector<LightQuad> &lights, float vpW, float vpH) {
+  if (!ensureFalloff(lm, r)) {
+    drawLightDisks(r, lights);
+    return;
+  }
+  const int ds = SubterraLightMap::kDownscale;
+  const int w = (static_cast<int>(vpW) + ds - 1) / ds;
+  const int h = (static_cast<int>(vpH) + ds - 1) / ds;
+  if (lm.target.valid() && (lm.target.width != w || lm.target.height != h))
+    r.DestroyRenderTarget(&lm.target);
+  if (!lm.target.valid())
+    lm.target = r.CreateRenderTarget(w, h);
+  if (!lm.target.valid()) {
+    drawLightQuads(r, lm.falloff, lights, 1.f);
+    return;
+  }
+  r.PushRenderTarget(lm.target); // cleared to transparent black
+  drawLightQuads(r, lm.falloff, lights, 1.f / static_cast<float>(ds));
+  r.PopRenderTarget();
+  // The buffer holds colour already scaled by each quad's alpha: add it straight on.
+  r.DrawTexturePro(lm.target, {0.f, 0.f, static_cast<float>(w), static_cast<float>(h)},
+                   {0.f, 0.f, static_cast<float>(w * ds), static_cast<float>(h * ds)},
+                   {0.f, 0.f}, 0.f, criogenio::Colors::White,
+                   criogenio::TextureBlendMode::AddPremultiplied);
+}
+
 } // namespace
 
 static bool localPlayerUnderRoof(const SubterraSession &session) {
@@ -247,6 +345,7 @@ void SubterraRenderAtmosphere(SubterraSession &session, criogenio::Renderer &r)
   }
 
   const criogenio::Camera2D *cam = session.world ? session.world->GetActiveCamera() : nullptr;
+  std::vector<LightQuad> lights;
   if (session.world && cam) {
     criogenio::Terrain2D *ter = session.world->GetTerrain();
     if (ter && ter->UsesGidMode() && !ter->tmxMeta.mapLightSources.empty()) {
@@ -263,8 +362,8 @@ void SubterraRenderAtmosphere(SubterraSession &session, criogenio::Renderer &r)
         }
         criogenio::Vec2 sc =
             criogenio::WorldToScreen2D({ls.x, ls.y}, *cam, vpW, vpH);
-        drawMapLightStackScreen(r, sc, ls.x, ls.y, ls.radius, ls.r, ls.g, ls.b, dn.effectTime,
-                                *cam, lit * 0.45f, radm);
+        lights.push_back(mapLightQuad(sc, ls.x, ls.y, ls.radius, ls.r, ls.g, ls.b,
+                                      dn.effectTime, *cam, lit * 0.45f, radm));
       }
     }
   }
@@ -273,7 +372,7 @@ void SubterraRenderAtmosphere(SubterraSession &session, criogenio::Renderer &r)
     auto emitterIds = session.world->GetEntitiesWith<ItemLightEmitterState, criogenio::Transform>();
     for (criogenio::ecs::EntityId eid : emitterIds) {
       auto *state = session.world->GetComponent<ItemLightEmitterState>(eid);
-      auto *tr = session.world->GetComponent<criogenio::Transform>(eid);
+      const auto *tr = session.world->ReadComponent<criogenio::Transform>(eid);
       if (!state || !tr || !state->enabled || state->emitters.empty())
         continue;
 
@@ -282,23 +381,33 @@ void SubterraRenderAtmosphere(SubterraSession &session, criogenio::Renderer &r)
       if (eid == session.player) {
         wx += static_cast<float>(session.playerW) * 0.5f;
         wy += static_cast<float>(session.playerH) * 0.5f;
-      } else if (auto *pk = session.world->GetComponent<criogenio::WorldPickup>(eid)) {
+      } else if (const auto *pk = session.world->ReadComponent<criogenio::WorldPickup>(eid)) {
         wx += pk->width * 0.5f;
         wy += pk->height * 0.5f;
       }
       const criogenio::Vec2 sc = criogenio::WorldToScreen2D({wx, wy}, *cam, vpW, vpH);
-      for (const ItemLightEmitterEntry &entry : state->emitters) {
-        ItemLightEmission em{};
-        em.valid = true;
-        em.radius = entry.radius;
-        em.intensity = entry.intensity;
-        em.r = entry.r;
-        em.g = entry.g;
-        em.b = entry.b;
-        drawEmitterStackScreen(r, sc, wx, wy, em, dn.effectTime, *cam, 1.f);
-      }
+      for (const ItemLightEmitterEntry &entry : state->emitters)
+        lights.push_back(emitterQuad(sc, wx, wy, entry, dn.effectTime, *cam, 1.f));
     }
   }
+
+  // Off-screen lights add nothing; drop them before they cost a quad.
+  std::erase_if(lights, [&](const LightQuad &q) {
+    return q.tint.a == 0 || q.x + q.radius < 0.f || q.y + q.radius < 0.f ||
+           q.x - q.radius > vpW || q.y - q.radius > vpH;
+  });
+  session.lightMap.lightsLastFrame = lights.size();
+  if (!lights.empty())
+    renderLightMap(session.lightMap, r, lights, vpW, vpH);
+}
+
+void SubterraReleaseLightMap(SubterraLightMap &lm, criogenio::Renderer &renderer) {
+  if (lm.target.valid())
+    renderer.DestroyRenderTarget(&lm.target);
+  if (lm.falloff.valid())
+    renderer.UnloadTexture(&lm.falloff);
+  lm.falloffUnavailable = false;
+  lm.lightsLastFrame = 0;
 }
 
 } // namespace subterra
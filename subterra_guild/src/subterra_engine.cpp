@@ -9,6 +9,7 @@
 #include "subterra_session.h"
 #include "game_ui.h"
 #include "input.h"
+#include "profiler.h"
 #include <SDL3/SDL.h>
 #include <cstdio>
 
@@ -20,6 +21,7 @@ SubterraEngine::SubterraEngine(SubterraSession &session, int width, int height,
 
 SubterraEngine::~SubterraEngine() {
   SubterraUnregisterMovementHooks();
+  SubterraReleaseLightMap(session_->lightMap, GetRenderer());
   SubterraImGuiShutdown();
 }
 
@@ -29,9 +31,15 @@ void SubterraEngine::RegisterDebugCommands() {
 }
 
 void SubterraEngine::OnFrame(float dt) {
-  SubterraGameplayQueuesTick(*session_, dt);
+  {
+    CRIO_PROFILE_ZONE("Subterra::GameplayQueues");
+    SubterraGameplayQueuesTick(*session_, dt);
+  }
   SubterraInputHotReloadTick(*session_, dt);
-  SubterraUpdateOutdoorFactor(*session_, dt);
+  {
+    CRIO_PROFILE_ZONE("Subterra::OutdoorFactor");
+    SubterraUpdateOutdoorFactor(*session_, dt);
+  }
   SubterraAdvanceDayNight(session_->dayNight, dt);
   if (dt > 1e-6f) {
     const float instFps = 1.f / dt;
@@ -40,7 +48,10 @@ void SubterraEngine::OnFrame(float dt) {
 }
 
 void SubterraEngine::OnAfterWorldRender(criogenio::Renderer &renderer) {
-  SubterraRenderAtmosphere(*session_, renderer);
+  {
+    CRIO_PROFILE_ZONE("Subterra::Atmosphere");
+    SubterraRenderAtmosphere(*session_, renderer);
+  }
   renderer.SetRenderDrawBlendMode(criogenio::TextureBlendMode::Alpha);
 }
 
@@ -82,6 +93,17 @@ void SubterraEngine::OnGUI() {
                   SubterraDayPhaseName(dn.dayTime, dn.dayPhaseSize).c_str(),
                   static_cast<double>(dn.outdoorFactor));
     r.DrawDebugText(8.f, 38.f, dayBuf);
+    const ItemLightPairStats &lp = session_->itemLightBroadphase.Stats();
+    char lightBuf[128];
+    std::snprintf(lightBuf, sizeof lightBuf,
+                  "light pairs %zu  candidates %zu  (%zu emitters x %zu targets)", lp.pairs,
+                  lp.candidates, lp.emitters, lp.targets);
+    r.DrawDebugText(8.f, 54.f, lightBuf);
+    const MobBrainLodStats &bs = session_->mobBrains.stats;
+    char brainBuf[128];
+    std::snprintf(brainBuf, sizeof brainBuf, "brains near %zu  far %zu/%zu due  suspended %zu",
+                  bs.near, bs.far_ticked, bs.far_due, bs.suspended);
+    r.DrawDebugText(8.f, 70.f, brainBuf);
   }
   if (session_->world && session_->player != criogenio::ecs::NULL_ENTITY) {
     if (auto *inv = session_->world->GetComponent<Inventory>(session_->player)) {
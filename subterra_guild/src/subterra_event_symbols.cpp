@@ -0,0 +1,140 @@
+#include "subterra_event_symbols.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace subterra {
+namespace {
+
+struct SymbolTable {
+  std::unordered_map<std::string, EventSymbol> ids;
+  std::vector<std::string> names{std::string()}; // index 0 = kNoEventSymbol
+};
+
+SymbolTable &symbols() {
+  static SymbolTable table;
+  return table;
+}
+
+const std::string &lowered(std::string_view name) {
+  static thread_local std::string buf;
+  buf.assign(name.begin(), name.end());
+  for (char &c : buf)
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  return buf;
+}
+
+} // namespace
+
+EventSymbol InternEventSymbol(std::string_view name) {
+  if (name.empty())
+    return kNoEventSymbol;
+  SymbolTable &t = symbols();
+  const std::string &key = lowered(name);
+  auto it = t.ids.find(key);
+  if (it != t.ids.end())
+    return it->second;
+  const EventSymbol sym = static_cast<EventSymbol>(t.names.size());
+  t.names.push_back(key);
+  t.ids.emplace(key, sym);
+  return sym;
+}
+
+EventSymbol FindEventSymbol(std::string_view name) {
+  if (name.empty())
+    return kNoEventSymbol;
+  const SymbolTable &t = symbols();
+  auto it = t.ids.find(lowered(name));
+  return it == t.ids.end() ? kNoEventSymbol : it->second;
+}
+
+const std::string &EventSymbolName(EventSymbol sym) {
+  const SymbolTable &t = symbols();
+  return sym < t.names.size() ? t.names[sym] : t.names[0];
+}
+
+EventPredicate EventPredicate::Compile(const nlohmann::json &required) {
+  EventPredicate pred;
+  if (!required.is_object())
+    return pred;
+  pred.requiresObject_ = true;
+  for (auto it = required.begin(); it != required.end(); ++it) {
+    if (it->is_null())
+      continue;
+    Instr in;
+    in.key = it.key();
+    if (it->is_boolean()) {
+      in.op = Op::Bool;
+      in.flag = it->get<bool>();
+    } else if (it->is_number()) {
+      in.op = Op::Number;
+      in.number = it->get<double>();
+    } else if (it->is_string()) {
+      in.op = Op::String;
+      in.text = it->get<std::string>();
+    } else {
+      in.op = Op::Json;
+      in.value = *it;
+    }
+    pred.code_.push_back(std::move(in));
+  }
+  return pred;
+}
+
+bool EventPredicate::Matches(const nlohmann::json &eventData) const {
+  if (!requiresObject_)
+    return true;
+  if (!eventData.is_object())
+    return false;
+  for (const Instr &in : code_) {
+    auto jt = eventData.find(in.key);
+    if (jt == eventData.end())
+      return false;
+    switch (in.op) {
+    case Op::Bool:
+      if (!jt->is_boolean() || jt->get<bool>() != in.flag)
+        return false;
+      break;
+    case Op::Number:
+      if (!jt->is_number() || jt->get<double>() != in.number)
+        return false;
+      break;
+    case Op::String:
+      if (!jt->is_string() || jt->get_ref<const std::string &>() != in.text)
+        return false;
+      break;
+    case Op::Json:
+      if (*jt != in.value)
+        return false;
+      break;
+    }
+  }
+  return true;
+}
+
+void EventListenerIndex::Add(EventSymbol event, const std::string &prefab, uint32_t listener) {
+  if (event == kNoEventSymbol)
+    return;
+  byEvent_[event].push_back({prefab, listener});
+}
+
+void EventListenerIndex::Collect(const EventSymbolSet &syms,
+                                 std::vector<const Ref *> &out) const {
+  const size_t first = out.size();
+  const EventSymbol all[3] = {syms.trigger, syms.id, syms.type};
+  for (int i = 0; i < 3; ++i) {
+    if (all[i] == kNoEventSymbol || (i > 0 && all[i] == all[0]) || (i > 1 && all[i] == all[1]))
+      continue;
+    auto it = byEvent_.find(all[i]);
+    if (it == byEvent_.end())
+      continue;
+    for (const Ref &r : it->second)
+      out.push_back(&r);
+  }
+  std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+            [](const Ref *a, const Ref *b) {
+              return a->prefab != b->prefab ? a->prefab < b->prefab : a->listener < b->listener;
+            });
+}
+
+} // namespace subterra
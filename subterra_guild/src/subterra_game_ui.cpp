@@ -118,12 +118,12 @@ void SubterraGameUiDrawInventory(SubterraSession &session, criogenio::GameUi &ui
                   vit->food_satiety_max);
     ui.text(x, y, line, criogenio::Colors::White);
     y += 14.f;
-    if (!vit->active_statuses.empty()) {
+    if (!vit->active_statuses.Empty()) {
       ui.text(x, y, "Statuses:", criogenio::Colors::White);
       y += 14.f;
-      for (const auto &st : vit->active_statuses) {
-        if (!st.flag.empty()) {
-          ui.text(x + 8.f, y, st.flag.c_str(), criogenio::Colors::White);
+      for (const std::string &flag : vit->active_statuses.flag) {
+        if (!flag.empty()) {
+          ui.text(x + 8.f, y, flag.c_str(), criogenio::Colors::White);
           y += 14.f;
         }
       }
@@ -4,6 +4,7 @@
 #include "gameplay_tags.h"
 #include "input.h"
 #include "spawn_service.h"
+#include "subterra_mob_prefabs.h"
 #include "subterra_camera.h"
 #include "subterra_player_vitals.h"
 #include "subterra_session.h"
@@ -239,6 +240,18 @@ static void actionDamagePlayer(SubterraGameplayContext &ctx) {
   sessionLog(ctx.session, "Player took damage (gameplay action).");
 }
 
+/** Properties for an interactable key; seeded from the prefab when the interactable is on the map. */
+static PropertyBlock &interactablePropertiesFor(SubterraSession &session, const std::string &key) {
+  auto found = session.interactablePropertiesByKey.find(key);
+  if (found != session.interactablePropertiesByKey.end())
+    return found->second;
+  for (const criogenio::TiledInteractable &it : session.tiledInteractables) {
+    if (InteractableStateKey(session.mapPath, it) == key)
+      return EnsureInteractableProperties(session, it);
+  }
+  return session.interactablePropertiesByKey[key];
+}
+
 static void actionUnlockDoor(SubterraGameplayContext &ctx) {
   if (!ctx.actionParams.contains("interactable_key") ||
       !ctx.actionParams["interactable_key"].is_string())
@@ -246,14 +259,12 @@ static void actionUnlockDoor(SubterraGameplayContext &ctx) {
   const std::string key = ctx.actionParams["interactable_key"].get<std::string>();
   if (key.empty())
     return;
-  nlohmann::json &entityData = ctx.session.interactableEntityDataByKey[key];
-  if (!entityData.is_object())
-    entityData = nlohmann::json::object();
-  entityData["locked"] = false;
+  PropertyBlock &props = interactablePropertiesFor(ctx.session, key);
+  props.SetBool(InternPropertyName("locked"), false);
   if (ctx.actionParams.contains("open_after_unlock") &&
       ctx.actionParams["open_after_unlock"].is_boolean() &&
       ctx.actionParams["open_after_unlock"].get<bool>()) {
-    entityData["open"] = true;
+    props.SetBool(InternPropertyName("open"), true);
     std::uint8_t &flags = ctx.session.interactableStateFlags[key];
     flags |= InteractableState::Open;
   }
@@ -274,10 +285,7 @@ static void actionSetInteractableState(SubterraGameplayContext &ctx) {
     field = ctx.actionParams["field"].get<std::string>();
   if (field.empty() || !ctx.actionParams.contains("value"))
     return;
-  nlohmann::json &entityData = ctx.session.interactableEntityDataByKey[key];
-  if (!entityData.is_object())
-    entityData = nlohmann::json::object();
-  entityData[field] = ctx.actionParams["value"];
+  interactablePropertiesFor(ctx.session, key).SetJson(field, ctx.actionParams["value"]);
   if ((field == "open" || field == "burning") && ctx.actionParams["value"].is_boolean()) {
     const bool on = ctx.actionParams["value"].get<bool>();
     std::uint8_t &flags = ctx.session.interactableStateFlags[key];
@@ -303,9 +311,10 @@ static void actionShowHideEnemyOnLightRange(SubterraGameplayContext &ctx) {
   const auto mobId = static_cast<criogenio::ecs::EntityId>(ctx.actionParams["mob_entity_id"].get<int>());
   if (!ctx.session.world->HasEntity(mobId))
     return;
-  nlohmann::json &state = ctx.session.mobEntityDataByEntity[mobId];
-  if (!state.is_object())
-    state = nlohmann::json::object();
+  auto *mp = ctx.session.world->GetComponent<MobProperties>(mobId);
+  if (!mp)
+    mp = &ctx.session.world->AddComponent<MobProperties>(mobId, SubterraMobPropertySchema(nullptr));
+  PropertyBlock &props = mp->props;
   bool visible = true;
   if (ctx.actionParams.contains("visible") && ctx.actionParams["visible"].is_boolean())
     visible = ctx.actionParams["visible"].get<bool>();
@@ -316,15 +325,17 @@ static void actionShowHideEnemyOnLightRange(SubterraGameplayContext &ctx) {
     else if (ev.contains("inside_light") && ev["inside_light"].is_boolean())
       visible = ev["inside_light"].get<bool>();
   }
-  state["hidden"] = !visible;
+  props.SetBool(InternPropertyName("hidden"), !visible);
   auto *tr = ctx.session.world->GetComponent<criogenio::Transform>(mobId);
   if (tr) {
-    if (!state.contains("base_scale_x"))
-      state["base_scale_x"] = tr->scale_x;
-    if (!state.contains("base_scale_y"))
-      state["base_scale_y"] = tr->scale_y;
-    const float sx = state["base_scale_x"].is_number() ? state["base_scale_x"].get<float>() : 1.f;
-    const float sy = state["base_scale_y"].is_number() ? state["base_scale_y"].get<float>() : 1.f;
+    const PropertyId baseX = InternPropertyName("base_scale_x");
+    const PropertyId baseY = InternPropertyName("base_scale_y");
+    if (!props.Has(baseX))
+      props.SetFloat(baseX, tr->scale_x);
+    if (!props.Has(baseY))
+      props.SetFloat(baseY, tr->scale_y);
+    const float sx = props.GetFloat(baseX, 1.f);
+    const float sy = props.GetFloat(baseY, 1.f);
     tr->scale_x = visible ? sx : 0.0001f;
     tr->scale_y = visible ? sy : 0.0001f;
   }
@@ -341,11 +352,8 @@ static void actionAttackPlayer(SubterraGameplayContext &ctx) {
     amount = ctx.actionParams["damage"].get<float>();
   if (ctx.actionParams.contains("mob_entity_id") && ctx.actionParams["mob_entity_id"].is_number_integer()) {
     const auto mobId = static_cast<criogenio::ecs::EntityId>(ctx.actionParams["mob_entity_id"].get<int>());
-    auto it = ctx.session.mobEntityDataByEntity.find(mobId);
-    if (it != ctx.session.mobEntityDataByEntity.end() && it->second.is_object() &&
-        it->second.contains("attack_damage") && it->second["attack_damage"].is_number()) {
-      amount = it->second["attack_damage"].get<float>();
-    }
+    if (const auto *mp = ctx.session.world->GetComponent<MobProperties>(mobId))
+      amount = mp->props.GetFloat(InternPropertyName("attack_damage"), amount);
   }
   v->health = std::max(0.f, v->health - amount);
 }
@@ -490,7 +490,7 @@ void SubterraImGuiDrawEntityInspector(SubterraSession &session) {
       auto *tr = session.world->GetComponent<criogenio::Transform>(id);
       auto *nm = session.world->GetComponent<criogenio::Name>(id);
       auto prefIt = session.mobPrefabByEntity.find(id);
-      auto dataIt = session.mobEntityDataByEntity.find(id);
+      const auto *mp = session.world->GetComponent<MobProperties>(id);
       if (tr) {
         ImGui::Text("entity #%d", static_cast<int>(id));
         ImGui::Text("name: %s", nm ? nm->name.c_str() : "(none)");
@@ -499,16 +499,11 @@ void SubterraImGuiDrawEntityInspector(SubterraSession &session) {
                                                                : "(unknown)");
         ImGui::Text("position: (%.1f, %.1f)", tr->x, tr->y);
         ImGui::Text("scale: %.2f %.2f", tr->scale_x, tr->scale_y);
-        if (dataIt != session.mobEntityDataByEntity.end() && dataIt->second.is_object()) {
-          const auto &st = dataIt->second;
+        if (mp) {
+          static const std::string kNone = "(none)";
           const char *brain =
-              (st.contains("brain_type") && st["brain_type"].is_string())
-                  ? st["brain_type"].get_ref<const std::string &>().c_str()
-                  : "(none)";
-          const bool hidden =
-              st.contains("hidden") &&
-              ((st["hidden"].is_boolean() && st["hidden"].get<bool>()) ||
-               (st["hidden"].is_number_integer() && st["hidden"].get<int>() != 0));
+              mp->props.GetString(FindPropertyName("brain_type"), kNone).c_str();
+          const bool hidden = mp->props.GetBool(FindPropertyName("hidden"), false);
           ImGui::Text("brain: %s", brain);
           ImGui::Text("hidden: %s", hidden ? "yes" : "no");
         }
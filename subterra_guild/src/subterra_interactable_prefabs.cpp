@@ -1,6 +1,7 @@
 #include "subterra_interactable_prefabs.h"
 #include "json.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <fstream>
 #include <iterator>
@@ -15,6 +16,7 @@ namespace {
 std::unordered_set<std::string> g_interactablePrefabIds;
 std::unordered_map<std::string, SubterraInteractableRestDef> g_interactableRest;
 std::unordered_map<std::string, SubterraInteractablePrefabDef> g_interactableDefs;
+EventListenerIndex g_interactableListeners;
 
 std::string lowerAscii(std::string s) {
   for (char &c : s)
@@ -83,18 +85,29 @@ bool typeFieldIsInteractableEventListener(const nlohmann::json &el) {
   return v == "interactable_event_listener";
 }
 
+std::shared_ptr<const PropertySchema> buildInteractableSchema(const nlohmann::json &defaults) {
+  auto schema = std::make_shared<PropertySchema>();
+  schema->DeclareFrom(defaults);
+  schema->Declare(InternPropertyName("open"), PropertyType::Bool);
+  schema->Declare(InternPropertyName("burning"), PropertyType::Bool);
+  schema->Declare(InternPropertyName("locked"), PropertyType::Bool);
+  return schema;
+}
+
 } // namespace
 
 void SubterraInteractablePrefabsClear() {
   g_interactablePrefabIds.clear();
   g_interactableRest.clear();
   g_interactableDefs.clear();
+  g_interactableListeners.Clear();
 }
 
 bool SubterraInteractablePrefabsTryLoadFromPath(const std::string &path) {
   g_interactablePrefabIds.clear();
   g_interactableRest.clear();
   g_interactableDefs.clear();
+  g_interactableListeners.Clear();
   std::ifstream f(path, std::ios::binary);
   if (!f)
     return false;
@@ -129,6 +142,7 @@ bool SubterraInteractablePrefabsTryLoadFromPath(const std::string &path) {
     def.event_listeners.clear();
     if (el.contains("entity_data") && el["entity_data"].is_object())
       def.default_entity_data = el["entity_data"];
+    def.property_schema = buildInteractableSchema(def.default_entity_data);
     if (el.contains("event_listeners") && el["event_listeners"].is_array()) {
       for (const auto &evt : el["event_listeners"]) {
         if (!evt.is_object())
@@ -142,6 +156,8 @@ bool SubterraInteractablePrefabsTryLoadFromPath(const std::string &path) {
         listener.action = evt["action"].get<std::string>();
         if (evt.contains("required_data") && evt["required_data"].is_object())
           listener.required_data = evt["required_data"];
+        listener.event_sym = InternEventSymbol(listener.event);
+        listener.predicate = EventPredicate::Compile(listener.required_data);
         def.event_listeners.push_back(std::move(listener));
       }
     }
@@ -171,6 +187,10 @@ bool SubterraInteractablePrefabsTryLoadFromPath(const std::string &path) {
       g_interactableRest[pkey] = rd;
     }
   }
+  for (const auto &[key, def] : g_interactableDefs) {
+    for (size_t i = 0; i < def.event_listeners.size(); ++i)
+      g_interactableListeners.Add(def.event_listeners[i].event_sym, key, static_cast<uint32_t>(i));
+  }
   return true;
 }
 
@@ -190,6 +210,13 @@ bool SubterraInteractableTryGetRest(std::string_view interactable_type_normalize
   return true;
 }
 
+float SubterraInteractableMaxRestRadius() {
+  float r = 0.f;
+  for (const auto &[key, rd] : g_interactableRest)
+    r = std::max(r, rd.rest_radius);
+  return r;
+}
+
 bool SubterraInteractableTryGetPrefabDef(std::string_view interactable_type_normalized,
                                          SubterraInteractablePrefabDef &out) {
   const std::string key = lowerAsciiView(interactable_type_normalized);
@@ -200,6 +227,23 @@ bool SubterraInteractableTryGetPrefabDef(std::string_view interactable_type_norm
   return true;
 }
 
+const SubterraInteractablePrefabDef *
+SubterraInteractableFindPrefabDef(std::string_view interactable_type_normalized) {
+  auto it = g_interactableDefs.find(lowerAsciiView(interactable_type_normalized));
+  return it == g_interactableDefs.end() ? nullptr : &it->second;
+}
+
+const EventListenerIndex &SubterraInteractableEventListeners() { return g_interactableListeners; }
+
+std::shared_ptr<const PropertySchema>
+SubterraInteractablePropertySchema(const SubterraInteractablePrefabDef *def) {
+  if (def && def->property_schema)
+    return def->property_schema;
+  static const std::shared_ptr<const PropertySchema> kRuntimeOnly =
+      buildInteractableSchema(nlohmann::json::object());
+  return kRuntimeOnly;
+}
+
 bool SubterraInteractableTryGetDefaultEntityData(std::string_view interactable_type_normalized,
                                                  nlohmann::json &out) {
   SubterraInteractablePrefabDef def;
@@ -1,6 +1,8 @@
 #include "subterra_item_event_dispatch.h"
 
 #include "components.h"
+#include "item_event_pair_table.h"
+#include "item_light_broadphase.h"
 #include "map_events.h"
 #include "subterra_item_light.h"
 #include "subterra_item_light_runtime.h"
@@ -13,7 +15,6 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 namespace subterra {
@@ -21,6 +22,7 @@ namespace {
 
 struct ActiveLightEmitter {
   std::string prefab;
+  uint64_t prefab_hash = 0;
   int source_entity_id = 0;
   float x = 0.f;
   float y = 0.f;
@@ -29,18 +31,6 @@ struct ActiveLightEmitter {
 
 using DataProviderFn = std::function<void(const ItemEventBuildContext &, nlohmann::json &)>;
 
-float dist2(float ax, float ay, float bx, float by) {
-  const float dx = ax - bx;
-  const float dy = ay - by;
-  return dx * dx + dy * dy;
-}
-
-std::string pairKey(const ActiveLightEmitter &em, const std::string &event,
-                    const std::string &targetType, int targetId) {
-  return std::to_string(em.source_entity_id) + "|" + em.prefab + "|" + event + "|" + targetType +
-         "|" + std::to_string(targetId);
-}
-
 std::string lowerAscii(std::string s) {
   for (char &c : s)
     c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
@@ -73,7 +63,7 @@ void collectActiveEmitters(SubterraSession &session, std::vector<ActiveLightEmit
   auto emitterIds = session.world->GetEntitiesWith<ItemLightEmitterState, criogenio::Transform>();
   for (criogenio::ecs::EntityId id : emitterIds) {
     auto *state = session.world->GetComponent<ItemLightEmitterState>(id);
-    auto *tr = session.world->GetComponent<criogenio::Transform>(id);
+    const auto *tr = session.world->ReadComponent<criogenio::Transform>(id);
     if (!state || !tr || !state->enabled || state->emitters.empty())
       continue;
 
@@ -82,7 +72,7 @@ void collectActiveEmitters(SubterraSession &session, std::vector<ActiveLightEmit
     if (id == session.player) {
       ex += static_cast<float>(session.playerW) * 0.5f;
       ey += static_cast<float>(session.playerH) * 0.5f;
-    } else if (auto *pk = session.world->GetComponent<WorldPickup>(id)) {
+    } else if (const auto *pk = session.world->ReadComponent<WorldPickup>(id)) {
       ex += pk->width * 0.5f;
       ey += pk->height * 0.5f;
     }
@@ -90,6 +80,7 @@ void collectActiveEmitters(SubterraSession &session, std::vector<ActiveLightEmit
     for (const ItemLightEmitterEntry &entry : state->emitters) {
       ActiveLightEmitter a;
       a.prefab = lowerAscii(entry.source_item_prefab);
+      a.prefab_hash = ItemEventPrefabHash(a.prefab);
       a.source_entity_id = static_cast<int>(id);
       a.x = ex;
       a.y = ey;
@@ -123,35 +114,28 @@ void SubterraItemEventDispatchTick(SubterraSession &session, float dt) {
   if (!session.world)
     return;
   session.itemEventDispatchClockSec += std::max(0.f, dt);
+  const uint64_t nowMs =
+      static_cast<uint64_t>(std::llround(static_cast<double>(session.itemEventDispatchClockSec) * 1000.0));
+  session.itemEventPairs.BeginFrame(nowMs);
 
   std::vector<ActiveLightEmitter> emitters;
   collectActiveEmitters(session, emitters);
-  std::unordered_set<std::string> insideNow;
 
-  auto dispatchForTarget = [&](const ActiveLightEmitter &em, const std::string &targetType, int targetId,
-                               const std::vector<ItemEventDispatchDef> &defs,
-                               const nlohmann::json &dispatchParams = nlohmann::json::object()) {
+  auto dispatchForTarget = [&](const ActiveLightEmitter &em, ItemEventTarget target, int targetId,
+                               const std::vector<ItemEventDispatchDef> &defs) {
     for (const ItemEventDispatchDef &def : defs) {
       if (def.event.empty())
         continue;
-      const std::string pk = pairKey(em, def.event, targetType, targetId);
-      insideNow.insert(pk);
-      const bool wasInside = session.itemEventPairsInside.count(pk) != 0;
-      const std::string when = def.event_trigger_when.empty() ? "on_collision_enter" : def.event_trigger_when;
-      bool shouldDispatch = false;
-      if (when == "on_collision_enter" || when == "on_overlap_enter")
-        shouldDispatch = !wasInside;
-      else if (when == "on_collision_stay" || when == "on_overlap_stay")
-        shouldDispatch = true;
-      if (!shouldDispatch)
+      const uint64_t pk =
+          ItemEventPairKey(static_cast<uint32_t>(em.source_entity_id), em.prefab_hash,
+                           def.event_sym, target, static_cast<uint32_t>(targetId));
+      const bool wasInside = session.itemEventPairs.Touch(pk);
+      if (def.when == ItemEventWhen::Never || (def.when == ItemEventWhen::Enter && wasInside))
         continue;
-      const float now = session.itemEventDispatchClockSec;
-      const int cooldownMs = def.cooldown_ms > 0 ? def.cooldown_ms : 250;
-      const float cooldownSec = static_cast<float>(cooldownMs) / 1000.f;
-      auto cd = session.itemEventCooldownUntilSec.find(pk);
-      if (cd != session.itemEventCooldownUntilSec.end() && cd->second > now)
+      if (session.itemEventPairs.Cooling(pk))
         continue;
-      session.itemEventCooldownUntilSec[pk] = now + cooldownSec;
+      const int cooldownMs = def.cooldown_ms > 0 ? def.cooldown_ms : 250;
+      session.itemEventPairs.StartCooldown(pk, nowMs + static_cast<uint64_t>(cooldownMs));
 
       ItemEventBuildContext ctx;
       ctx.source_item_prefab = em.prefab;
@@ -163,55 +147,87 @@ void SubterraItemEventDispatchTick(SubterraSession &session, float dt) {
       ctx.light_r = em.light.r;
       ctx.light_g = em.light.g;
       ctx.light_b = em.light.b;
-      ctx.target_type = targetType;
+      ctx.target_type = target == ItemEventTarget::Mob ? "mob" : "interactable";
       ctx.target_id = targetId;
-      ctx.dispatch_params = def.params.is_object() ? def.params : dispatchParams;
+      ctx.dispatch_params = def.params.is_object() ? def.params : nlohmann::json::object();
 
       MapEventPayload p;
       p.event_trigger = def.event;
       p.event_type = "item_dispatch";
       p.event_id = def.event;
       p.manual = false;
+      static const EventSymbol kItemDispatchSym = InternEventSymbol("item_dispatch");
+      p.symbols = {def.event_sym, def.event_sym, kItemDispatchSym};
+      p.symbols_resolved = true;
       SubterraItemEventBuildData(def.event_action_get_data, ctx, p.event_data);
       session.mapEvents.dispatch(p);
     }
   };
 
-  for (const ActiveLightEmitter &em : emitters) {
+  // Broadphase: only emitters with dispatch defs, bucketed by the largest emission radius.
+  static thread_local std::vector<const std::vector<ItemEventDispatchDef> *> emitterDefs;
+  static thread_local std::vector<criogenio::Vec2> centers;
+  static thread_local std::vector<float> radii;
+  static thread_local std::vector<ItemLightBroadphase::Pair> hits;
+  emitterDefs.clear();
+  centers.clear();
+  radii.clear();
+  hits.clear();
+  size_t kept = 0;
+  for (size_t i = 0; i < emitters.size(); ++i) {
     const std::vector<ItemEventDispatchDef> *defs = nullptr;
-    if (!SubterraItemLight::TryGetEventDispatchDefs(em.prefab, defs) || !defs || defs->empty())
+    if (!SubterraItemLight::TryGetEventDispatchDefs(emitters[i].prefab, defs) || !defs ||
+        defs->empty())
       continue;
-
-    const float rr2 = em.light.radius * em.light.radius;
-
-    for (const auto &it : session.tiledInteractables) {
-      float tx = it.is_point ? it.x : it.x + it.w * 0.5f;
-      float ty = it.is_point ? it.y : it.y + it.h * 0.5f;
-      if (dist2(em.x, em.y, tx, ty) > rr2)
-        continue;
-      dispatchForTarget(em, "interactable", it.tiled_object_id, *defs);
+    if (kept != i)
+      emitters[kept] = std::move(emitters[i]);
+    emitterDefs.push_back(defs);
+    centers.push_back({emitters[kept].x, emitters[kept].y});
+    radii.push_back(emitters[kept].light.radius);
+    ++kept;
+  }
+  emitters.resize(kept);
+  ItemLightBroadphase &broadphase = session.itemLightBroadphase;
+  broadphase.Build(centers, radii);
+
+  // Targets are numbered interactables first, then mobs, so sorting the pairs by
+  // (emitter, target) keeps the emitter-major dispatch order of the full scan.
+  const uint32_t mobBase = static_cast<uint32_t>(session.tiledInteractables.size());
+  static thread_local std::vector<criogenio::ecs::EntityId> mobIds;
+  mobIds.clear();
+  if (!emitters.empty()) {
+    for (uint32_t i = 0; i < mobBase; ++i) {
+      const criogenio::TiledInteractable &it = session.tiledInteractables[i];
+      const float tx = it.is_point ? it.x : it.x + it.w * 0.5f;
+      const float ty = it.is_point ? it.y : it.y + it.h * 0.5f;
+      broadphase.Collect(tx, ty, i, hits);
     }
-
-    auto mobIds = session.world->GetEntitiesWith<MobTag, criogenio::Transform>();
-    for (criogenio::ecs::EntityId mobId : mobIds) {
-      auto *tr = session.world->GetComponent<criogenio::Transform>(mobId);
+    mobIds = session.world->GetEntitiesWith<MobTag, criogenio::Transform>();
+    for (size_t j = 0; j < mobIds.size(); ++j) {
+      const auto *tr = session.world->ReadComponent<criogenio::Transform>(mobIds[j]);
       if (!tr)
         continue;
       const float mx = tr->x + static_cast<float>(session.playerW) * tr->scale_x * 0.5f;
       const float my = tr->y + static_cast<float>(session.playerH) * tr->scale_y * 0.5f;
-      if (dist2(em.x, em.y, mx, my) > rr2)
-        continue;
-      dispatchForTarget(em, "mob", static_cast<int>(mobId), *defs);
+      broadphase.Collect(mx, my, mobBase + static_cast<uint32_t>(j), hits);
     }
+    std::sort(hits.begin(), hits.end(),
+              [](const ItemLightBroadphase::Pair &a, const ItemLightBroadphase::Pair &b) {
+                return a.emitter != b.emitter ? a.emitter < b.emitter : a.target < b.target;
+              });
   }
 
-  session.itemEventPairsInside = std::move(insideNow);
-  for (auto it = session.itemEventCooldownUntilSec.begin();
-       it != session.itemEventCooldownUntilSec.end();) {
-    if (it->second < session.itemEventDispatchClockSec - 1.0f)
-      it = session.itemEventCooldownUntilSec.erase(it);
+  for (const ItemLightBroadphase::Pair &hit : hits) {
+    if (session.tiledInteractables.size() != mobBase)
+      break; // a listener rebuilt the map (teleport); the next tick rescans
+    const ActiveLightEmitter &em = emitters[hit.emitter];
+    if (hit.target < mobBase)
+      dispatchForTarget(em, ItemEventTarget::Interactable,
+                        session.tiledInteractables[hit.target].tiled_object_id,
+                        *emitterDefs[hit.emitter]);
     else
-      ++it;
+      dispatchForTarget(em, ItemEventTarget::Mob, static_cast<int>(mobIds[hit.target - mobBase]),
+                        *emitterDefs[hit.emitter]);
   }
 }
 
@@ -152,8 +152,14 @@ bool TryLoadFromPath(const std::string &path) {
           continue;
         ItemEventDispatchDef d;
         d.event = lowerAscii(dv["event"].get<std::string>());
+        d.event_sym = InternEventSymbol(d.event);
         if (dv.contains("event_trigger_when") && dv["event_trigger_when"].is_string())
           d.event_trigger_when = lowerAscii(dv["event_trigger_when"].get<std::string>());
+        if (d.event_trigger_when == "on_collision_stay" || d.event_trigger_when == "on_overlap_stay")
+          d.when = ItemEventWhen::Stay;
+        else if (!d.event_trigger_when.empty() && d.event_trigger_when != "on_collision_enter" &&
+                 d.event_trigger_when != "on_overlap_enter")
+          d.when = ItemEventWhen::Never;
         if (dv.contains("event_action_get_data") && dv["event_action_get_data"].is_string())
           d.event_action_get_data = lowerAscii(dv["event_action_get_data"].get<std::string>());
         if (dv.contains("params") && dv["params"].is_object())
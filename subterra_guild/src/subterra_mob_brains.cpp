@@ -1,12 +1,18 @@
 #include "subterra_mob_brains.h"
 
 #include "components.h"
+#include "path_service.h"
 #include "subterra_components.h"
+#include "subterra_mob_prefabs.h"
+#include "subterra_property_store.h"
 #include "subterra_session.h"
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -15,7 +21,22 @@ namespace subterra {
 namespace {
 
 using BrainFn = std::function<void(SubterraSession &, criogenio::ecs::EntityId, criogenio::AIController &,
-                                   nlohmann::json &, float)>;
+                                   PropertyBlock &, float)>;
+
+constexpr float kPrefabPruneIntervalSec = 1.f;
+/** Minimum wait before a guard re-requests a route home that failed. */
+constexpr float kHomeRetrySec = 1.f;
+
+const PropertyId kPropBrainType = InternPropertyName("brain_type");
+const PropertyId kPropHidden = InternPropertyName("hidden");
+const PropertyId kPropBaseScaleX = InternPropertyName("base_scale_x");
+const PropertyId kPropBaseScaleY = InternPropertyName("base_scale_y");
+const PropertyId kPropSpeed = InternPropertyName("speed");
+const PropertyId kPropUseFlowField = InternPropertyName("use_flow_field");
+const PropertyId kPropHomeX = InternPropertyName("home_x");
+const PropertyId kPropHomeY = InternPropertyName("home_y");
+const PropertyId kPropAggroRadius = InternPropertyName("aggro_radius");
+const PropertyId kPropHomeRetrySec = InternPropertyName("home_retry_sec");
 
 std::string lowerAscii(std::string s) {
   for (char &c : s)
@@ -23,112 +44,247 @@ std::string lowerAscii(std::string s) {
   return s;
 }
 
-float jsonSpeed(const nlohmann::json &state, float fallback) {
-  if (!state.is_object())
-    return fallback;
-  auto it = state.find("speed");
-  if (it == state.end())
-    return fallback;
-  if (it->is_number_float())
-    return it->get<float>();
-  if (it->is_number_integer())
-    return static_cast<float>(it->get<int>());
-  return fallback;
-}
-
-bool jsonBool(const nlohmann::json &state, const char *key, bool fallback) {
-  if (!state.is_object() || !key)
-    return fallback;
-  auto it = state.find(key);
-  if (it == state.end())
-    return fallback;
-  if (it->is_boolean())
-    return it->get<bool>();
-  if (it->is_number_integer())
-    return it->get<int>() != 0;
-  return fallback;
-}
-
-void applyHiddenState(SubterraSession &session, criogenio::ecs::EntityId id, nlohmann::json &state) {
+void applyHiddenState(SubterraSession &session, criogenio::ecs::EntityId id, PropertyBlock &props) {
   if (!session.world)
     return;
   auto *tr = session.world->GetComponent<criogenio::Transform>(id);
   if (!tr)
     return;
-  const bool hidden = jsonBool(state, "hidden", false);
-  if (!state.contains("base_scale_x"))
-    state["base_scale_x"] = tr->scale_x;
-  if (!state.contains("base_scale_y"))
-    state["base_scale_y"] = tr->scale_y;
-  const float baseX = state["base_scale_x"].is_number() ? state["base_scale_x"].get<float>() : 1.f;
-  const float baseY = state["base_scale_y"].is_number() ? state["base_scale_y"].get<float>() : 1.f;
+  const bool hidden = props.GetBool(kPropHidden, false);
+  if (!props.Has(kPropBaseScaleX))
+    props.SetFloat(kPropBaseScaleX, tr->scale_x);
+  if (!props.Has(kPropBaseScaleY))
+    props.SetFloat(kPropBaseScaleY, tr->scale_y);
+  const float baseX = props.GetFloat(kPropBaseScaleX, 1.f);
+  const float baseY = props.GetFloat(kPropBaseScaleY, 1.f);
   tr->scale_x = hidden ? 0.0001f : baseX;
   tr->scale_y = hidden ? 0.0001f : baseY;
 }
 
 void brainSimple(SubterraSession &, criogenio::ecs::EntityId id, criogenio::AIController &ai,
-                 nlohmann::json &state, float) {
+                 PropertyBlock &props, float) {
   ai.brainState = criogenio::AIBrainState::ENEMY_PATROL;
   ai.entityTarget = static_cast<int>(id);
-  const float speed = std::max(10.f, jsonSpeed(state, 60.f));
+  ai.followFlowField = false;
+  const float speed = std::max(10.f, props.GetFloat(kPropSpeed, 60.f));
   ai.velocity = {speed, speed};
 }
 
 void brainSimpleChasePlayer(SubterraSession &session, criogenio::ecs::EntityId id,
-                            criogenio::AIController &ai, nlohmann::json &state, float) {
+                            criogenio::AIController &ai, PropertyBlock &props, float) {
   if (session.player == criogenio::ecs::NULL_ENTITY ||
       (session.world && !session.world->HasEntity(session.player))) {
-    brainSimple(session, id, ai, state, 0.f);
+    brainSimple(session, id, ai, props, 0.f);
     return;
   }
   ai.brainState = criogenio::AIBrainState::ENEMY_AGREESSIVE;
   ai.entityTarget = static_cast<int>(session.player);
-  const float speed = std::max(20.f, jsonSpeed(state, 90.f));
+  // Path around TMX collision on the field shared by every mob chasing the player.
+  ai.followFlowField = props.GetBool(kPropUseFlowField, true);
+  const float speed = std::max(20.f, props.GetFloat(kPropSpeed, 90.f));
   ai.velocity = {speed, speed};
 }
 
+/**
+ * Chases the player while they are within `aggro_radius` of the mob's spawn point; otherwise
+ * walks home on a route from the session PathService (one request per leash, solved off the
+ * main thread).
+ */
+void brainGuard(SubterraSession &session, criogenio::ecs::EntityId id, criogenio::AIController &ai,
+                PropertyBlock &props, float dt) {
+  const auto *tr = session.world->ReadComponent<criogenio::Transform>(id);
+  if (!tr || !session.paths) {
+    brainSimpleChasePlayer(session, id, ai, props, dt);
+    return;
+  }
+  if (!props.Has(kPropHomeX) || !props.Has(kPropHomeY)) {
+    props.SetFloat(kPropHomeX, tr->x);
+    props.SetFloat(kPropHomeY, tr->y);
+  }
+  const float homeX = props.GetFloat(kPropHomeX, tr->x);
+  const float homeY = props.GetFloat(kPropHomeY, tr->y);
+  const float aggro = std::max(0.f, props.GetFloat(kPropAggroRadius, 160.f));
+  if (const auto *ptr = session.player != criogenio::ecs::NULL_ENTITY
+                            ? session.world->ReadComponent<criogenio::Transform>(session.player)
+                            : nullptr) {
+    const float dx = ptr->x - homeX;
+    const float dy = ptr->y - homeY;
+    if (dx * dx + dy * dy <= aggro * aggro) {
+      if (session.world->HasComponent<criogenio::Path2D>(id))
+        session.world->RemoveComponent<criogenio::Path2D>(id);
+      brainSimpleChasePlayer(session, id, ai, props, dt);
+      return;
+    }
+  }
+  brainSimple(session, id, ai, props, dt);
+  const criogenio::Vec2 home{homeX + ai.pathAnchor.x, homeY + ai.pathAnchor.y};
+  const criogenio::Vec2 feet{tr->x + ai.pathAnchor.x, tr->y + ai.pathAnchor.y};
+  float retry = props.GetFloat(kPropHomeRetrySec, 0.f);
+  if (retry > 0.f) {
+    retry = std::max(0.f, retry - dt);
+    props.SetFloat(kPropHomeRetrySec, retry);
+  }
+  const auto *path = session.world->GetComponent<criogenio::Path2D>(id);
+  bool request = !path || path->goal.x != home.x || path->goal.y != home.y;
+  if (!request && path->status != criogenio::Path2D::Status::Pending && !path->Active()) {
+    // Routes end on the centre of the home tile; re-route once pushed off it (failed routes
+    // wait out the retry delay).
+    const criogenio::Terrain2D *terrain = session.world->GetTerrain();
+    const float halfW = terrain ? 0.5f * static_cast<float>(terrain->GridStepX()) : 0.f;
+    const float halfH = terrain ? 0.5f * static_cast<float>(terrain->GridStepY()) : 0.f;
+    const bool away = std::fabs(feet.x - home.x) > halfW || std::fabs(feet.y - home.y) > halfH;
+    request = away && (path->status != criogenio::Path2D::Status::Failed || retry <= 0.f);
+  }
+  if (request) {
+    session.paths->RequestPath(*session.world, id, feet, home);
+    props.SetFloat(kPropHomeRetrySec, kHomeRetrySec);
+  }
+}
+
 const std::unordered_map<std::string, BrainFn> &brainRegistry() {
   static const std::unordered_map<std::string, BrainFn> kBrains = {
       {"simple", brainSimple},
       {"simple_chase_player", brainSimpleChasePlayer},
+      {"guard", brainGuard},
   };
   return kBrains;
 }
 
+void runBrain(SubterraSession &session, criogenio::ecs::EntityId id, float dt) {
+  static const std::string kSimpleBrain = "simple";
+  auto *mp = session.world->GetComponent<MobProperties>(id);
+  if (!mp)
+    mp = &session.world->AddComponent<MobProperties>(id, SubterraMobPropertySchema(nullptr));
+  PropertyBlock &props = mp->props;
+  if (!props.Has(kPropBrainType))
+    props.SetString(kPropBrainType, kSimpleBrain);
+  applyHiddenState(session, id, props);
+  auto *ai = session.world->GetComponent<criogenio::AIController>(id);
+  if (!ai)
+    return;
+  const auto &reg = brainRegistry();
+  const std::string &brainType = props.GetString(kPropBrainType, kSimpleBrain);
+  auto it = reg.find(brainType);
+  if (it == reg.end())
+    it = reg.find(lowerAscii(brainType));
+  if (it == reg.end())
+    it = reg.find(kSimpleBrain);
+  it->second(session, id, *ai, props, dt);
+}
+
+/** Park a mob whose brain was just suspended: no target, no route, no speed. */
+void suspendBrain(SubterraSession &session, criogenio::ecs::EntityId id) {
+  if (auto *ai = session.world->GetComponent<criogenio::AIController>(id)) {
+    ai->entityTarget = static_cast<int>(id);
+    ai->followFlowField = false;
+    ai->velocity = {0.f, 0.f};
+  }
+  session.world->RemoveComponent<criogenio::Path2D>(id);
+}
+
+void collectPlayerPositions(SubterraSession &session, std::vector<criogenio::Vec2> &out) {
+  static thread_local std::vector<criogenio::ecs::EntityId> players;
+  session.world->GetEntitiesWith<PlayerTag, criogenio::Transform>(players);
+  if (session.player != criogenio::ecs::NULL_ENTITY &&
+      std::find(players.begin(), players.end(), session.player) == players.end())
+    players.push_back(session.player);
+  out.clear();
+  for (criogenio::ecs::EntityId id : players) {
+    if (const auto *tr = session.world->ReadComponent<criogenio::Transform>(id))
+      out.push_back({tr->x, tr->y});
+  }
+}
+
 } // namespace
 
 void SubterraMobBrainsTick(SubterraSession &session, float dt) {
   if (!session.world)
     return;
-  std::vector<criogenio::ecs::EntityId> mobIds =
-      session.world->GetEntitiesWith<MobTag, criogenio::Transform, criogenio::AIController>();
-  const auto &reg = brainRegistry();
+  session.syncPathService();
+  static thread_local std::vector<criogenio::ecs::EntityId> mobIds;
+  session.world->GetEntitiesWith<MobTag, criogenio::Transform, criogenio::AIController>(mobIds);
+  static thread_local std::vector<criogenio::Vec2> players;
+  collectPlayerPositions(session, players);
 
+  MobBrainScheduler &sched = session.mobBrains;
+  const MobBrainLodConfig &cfg = sched.config;
+  MobBrainLodStats &stats = sched.stats;
+  stats = {};
+  const float near2 = cfg.near_radius * cfg.near_radius;
+  const float active2 = cfg.active_radius * cfg.active_radius;
+  static thread_local std::vector<criogenio::ecs::EntityId> due;
+  due.clear();
   for (criogenio::ecs::EntityId id : mobIds) {
-    nlohmann::json &state = session.mobEntityDataByEntity[id];
-    if (!state.is_object())
-      state = nlohmann::json::object();
-    if (!state.contains("brain_type"))
-      state["brain_type"] = "simple";
-    applyHiddenState(session, id, state);
-    auto *ai = session.world->GetComponent<criogenio::AIController>(id);
-    if (!ai)
+    auto *clock = session.world->GetComponent<MobBrainClock>(id);
+    if (!clock)
+      clock = &session.world->AddComponent<MobBrainClock>(id);
+    MobBrainLod lod = MobBrainLod::Near;
+    if (!players.empty()) {
+      const auto *tr = session.world->ReadComponent<criogenio::Transform>(id);
+      float best = std::numeric_limits<float>::max();
+      for (const criogenio::Vec2 &p : players) {
+        const float dx = p.x - tr->x;
+        const float dy = p.y - tr->y;
+        best = std::min(best, dx * dx + dy * dy);
+      }
+      lod = best <= near2 ? MobBrainLod::Near
+                          : (best <= active2 ? MobBrainLod::Far : MobBrainLod::Suspended);
+    }
+    if (lod == MobBrainLod::Suspended) {
+      if (clock->lod != MobBrainLod::Suspended)
+        suspendBrain(session, id);
+      clock->lod = lod;
+      clock->pending_dt = 0.f;
+      ++stats.suspended;
+      continue;
+    }
+    clock->lod = lod;
+    clock->pending_dt += dt;
+    if (lod == MobBrainLod::Near) {
+      ++stats.near;
+      const float elapsed = clock->pending_dt;
+      clock->pending_dt = 0.f;
+      runBrain(session, id, elapsed);
       continue;
-    std::string brainType = lowerAscii(state["brain_type"].is_string()
-                                           ? state["brain_type"].get<std::string>()
-                                           : std::string("simple"));
-    auto it = reg.find(brainType);
-    if (it == reg.end())
-      it = reg.find("simple");
-    it->second(session, id, *ai, state, dt);
+    }
+    ++stats.far;
+    if (clock->pending_dt >= cfg.far_interval_sec)
+      due.push_back(id);
+  }
+
+  // Due far brains round-robin from the mob after the last one that ran, until the budget
+  // is spent; the rest keep accumulating time and go first next frame.
+  stats.far_due = due.size();
+  if (!due.empty()) {
+    std::sort(due.begin(), due.end());
+    const size_t start = static_cast<size_t>(
+        std::upper_bound(due.begin(), due.end(), sched.cursor) - due.begin());
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t n = 0; n < due.size(); ++n) {
+      const criogenio::ecs::EntityId id = due[(start + n) % due.size()];
+      auto *clock = session.world->GetComponent<MobBrainClock>(id);
+      const float elapsed = clock->pending_dt;
+      clock->pending_dt = 0.f;
+      runBrain(session, id, elapsed);
+      sched.cursor = id;
+      ++stats.far_ticked;
+      stats.far_ms =
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+      if (stats.far_ms >= cfg.far_budget_ms)
+        break;
+    }
   }
 
-  for (auto it = session.mobEntityDataByEntity.begin(); it != session.mobEntityDataByEntity.end();) {
-    if (!session.world->HasEntity(it->first)) {
-      session.mobPrefabByEntity.erase(it->first);
-      it = session.mobEntityDataByEntity.erase(it);
-    } else {
-      ++it;
+  // Entries only go stale when mobs are destroyed, so sweep them on an interval rather than
+  // every frame.
+  sched.prune_accum_sec += dt;
+  if (sched.prune_accum_sec >= kPrefabPruneIntervalSec) {
+    sched.prune_accum_sec = 0.f;
+    for (auto it = session.mobPrefabByEntity.begin(); it != session.mobPrefabByEntity.end();) {
+      if (!session.world->HasEntity(it->first))
+        it = session.mobPrefabByEntity.erase(it);
+      else
+        ++it;
     }
   }
 }
@@ -12,6 +12,7 @@ namespace subterra {
 namespace {
 
 std::unordered_map<std::string, SubterraMobPrefabDef> g_mobDefs;
+EventListenerIndex g_mobListeners;
 
 std::string lowerAscii(std::string s) {
   for (char &c : s)
@@ -74,6 +75,25 @@ bool isMobType(const nlohmann::json &el) {
   return type == "enemy" || type == "mob" || type == "npc";
 }
 
+/** Declares `defaults` first (prefab types win), then the keys brains and actions read. */
+std::shared_ptr<const PropertySchema> buildMobSchema(const nlohmann::json &defaults) {
+  auto schema = std::make_shared<PropertySchema>();
+  schema->DeclareFrom(defaults);
+  schema->Declare(InternPropertyName("brain_type"), PropertyType::String);
+  schema->Declare(InternPropertyName("prefab_name"), PropertyType::String);
+  schema->Declare(InternPropertyName("hidden"), PropertyType::Bool);
+  schema->Declare(InternPropertyName("use_flow_field"), PropertyType::Bool);
+  schema->Declare(InternPropertyName("base_scale_x"), PropertyType::Number);
+  schema->Declare(InternPropertyName("base_scale_y"), PropertyType::Number);
+  schema->Declare(InternPropertyName("speed"), PropertyType::Number);
+  schema->Declare(InternPropertyName("attack_damage"), PropertyType::Number);
+  schema->Declare(InternPropertyName("aggro_radius"), PropertyType::Number);
+  schema->Declare(InternPropertyName("home_x"), PropertyType::Number);
+  schema->Declare(InternPropertyName("home_y"), PropertyType::Number);
+  schema->Declare(InternPropertyName("home_retry_sec"), PropertyType::Number);
+  return schema;
+}
+
 static bool AppendMobDefsFromList(const nlohmann::json &list,
                                   std::vector<SubterraMobPrefabDef> *outVec,
                                   std::unordered_map<std::string, SubterraMobPrefabDef> *outMap) {
@@ -109,6 +129,7 @@ static bool AppendMobDefsFromList(const nlohmann::json &list,
       def.animation_path = el["animation_path"].get<std::string>();
     if (el.contains("entity_data") && el["entity_data"].is_object())
       def.default_entity_data = el["entity_data"];
+    def.property_schema = buildMobSchema(def.default_entity_data);
     if (el.contains("event_listeners") && el["event_listeners"].is_array()) {
       for (const auto &evt : el["event_listeners"]) {
         if (!evt.is_object())
@@ -122,6 +143,8 @@ static bool AppendMobDefsFromList(const nlohmann::json &list,
         listener.action = evt["action"].get<std::string>();
         if (evt.contains("required_data") && evt["required_data"].is_object())
           listener.required_data = evt["required_data"];
+        listener.event_sym = InternEventSymbol(listener.event);
+        listener.predicate = EventPredicate::Compile(listener.required_data);
         def.event_listeners.push_back(std::move(listener));
       }
     }
@@ -133,6 +156,14 @@ static bool AppendMobDefsFromList(const nlohmann::json &list,
   return true;
 }
 
+void rebuildListenerIndex() {
+  g_mobListeners.Clear();
+  for (const auto &[key, def] : g_mobDefs) {
+    for (size_t i = 0; i < def.event_listeners.size(); ++i)
+      g_mobListeners.Add(def.event_listeners[i].event_sym, key, static_cast<uint32_t>(i));
+  }
+}
+
 static bool ParseMobMetaRoot(const nlohmann::json &root,
                              std::vector<SubterraMobPrefabDef> *outVec,
                              std::unordered_map<std::string, SubterraMobPrefabDef> *outMap) {
@@ -143,10 +174,14 @@ static bool ParseMobMetaRoot(const nlohmann::json &root,
 
 } // namespace
 
-void SubterraMobPrefabsClear() { g_mobDefs.clear(); }
+void SubterraMobPrefabsClear() {
+  g_mobDefs.clear();
+  g_mobListeners.Clear();
+}
 
 bool SubterraMobPrefabsTryLoadFromPath(const std::string &path) {
   g_mobDefs.clear();
+  g_mobListeners.Clear();
   std::ifstream f(path, std::ios::binary);
   if (!f)
     return false;
@@ -162,6 +197,7 @@ bool SubterraMobPrefabsTryLoadFromPath(const std::string &path) {
   }
   if (!ParseMobMetaRoot(root, nullptr, &g_mobDefs))
     return false;
+  rebuildListenerIndex();
   return !g_mobDefs.empty();
 }
 
@@ -201,4 +237,21 @@ bool SubterraMobTryGetPrefabDef(std::string_view prefabName, SubterraMobPrefabDe
   return true;
 }
 
+const SubterraMobPrefabDef *SubterraMobFindPrefabDef(std::string_view prefabName) {
+  if (prefabName.empty())
+    return nullptr;
+  auto it = g_mobDefs.find(lowerAsciiView(prefabName));
+  return it == g_mobDefs.end() ? nullptr : &it->second;
+}
+
+const EventListenerIndex &SubterraMobEventListeners() { return g_mobListeners; }
+
+std::shared_ptr<const PropertySchema> SubterraMobPropertySchema(const SubterraMobPrefabDef *def) {
+  if (def && def->property_schema)
+    return def->property_schema;
+  static const std::shared_ptr<const PropertySchema> kRuntimeOnly =
+      buildMobSchema(nlohmann::json::object());
+  return kRuntimeOnly;
+}
+
 } // namespace subterra
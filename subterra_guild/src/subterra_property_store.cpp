@@ -0,0 +1,295 @@
+#include "subterra_property_store.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace subterra {
+namespace {
+
+struct NameHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+struct NameTable {
+  std::unordered_map<std::string, PropertyId, NameHash, std::equal_to<>> ids;
+  std::vector<std::string> names{std::string()}; // index 0 = kNoProperty
+};
+
+NameTable &names() {
+  static NameTable table;
+  return table;
+}
+
+} // namespace
+
+PropertyId InternPropertyName(std::string_view name) {
+  if (name.empty())
+    return kNoProperty;
+  NameTable &t = names();
+  auto it = t.ids.find(name);
+  if (it != t.ids.end())
+    return it->second;
+  const PropertyId id = static_cast<PropertyId>(t.names.size());
+  t.names.emplace_back(name);
+  t.ids.emplace(std::string(name), id);
+  return id;
+}
+
+PropertyId FindPropertyName(std::string_view name) {
+  if (name.empty())
+    return kNoProperty;
+  const NameTable &t = names();
+  auto it = t.ids.find(name);
+  return it == t.ids.end() ? kNoProperty : it->second;
+}
+
+const std::string &PropertyName(PropertyId id) {
+  const NameTable &t = names();
+  return id < t.names.size() ? t.names[id] : t.names[0];
+}
+
+bool PropertySchema::Declare(PropertyId id, PropertyType type) {
+  if (id == kNoProperty || slots_.size() >= kMaxSlots || Find(id) >= 0)
+    return false;
+  Slot s;
+  s.id = id;
+  s.type = type;
+  switch (type) {
+  case PropertyType::Bool:
+    s.offset = static_cast<uint16_t>(dataBytes_);
+    dataBytes_ += 1;
+    break;
+  case PropertyType::Number:
+    dataBytes_ = (dataBytes_ + 7) & ~size_t{7};
+    s.offset = static_cast<uint16_t>(dataBytes_);
+    dataBytes_ += sizeof(double);
+    break;
+  case PropertyType::String:
+    s.offset = static_cast<uint16_t>(stringCount_++);
+    break;
+  }
+  slots_.push_back(s);
+  return true;
+}
+
+void PropertySchema::DeclareFrom(const nlohmann::json &defaults) {
+  if (!defaults.is_object())
+    return;
+  for (auto it = defaults.begin(); it != defaults.end(); ++it) {
+    if (it->is_boolean())
+      Declare(InternPropertyName(it.key()), PropertyType::Bool);
+    else if (it->is_number())
+      Declare(InternPropertyName(it.key()), PropertyType::Number);
+    else if (it->is_string())
+      Declare(InternPropertyName(it.key()), PropertyType::String);
+  }
+}
+
+PropertyBlock::PropertyBlock(std::shared_ptr<const PropertySchema> schema)
+    : schema_(std::move(schema)) {
+  if (schema_) {
+    data_.assign(schema_->DataBytes(), 0);
+    strings_.resize(schema_->StringCount());
+  }
+}
+
+int PropertyBlock::slotOf(PropertyId id, PropertyType type) const {
+  if (!schema_)
+    return -1;
+  const int i = schema_->Find(id);
+  return i >= 0 && schema_->At(static_cast<size_t>(i)).type == type ? i : -1;
+}
+
+void PropertyBlock::mark(int slot, bool integral) {
+  present_ |= uint64_t{1} << slot;
+  if (integral)
+    integral_ |= uint64_t{1} << slot;
+  else
+    integral_ &= ~(uint64_t{1} << slot);
+}
+
+void PropertyBlock::dropExtra(PropertyId id) {
+  if (extra_.is_object() && !extra_.empty())
+    extra_.erase(PropertyName(id));
+}
+
+const nlohmann::json *PropertyBlock::extra(PropertyId id) const {
+  if (!extra_.is_object() || extra_.empty() || id == kNoProperty)
+    return nullptr;
+  auto it = extra_.find(PropertyName(id));
+  return it == extra_.end() ? nullptr : &*it;
+}
+
+bool PropertyBlock::Has(PropertyId id) const {
+  if (schema_ && present(schema_->Find(id)))
+    return true;
+  return extra(id) != nullptr;
+}
+
+bool PropertyBlock::GetBool(PropertyId id, bool fallback) const {
+  const int i = schema_ ? schema_->Find(id) : -1;
+  if (present(i)) {
+    const PropertySchema::Slot &s = schema_->At(static_cast<size_t>(i));
+    if (s.type == PropertyType::Bool)
+      return data_[s.offset] != 0;
+    if (s.type == PropertyType::Number && ((integral_ >> i) & 1u)) {
+      double v;
+      std::memcpy(&v, &data_[s.offset], sizeof v);
+      return v != 0.0;
+    }
+    return fallback;
+  }
+  if (const nlohmann::json *v = extra(id)) {
+    if (v->is_boolean())
+      return v->get<bool>();
+    if (v->is_number_integer())
+      return v->get<long long>() != 0;
+  }
+  return fallback;
+}
+
+float PropertyBlock::GetFloat(PropertyId id, float fallback) const {
+  const int i = schema_ ? schema_->Find(id) : -1;
+  if (present(i)) {
+    const PropertySchema::Slot &s = schema_->At(static_cast<size_t>(i));
+    if (s.type != PropertyType::Number)
+      return fallback;
+    double v;
+    std::memcpy(&v, &data_[s.offset], sizeof v);
+    return static_cast<float>(v);
+  }
+  if (const nlohmann::json *v = extra(id)) {
+    if (v->is_number())
+      return v->get<float>();
+  }
+  return fallback;
+}
+
+const std::string &PropertyBlock::GetString(PropertyId id, const std::string &fallback) const {
+  const int i = schema_ ? schema_->Find(id) : -1;
+  if (present(i)) {
+    const PropertySchema::Slot &s = schema_->At(static_cast<size_t>(i));
+    return s.type == PropertyType::String ? strings_[s.offset] : fallback;
+  }
+  if (const nlohmann::json *v = extra(id)) {
+    if (v->is_string())
+      return v->get_ref<const std::string &>();
+  }
+  return fallback;
+}
+
+void PropertyBlock::SetBool(PropertyId id, bool v) {
+  const int i = slotOf(id, PropertyType::Bool);
+  if (i < 0) {
+    SetJson(PropertyName(id), v);
+    return;
+  }
+  data_[schema_->At(static_cast<size_t>(i)).offset] = v ? 1 : 0;
+  mark(i, false);
+  dropExtra(id);
+}
+
+void PropertyBlock::SetFloat(PropertyId id, double v) {
+  const int i = slotOf(id, PropertyType::Number);
+  if (i < 0) {
+    SetJson(PropertyName(id), v);
+    return;
+  }
+  std::memcpy(&data_[schema_->At(static_cast<size_t>(i)).offset], &v, sizeof v);
+  mark(i, false);
+  dropExtra(id);
+}
+
+void PropertyBlock::SetString(PropertyId id, std::string_view v) {
+  const int i = slotOf(id, PropertyType::String);
+  if (i < 0) {
+    SetJson(PropertyName(id), std::string(v));
+    return;
+  }
+  strings_[schema_->At(static_cast<size_t>(i)).offset].assign(v.begin(), v.end());
+  mark(i, false);
+  dropExtra(id);
+}
+
+void PropertyBlock::SetJson(const std::string &key, const nlohmann::json &v) {
+  if (key.empty())
+    return;
+  const PropertyId id = FindPropertyName(key);
+  const int i = schema_ && id != kNoProperty ? schema_->Find(id) : -1;
+  if (i >= 0) {
+    const PropertySchema::Slot &s = schema_->At(static_cast<size_t>(i));
+    if (s.type == PropertyType::Bool && v.is_boolean()) {
+      data_[s.offset] = v.get<bool>() ? 1 : 0;
+      mark(i, false);
+      dropExtra(id);
+      return;
+    }
+    if (s.type == PropertyType::Number && v.is_number()) {
+      const double d = v.get<double>();
+      std::memcpy(&data_[s.offset], &d, sizeof d);
+      mark(i, v.is_number_integer());
+      dropExtra(id);
+      return;
+    }
+    if (s.type == PropertyType::String && v.is_string()) {
+      strings_[s.offset] = v.get<std::string>();
+      mark(i, false);
+      dropExtra(id);
+      return;
+    }
+    // Type does not fit the slot: the dynamic value wins until the slot is written again.
+    present_ &= ~(uint64_t{1} << i);
+  }
+  if (!extra_.is_object())
+    extra_ = nlohmann::json::object();
+  extra_[key] = v;
+}
+
+void PropertyBlock::Erase(PropertyId id) {
+  if (schema_) {
+    const int i = schema_->Find(id);
+    if (i >= 0)
+      present_ &= ~(uint64_t{1} << i);
+  }
+  dropExtra(id);
+}
+
+void PropertyBlock::Assign(const nlohmann::json &obj) {
+  if (!obj.is_object())
+    return;
+  for (auto it = obj.begin(); it != obj.end(); ++it)
+    SetJson(it.key(), *it);
+}
+
+nlohmann::json PropertyBlock::ToJson() const {
+  nlohmann::json out = extra_.is_object() ? extra_ : nlohmann::json::object();
+  if (!schema_)
+    return out;
+  for (size_t i = 0; i < schema_->Size(); ++i) {
+    if (!present(static_cast<int>(i)))
+      continue;
+    const PropertySchema::Slot &s = schema_->At(i);
+    const std::string &key = PropertyName(s.id);
+    switch (s.type) {
+    case PropertyType::Bool:
+      out[key] = data_[s.offset] != 0;
+      break;
+    case PropertyType::Number: {
+      double v;
+      std::memcpy(&v, &data_[s.offset], sizeof v);
+      if ((integral_ >> i) & 1u)
+        out[key] = static_cast<long long>(v);
+      else
+        out[key] = v;
+      break;
+    }
+    case PropertyType::String:
+      out[key] = strings_[s.offset];
+      break;
+    }
+  }
+  return out;
+}
+
+} // namespace subterra
@@ -7,6 +7,7 @@
 #include "spawn_service.h"
 #include "subterra_level_ecs.h"
 #include "subterra_components.h"
+#include "terrain.h"
 #include "terrain_loader.h"
 #include "log.h"
 #include <algorithm>
@@ -34,8 +35,8 @@ static void snapshotPickupsForBasename(SubterraSession &session, const std::stri
   std::vector<PersistedPickup> list;
   auto ids = session.world->GetEntitiesWith<WorldPickup, criogenio::Transform>();
   for (criogenio::ecs::EntityId id : ids) {
-    auto *pk = session.world->GetComponent<WorldPickup>(id);
-    auto *tr = session.world->GetComponent<criogenio::Transform>(id);
+    const auto *pk = session.world->ReadComponent<WorldPickup>(id);
+    const auto *tr = session.world->ReadComponent<criogenio::Transform>(id);
     if (!pk || !tr || pk->item_id.empty() || pk->count <= 0)
       continue;
     PersistedPickup p;
@@ -76,7 +77,6 @@ void sessionLog(SubterraSession &session, const std::string &line) {
 
 void SubterraSession::rebuildTriggers() {
   triggers.clear();
-  triggerInsidePrevFrame.clear();
   tiledInteractables.clear();
   criogenio::Terrain2D *t = world ? world->GetTerrain() : nullptr;
   if (t) {
@@ -120,6 +120,66 @@ void SubterraSession::rebuildTriggers() {
     tiledInteractables.insert(tiledInteractables.end(), ecsInter.begin(), ecsInter.end());
   }
   triggers.insert(triggers.end(), runtimeTriggers.begin(), runtimeTriggers.end());
+
+  triggerTable.Compile(triggers);
+  interactableIndex.Clear();
+  for (size_t i = 0; i < tiledInteractables.size(); ++i) {
+    const criogenio::TiledInteractable &it = tiledInteractables[i];
+    const criogenio::Rect bounds = it.is_point ? criogenio::Rect{it.x, it.y, 0.f, 0.f}
+                                               : criogenio::Rect{it.x, it.y, it.w, it.h};
+    interactableIndex.Update(static_cast<criogenio::ecs::EntityId>(i + 1), bounds);
+  }
+}
+
+/** Grid ids back to ascending vector indices, so callers keep the unindexed scan order. */
+static void gridIdsToIndices(const std::vector<criogenio::ecs::EntityId> &ids,
+                             std::vector<size_t> &out) {
+  const size_t first = out.size();
+  for (criogenio::ecs::EntityId id : ids)
+    out.push_back(static_cast<size_t>(id) - 1);
+  std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+}
+
+void SubterraSession::queryTriggers(const criogenio::Rect &area, std::vector<size_t> &out) const {
+  triggerTable.Query(area, out);
+}
+
+void SubterraSession::queryInteractables(const criogenio::Rect &area,
+                                         std::vector<size_t> &out) const {
+  static thread_local std::vector<criogenio::ecs::EntityId> ids;
+  ids.clear();
+  interactableIndex.QueryRect(area, ids);
+  gridIdsToIndices(ids, out);
+}
+
+void SubterraSession::queryInteractablesInRadius(float cx, float cy, float radius,
+                                                 std::vector<size_t> &out) const {
+  static thread_local std::vector<criogenio::ecs::EntityId> ids;
+  ids.clear();
+  interactableIndex.QueryRadius(cx, cy, radius, ids);
+  gridIdsToIndices(ids, out);
+}
+
+void SubterraSession::syncPathService() {
+  criogenio::Terrain2D *terrain = world ? world->GetTerrain() : nullptr;
+  if (!terrain || terrain->tmxMeta.collisionSolid.empty() || terrain->GridStepX() <= 0 ||
+      terrain->GridStepY() <= 0) {
+    if (paths)
+      paths->Clear();
+    return;
+  }
+  if (!paths)
+    paths = std::make_unique<criogenio::PathService>();
+  paths->SetCollision(terrain->tmxMeta, static_cast<float>(terrain->GridStepX()),
+                      static_cast<float>(terrain->GridStepY()), terrain->origin);
+  static thread_local std::vector<criogenio::Rect> doors;
+  doors.clear();
+  for (const criogenio::TiledInteractable &it : tiledInteractables) {
+    if (InteractableBlocksMovement(*this, it))
+      doors.push_back({it.x, it.y, it.w, it.h});
+  }
+  paths->SetBlockers(doors);
+  paths->Deliver(*world);
 }
 
 std::string SubterraSession::addRuntimeTrigger(MapEventTrigger t) {
@@ -148,7 +208,6 @@ void SubterraSession::destroyTransientEntities() {
   for (criogenio::ecs::EntityId id : kill) {
     if (id != player) {
       world->DeleteEntity(id);
-      mobEntityDataByEntity.erase(id);
       mobPrefabByEntity.erase(id);
     }
   }
@@ -156,7 +215,6 @@ void SubterraSession::destroyTransientEntities() {
 
 void SubterraSession::applyPostTerrainLoad(const std::string &pathForPersistenceBasename) {
   mapPath = pathForPersistenceBasename;
-  triggerInsidePrevFrame.clear();
   rebuildTriggers();
   const std::string enteringBasename = mapBasenameFromPath(pathForPersistenceBasename);
   const auto persisted = persistedPickupsByBasename.find(enteringBasename);
@@ -190,11 +248,9 @@ bool SubterraSession::loadMap(const std::string &path, std::string &errOut) {
         c->movement_frozen = false;
     }
     interactableStateFlags.clear();
-    interactableEntityDataByKey.clear();
-    mobEntityDataByEntity.clear();
+    interactablePropertiesByKey.clear();
     mobPrefabByEntity.clear();
-    itemEventPairsInside.clear();
-    itemEventCooldownUntilSec.clear();
+    itemEventPairs.Clear();
     itemEventDispatchClockSec = 0.f;
     nearestInteractableIndex = -1;
     runtimeTriggers.clear();
@@ -277,6 +333,7 @@ void SubterraSession::emitManual(const std::string &eventId, const std::string &
   p.event_trigger = trigger;
   p.event_type = eventType;
   p.manual = true;
+  p.ResolveSymbols();
   mapEvents.dispatch(p);
 }
 
@@ -2,6 +2,7 @@
 #include "map_events.h"
 #include "subterra_json_strip.h"
 #include "subterra_session.h"
+#include "world.h"
 
 #include "json.hpp"
 
@@ -10,6 +11,7 @@
 #include <cmath>
 #include <fstream>
 #include <iterator>
+#include <limits>
 
 namespace subterra {
 
@@ -50,22 +52,16 @@ StatusLineKind parseLineKind(const std::string &s) {
   return StatusLineKind::None;
 }
 
-int findActiveStatus(PlayerVitals &v, const std::string &flag) {
-  for (int i = 0; i < static_cast<int>(v.active_statuses.size()); ++i) {
-    if (v.active_statuses[static_cast<size_t>(i)].flag == flag)
-      return i;
-  }
-  return -1;
-}
-
-void removeActiveStatusByFlag(PlayerVitals &v, const std::string &flag) {
-  int idx = findActiveStatus(v, flag);
-  if (idx < 0)
+void removeActiveStatus(PlayerVitals &v, int def_index) {
+  const int slot = v.active_statuses.Find(def_index);
+  if (slot < 0)
     return;
-  v.active_statuses.erase(v.active_statuses.begin() + idx);
+  v.active_statuses.Erase(static_cast<size_t>(slot));
+  v.active_statuses.RecomputeAggregates();
 }
 
-bool buildInstanceFromDef(const SubterraStatusRegistry &reg, int def_index, ActiveStatusInstance &out) {
+/** Append an instance of `def_index` (and its Increase/Decrease lines) to `set`. */
+bool appendInstanceFromDef(const SubterraStatusRegistry &reg, int def_index, StatusEffectSet &set) {
   if (def_index < 0 || def_index >= static_cast<int>(reg.defs.size()))
     return false;
   const StatusEffectDef &def = reg.defs[static_cast<size_t>(def_index)];
@@ -86,53 +82,62 @@ bool buildInstanceFromDef(const SubterraStatusRegistry &reg, int def_index, Acti
     max_dur = std::max(max_dur, 86400.0);
   if (max_dur < 0.05)
     max_dur = 0.1;
-  out = ActiveStatusInstance{};
-  out.def_index = def_index;
-  out.flag = def.player_effect_flag;
-  out.time_remaining = max_dur;
-  out.time_is_inert = has_rate_line;
+  const auto slot = static_cast<std::uint32_t>(set.Size());
+  std::uint8_t preventMask = 0;
+  std::uint8_t increaseMask = 0;
   for (const auto &ln : def.lines) {
     switch (ln.kind) {
     case StatusLineKind::Increase:
     case StatusLineKind::Decrease: {
+      if (ln.amount_total == 0.f)
+        break;
+      if (ln.kind == StatusLineKind::Increase)
+        increaseMask |= ln.target_mask;
       double dur = ln.duration_sec;
       if (dur != kStatusEffectRateModeDuration && dur <= 0)
         dur = max_dur;
-      StatusInstanceLine sl;
-      sl.kind = ln.kind;
-      sl.target_mask = ln.target_mask;
-      sl.amount_total = ln.amount_total;
-      sl.duration_sec = dur;
-      out.lines.push_back(sl);
-      break;
-    }
-    case StatusLineKind::PreventRegen: {
-      std::uint8_t mask = ln.target_mask;
-      if (maskHas(mask, kTargetMaskHealth))
-        out.prevent_regen_health = true;
-      if (maskHas(mask, kTargetMaskStamina))
-        out.prevent_regen_stamina = true;
-      if (maskHas(mask, kTargetMaskFood))
-        out.prevent_regen_food = true;
+      const bool rateMode = dur == kStatusEffectRateModeDuration;
+      if (!rateMode && dur <= 1e-8)
+        break;
+      float sign = ln.kind == StatusLineKind::Increase ? 1.f : -1.f;
+      if (ln.amount_total < 0.f)
+        sign = -sign;
+      const float amount = std::fabs(ln.amount_total);
+      set.line_owner.push_back(slot);
+      set.line_target_mask.push_back(ln.target_mask);
+      set.line_sign.push_back(sign);
+      set.line_rate.push_back(rateMode ? amount : amount / static_cast<float>(dur));
+      set.line_remaining.push_back(rateMode ? std::numeric_limits<float>::infinity() : amount);
       break;
     }
-    case StatusLineKind::RemoveAllDebuffs:
-      out.lines.push_back(StatusInstanceLine{.kind = StatusLineKind::RemoveAllDebuffs});
+    case StatusLineKind::PreventRegen:
+      preventMask |= ln.target_mask;
       break;
     default:
       break;
     }
   }
+  set.flag.push_back(def.player_effect_flag);
+  set.def_index.push_back(def_index);
+  set.time_remaining.push_back(max_dur);
+  set.time_is_inert.push_back(has_rate_line ? 1 : 0);
+  set.prevent_regen_mask.push_back(preventMask);
+  set.increase_mask.push_back(increaseMask);
+  set.prevent_regen |= preventMask;
+  set.increasing |= increaseMask;
   return true;
 }
 
-void applyStatusOnApplyHooks(SubterraSession &session, PlayerVitals &vitals, ActiveStatusInstance &inst) {
-  for (auto &ln : inst.lines) {
-    if (ln.kind == StatusLineKind::RemoveAllDebuffs && !ln.remove_debuffs_done) {
-      SubterraStatusRemoveAllDebuffs(session, vitals);
-      ln.remove_debuffs_done = true;
-    }
+bool defRemovesAllDebuffs(const StatusEffectDef &def) {
+  for (const auto &ln : def.lines) {
+    if (ln.kind == StatusLineKind::RemoveAllDebuffs)
+      return true;
   }
+  return false;
+}
+
+void addClamped(float &value, float delta, float maxValue) {
+  value = std::clamp(value + delta, 0.f, maxValue);
 }
 
 } // namespace
@@ -267,23 +272,83 @@ bool SubterraLoadStatusEffectsFromPaths(const char *const *bufferPaths, size_t b
   return true;
 }
 
-void SubterraStatusRemoveAllDebuffs(SubterraSession &session, PlayerVitals &vitals) {
-  if (session.statusRegistry.defs.empty())
+int StatusEffectSet::Find(int defIndex) const {
+  for (size_t i = 0; i < def_index.size(); ++i) {
+    if (def_index[i] == defIndex)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+void StatusEffectSet::Clear() {
+  flag.clear();
+  def_index.clear();
+  time_remaining.clear();
+  time_is_inert.clear();
+  prevent_regen_mask.clear();
+  increase_mask.clear();
+  line_owner.clear();
+  line_target_mask.clear();
+  line_sign.clear();
+  line_rate.clear();
+  line_remaining.clear();
+  prevent_regen = 0;
+  increasing = 0;
+}
+
+void StatusEffectSet::Erase(size_t slot) {
+  if (slot >= Size())
     return;
+  const auto at = static_cast<std::ptrdiff_t>(slot);
+  flag.erase(flag.begin() + at);
+  def_index.erase(def_index.begin() + at);
+  time_remaining.erase(time_remaining.begin() + at);
+  time_is_inert.erase(time_is_inert.begin() + at);
+  prevent_regen_mask.erase(prevent_regen_mask.begin() + at);
+  increase_mask.erase(increase_mask.begin() + at);
   size_t w = 0;
-  for (size_t i = 0; i < vitals.active_statuses.size(); ++i) {
-    ActiveStatusInstance &a = vitals.active_statuses[i];
-    int di = a.def_index;
-    bool debuff =
-        di >= 0 && di < static_cast<int>(session.statusRegistry.defs.size()) &&
-        session.statusRegistry.defs[static_cast<size_t>(di)].is_debuff;
-    if (debuff)
+  for (size_t i = 0; i < line_owner.size(); ++i) {
+    const std::uint32_t owner = line_owner[i];
+    if (owner == slot)
       continue;
-    if (w != i)
-      vitals.active_statuses[w] = std::move(a);
+    line_owner[w] = owner > slot ? owner - 1 : owner;
+    line_target_mask[w] = line_target_mask[i];
+    line_sign[w] = line_sign[i];
+    line_rate[w] = line_rate[i];
+    line_remaining[w] = line_remaining[i];
     ++w;
   }
-  vitals.active_statuses.resize(w);
+  line_owner.resize(w);
+  line_target_mask.resize(w);
+  line_sign.resize(w);
+  line_rate.resize(w);
+  line_remaining.resize(w);
+}
+
+void StatusEffectSet::RecomputeAggregates() {
+  prevent_regen = 0;
+  increasing = 0;
+  for (size_t i = 0; i < Size(); ++i) {
+    prevent_regen |= prevent_regen_mask[i];
+    increasing |= increase_mask[i];
+  }
+}
+
+void SubterraStatusRemoveAllDebuffs(SubterraSession &session, PlayerVitals &vitals) {
+  const auto &defs = session.statusRegistry.defs;
+  if (defs.empty())
+    return;
+  StatusEffectSet &set = vitals.active_statuses;
+  bool removed = false;
+  for (size_t i = set.Size(); i-- > 0;) {
+    const int di = set.def_index[i];
+    if (di >= 0 && di < static_cast<int>(defs.size()) && defs[static_cast<size_t>(di)].is_debuff) {
+      set.Erase(i);
+      removed = true;
+    }
+  }
+  if (removed)
+    set.RecomputeAggregates();
 }
 
 bool SubterraStatusApply(SubterraSession &session, PlayerVitals &vitals,
@@ -292,152 +357,101 @@ bool SubterraStatusApply(SubterraSession &session, PlayerVitals &vitals,
   auto it = session.statusRegistry.flag_to_index.find(key);
   if (it == session.statusRegistry.flag_to_index.end())
     return false;
-  removeActiveStatusByFlag(vitals, key);
-  ActiveStatusInstance inst;
-  if (!buildInstanceFromDef(session.statusRegistry, it->second, inst))
+  const int def_index = it->second;
+  if (def_index < 0 || def_index >= static_cast<int>(session.statusRegistry.defs.size()))
     return false;
-  applyStatusOnApplyHooks(session, vitals, inst);
-  vitals.active_statuses.push_back(std::move(inst));
-  return true;
+  removeActiveStatus(vitals, def_index);
+  if (defRemovesAllDebuffs(session.statusRegistry.defs[static_cast<size_t>(def_index)]))
+    SubterraStatusRemoveAllDebuffs(session, vitals);
+  return appendInstanceFromDef(session.statusRegistry, def_index, vitals.active_statuses);
 }
 
 void SubterraStatusTickPlayer(SubterraSession &session, PlayerVitals &vitals, float dt) {
   (void)session;
-  if (dt <= 0.f || vitals.active_statuses.empty())
+  StatusEffectSet &set = vitals.active_statuses;
+  if (dt <= 0.f || set.Empty())
     return;
-  const float dt32 = dt;
-  size_t i = 0;
-  while (i < vitals.active_statuses.size()) {
-    ActiveStatusInstance &inst = vitals.active_statuses[i];
-    if (!inst.time_is_inert)
-      inst.time_remaining -= static_cast<double>(dt);
-    for (auto &ln : inst.lines) {
-      switch (ln.kind) {
-      case StatusLineKind::Increase:
-      case StatusLineKind::Decrease:
-        if (ln.amount_total == 0.f)
-          break;
-        if (ln.duration_sec == kStatusEffectRateModeDuration) {
-          float chunk = ln.amount_total * dt32;
-          if (ln.kind == StatusLineKind::Decrease)
-            chunk = -chunk;
-          if (maskHas(ln.target_mask, kTargetMaskHealth)) {
-            vitals.health += chunk;
-            vitals.health = std::clamp(vitals.health, 0.f, vitals.health_max);
-          }
-          if (maskHas(ln.target_mask, kTargetMaskStamina)) {
-            vitals.stamina += chunk;
-            vitals.stamina = std::clamp(vitals.stamina, 0.f, vitals.stamina_max);
-          }
-          if (maskHas(ln.target_mask, kTargetMaskFood)) {
-            vitals.food_satiety += chunk;
-            vitals.food_satiety = std::clamp(vitals.food_satiety, 0.f, vitals.food_satiety_max);
-          }
-          break;
-        }
-        if (ln.duration_sec <= 1e-8)
-          break;
-        {
-          float rate = (ln.kind == StatusLineKind::Increase ? 1.f : -1.f) *
-                       (ln.amount_total / static_cast<float>(ln.duration_sec));
-          float chunk = rate * dt32;
-          float next = ln.applied + chunk;
-          if (ln.kind == StatusLineKind::Increase) {
-            if (next > ln.amount_total)
-              chunk = ln.amount_total - ln.applied;
-          } else {
-            if (next < -ln.amount_total)
-              chunk = -ln.amount_total - ln.applied;
-          }
-          ln.applied += chunk;
-          if (maskHas(ln.target_mask, kTargetMaskHealth)) {
-            vitals.health += chunk;
-            vitals.health = std::clamp(vitals.health, 0.f, vitals.health_max);
-          }
-          if (maskHas(ln.target_mask, kTargetMaskStamina)) {
-            vitals.stamina += chunk;
-            vitals.stamina = std::clamp(vitals.stamina, 0.f, vitals.stamina_max);
-          }
-          if (maskHas(ln.target_mask, kTargetMaskFood)) {
-            vitals.food_satiety += chunk;
-            vitals.food_satiety = std::clamp(vitals.food_satiety, 0.f, vitals.food_satiety_max);
-          }
-        }
-        break;
-      default:
-        break;
-      }
-    }
-    if (inst.time_remaining <= 0) {
-      vitals.active_statuses.erase(vitals.active_statuses.begin() +
-                                   static_cast<std::ptrdiff_t>(i));
+  // Per-line amounts for this step in one pass over the rate / remaining columns, then apply
+  // them in line (= application) order so clamping matches sequential application.
+  static thread_local std::vector<float> chunk;
+  const size_t lines = set.LineCount();
+  chunk.resize(lines);
+  for (size_t i = 0; i < lines; ++i) {
+    const float mag = std::min(set.line_rate[i] * dt, set.line_remaining[i]);
+    set.line_remaining[i] -= mag;
+    chunk[i] = set.line_sign[i] * mag;
+  }
+  for (size_t i = 0; i < lines; ++i) {
+    if (chunk[i] == 0.f)
+      continue;
+    const std::uint8_t mask = set.line_target_mask[i];
+    if (maskHas(mask, kTargetMaskHealth))
+      addClamped(vitals.health, chunk[i], vitals.health_max);
+    if (maskHas(mask, kTargetMaskStamina))
+      addClamped(vitals.stamina, chunk[i], vitals.stamina_max);
+    if (maskHas(mask, kTargetMaskFood))
+      addClamped(vitals.food_satiety, chunk[i], vitals.food_satiety_max);
+  }
+  bool expired = false;
+  for (size_t i = set.Size(); i-- > 0;) {
+    if (set.time_is_inert[i])
       continue;
+    set.time_remaining[i] -= static_cast<double>(dt);
+    if (set.time_remaining[i] <= 0) {
+      set.Erase(i);
+      expired = true;
     }
-    ++i;
+  }
+  if (expired)
+    set.RecomputeAggregates();
+}
+
+void SubterraStatusTickAll(SubterraSession &session, criogenio::World &world, float dt) {
+  if (dt <= 0.f)
+    return;
+  for (criogenio::ecs::EntityId id : world.GetEntitiesWith<PlayerVitals>()) {
+    if (auto *vit = world.GetComponent<PlayerVitals>(id))
+      SubterraStatusTickPlayer(session, *vit, dt);
   }
 }
 
 void SubterraStatusRefreshStarving(SubterraSession &session, PlayerVitals &vitals) {
-  if (session.statusRegistry.flag_to_index.find("starving") == session.statusRegistry.flag_to_index.end())
+  auto it = session.statusRegistry.flag_to_index.find("starving");
+  if (it == session.statusRegistry.flag_to_index.end())
     return;
   if (vitals.food_satiety > 0.f) {
-    removeActiveStatusByFlag(vitals, "starving");
+    removeActiveStatus(vitals, it->second);
     return;
   }
-  if (findActiveStatus(vitals, "starving") < 0)
+  if (vitals.active_statuses.Find(it->second) < 0)
     SubterraStatusApply(session, vitals, "starving");
 }
 
 bool SubterraStatusPlayerHasActiveIncreaseLine(const PlayerVitals &vitals,
                                                const SubterraStatusRegistry &reg, StatusStatTarget t) {
-  std::uint8_t tmask = 0;
+  (void)reg;
   switch (t) {
   case StatusStatTarget::Health:
-    tmask = kTargetMaskHealth;
-    break;
+    return maskHas(vitals.active_statuses.increasing, kTargetMaskHealth);
   case StatusStatTarget::Stamina:
-    tmask = kTargetMaskStamina;
-    break;
+    return maskHas(vitals.active_statuses.increasing, kTargetMaskStamina);
   case StatusStatTarget::Food:
-    tmask = kTargetMaskFood;
-    break;
+    return maskHas(vitals.active_statuses.increasing, kTargetMaskFood);
   default:
     return false;
   }
-  for (const auto &inst : vitals.active_statuses) {
-    for (const auto &ln : inst.lines) {
-      if (ln.kind != StatusLineKind::Increase || ln.amount_total == 0.f)
-        continue;
-      if (maskHas(ln.target_mask, tmask))
-        return true;
-    }
-  }
-  (void)reg;
-  return false;
 }
 
 bool SubterraStatusPreventRegenHealth(const PlayerVitals &vitals) {
-  for (const auto &a : vitals.active_statuses) {
-    if (a.prevent_regen_health)
-      return true;
-  }
-  return false;
+  return maskHas(vitals.active_statuses.prevent_regen, kTargetMaskHealth);
 }
 
 bool SubterraStatusPreventRegenStamina(const PlayerVitals &vitals) {
-  for (const auto &a : vitals.active_statuses) {
-    if (a.prevent_regen_stamina)
-      return true;
-  }
-  return false;
+  return maskHas(vitals.active_statuses.prevent_regen, kTargetMaskStamina);
 }
 
 bool SubterraStatusPreventRegenFood(const PlayerVitals &vitals) {
-  for (const auto &a : vitals.active_statuses) {
-    if (a.prevent_regen_food)
-      return true;
-  }
-  return false;
+  return maskHas(vitals.active_statuses.prevent_regen, kTargetMaskFood);
 }
 
 } // namespace subterra
@@ -48,7 +48,11 @@ static void interactableCenter(const criogenio::TiledInteractable &it, float &cx
 static void restEmissionModifiers(SubterraSession &session, float px, float py, float &outStam,
                                 float &outHp, float &outFood) {
   outStam = outHp = outFood = 0.f;
-  for (const criogenio::TiledInteractable &it : session.tiledInteractables) {
+  static thread_local std::vector<size_t> near;
+  near.clear();
+  session.queryInteractablesInRadius(px, py, SubterraInteractableMaxRestRadius(), near);
+  for (size_t idx : near) {
+    const criogenio::TiledInteractable &it = session.tiledInteractables[idx];
     const std::string kind = normType(it.interactable_type);
     SubterraInteractableRestDef rd{};
     if (!SubterraInteractableTryGetRest(kind, rd))
@@ -77,7 +81,10 @@ static void restEmissionModifiers(SubterraSession &session, float px, float py,
 } // namespace
 
 void SubterraTickVitalsAndStatus(SubterraSession &session, criogenio::World &world, float dt) {
-  if (dt <= 0.f || session.player == criogenio::ecs::NULL_ENTITY)
+  if (dt <= 0.f)
+    return;
+  SubterraStatusTickAll(session, world, dt);
+  if (session.player == criogenio::ecs::NULL_ENTITY)
     return;
   auto *vit = world.GetComponent<PlayerVitals>(session.player);
   auto *tr = world.GetComponent<criogenio::Transform>(session.player);
@@ -86,8 +93,6 @@ void SubterraTickVitalsAndStatus(SubterraSession &session, criogenio::World &wor
   if (!vit || !tr)
     return;
 
-  SubterraStatusTickPlayer(session, *vit, dt);
-
   if (vit->dead) {
     if (ctrl)
       ctrl->movement_frozen = true;
@@ -168,7 +173,11 @@ void SubterraTickVitalsAndStatus(SubterraSession &session, criogenio::World &wor
 
   bool near_burning_campfire = false;
   float campfire_food_per_sec = 0.f;
-  for (const criogenio::TiledInteractable &it : session.tiledInteractables) {
+  static thread_local std::vector<size_t> nearCampfires;
+  nearCampfires.clear();
+  session.queryInteractablesInRadius(pcx, pcy, kCampfireWarmthRadius, nearCampfires);
+  for (size_t idx : nearCampfires) {
+    const criogenio::TiledInteractable &it = session.tiledInteractables[idx];
     if (normType(it.interactable_type) != "campfire")
       continue;
     const std::uint8_t fl = InteractableFlagsEffective(session, it);
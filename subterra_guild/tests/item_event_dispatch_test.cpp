@@ -4,6 +4,8 @@
 #include <iostream>
 #include <vector>
 
+#include "item_event_pair_table.h"
+#include "item_light_broadphase.h"
 #include "subterra_item_light.h"
 
 int main() {
@@ -42,6 +44,57 @@ int main() {
   assert((*defs)[0].event_trigger_when == "on_collision_enter");
   assert((*defs)[0].event_action_get_data == "energy_torch_activated");
   assert((*defs)[0].cooldown_ms == 300);
+  assert((*defs)[0].when == subterra::ItemEventWhen::Enter);
+
+  // Pair keys separate every field.
+  const uint64_t torch = subterra::ItemEventPrefabHash("energy_torch");
+  const subterra::EventSymbol ev = (*defs)[0].event_sym;
+  const uint64_t k1 = subterra::ItemEventPairKey(7, torch, ev, subterra::ItemEventTarget::Mob, 3);
+  assert(k1 != 0);
+  assert(k1 != subterra::ItemEventPairKey(7, torch, ev, subterra::ItemEventTarget::Interactable, 3));
+  assert(k1 != subterra::ItemEventPairKey(8, torch, ev, subterra::ItemEventTarget::Mob, 3));
+  assert(k1 != subterra::ItemEventPairKey(7, subterra::ItemEventPrefabHash("lantern"), ev,
+                                          subterra::ItemEventTarget::Mob, 3));
+
+  // Enter edges, cooldown expiry on the timer wheel, and dead pairs being compacted away.
+  subterra::ItemEventPairTable pairs;
+  pairs.BeginFrame(0);
+  assert(!pairs.Touch(k1) && !pairs.Touch(k1)); // same frame: still "not inside before"
+  pairs.StartCooldown(k1, 300);
+  pairs.BeginFrame(16);
+  assert(pairs.Touch(k1) && pairs.Cooling(k1) && pairs.InsideCount() == 1);
+  pairs.BeginFrame(32); // k1 leaves the light
+  pairs.BeginFrame(299);
+  assert(!pairs.Touch(k1) && pairs.Cooling(k1)); // re-entered inside the cooldown
+  pairs.BeginFrame(300);
+  assert(!pairs.Cooling(k1) && pairs.CoolingCount() == 0);
+  for (uint32_t frame = 0; frame < 50; ++frame) {
+    pairs.BeginFrame(400 + frame);
+    for (uint32_t t = 0; t < 40; ++t)
+      pairs.Touch(subterra::ItemEventPairKey(frame, torch, ev, subterra::ItemEventTarget::Mob, t));
+  }
+  assert(pairs.InsideCount() == 40 && pairs.Capacity() <= 256);
+
+  // Broadphase: cell size follows the largest radius; only nearby emitters are candidates.
+  subterra::ItemLightBroadphase bp;
+  std::vector<criogenio::Vec2> centers;
+  std::vector<float> radii;
+  for (int i = 0; i < 100; ++i) { // a row of torches 200 px apart
+    centers.push_back({static_cast<float>(i) * 200.f, 0.f});
+    radii.push_back(128.f);
+  }
+  centers.push_back({1000.f, 300.f}); // one lantern reaching further
+  radii.push_back(320.f);
+  bp.Build(centers, radii);
+  assert(bp.CellSize() == 320.f);
+  std::vector<subterra::ItemLightBroadphase::Pair> hits;
+  bp.Collect(1010.f, 20.f, 5, hits); // near torch 5 and inside the lantern
+  assert(hits.size() == 2 && hits[0].target == 5);
+  assert((hits[0].emitter == 5 && hits[1].emitter == 100) ||
+         (hits[0].emitter == 100 && hits[1].emitter == 5));
+  bp.Collect(5000.f, 5000.f, 6, hits);
+  assert(hits.size() == 2);
+  assert(bp.Stats().targets == 2 && bp.Stats().pairs == 2 && bp.Stats().candidates < 10);
 
   fs::remove(tempPath);
   std::cout << "item_event_dispatch_test passed\n";
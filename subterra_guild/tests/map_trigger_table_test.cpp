@@ -0,0 +1,59 @@
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "map_events.h"
+#include "map_trigger_table.h"
+
+int main() {
+  std::vector<subterra::MapEventTrigger> triggers;
+  // 70 zones in a row, 10 px apart, so the bitsets span two words.
+  for (int i = 0; i < 70; ++i) {
+    subterra::MapEventTrigger t;
+    t.storage_key = "t" + std::to_string(i);
+    t.x = static_cast<float>(i * 10);
+    t.w = 8.f;
+    t.h = 8.f;
+    if (i == 65)
+      t.event_trigger = "teleport";
+    triggers.push_back(t);
+  }
+  subterra::MapTriggerTable table;
+  table.Compile(triggers);
+  assert(table.Size() == 70 && table.IsTeleport(65) && !table.IsTeleport(0));
+
+  std::vector<uint32_t> entered, exited;
+  const criogenio::ecs::EntityId a = 1, b = 2;
+  table.Update(a, {1.f, 1.f, 15.f, 4.f}, entered, exited); // touches zones 0 and 1
+  assert((entered == std::vector<uint32_t>{0, 1}) && exited.empty());
+  entered.clear();
+  table.Update(a, {2.f, 1.f, 15.f, 4.f}, entered, exited); // still inside: no events
+  assert(entered.empty() && exited.empty());
+  table.Update(a, {641.f, 1.f, 12.f, 4.f}, entered, exited); // jump to zones 64 and 65
+  assert((entered == std::vector<uint32_t>{64, 65}) && (exited == std::vector<uint32_t>{0, 1}));
+  assert(table.Inside(a, 65) && !table.Inside(a, 0));
+
+  // A second tracked entity has its own inside state.
+  entered.clear();
+  exited.clear();
+  table.Update(b, {1.f, 1.f, 4.f, 4.f}, entered, exited);
+  assert((entered == std::vector<uint32_t>{0}) && !table.Inside(b, 65));
+  assert(table.TrackerCount() == 2);
+  table.RetainTrackers({b});
+  assert(table.TrackerCount() == 1 && !table.Inside(a, 65));
+
+  // Recompiling (map change) resets inside state, so zones are entered again.
+  const uint32_t gen = table.Generation();
+  table.Compile(triggers);
+  assert(table.Generation() != gen && !table.Inside(b, 0));
+  entered.clear();
+  table.Update(b, {1.f, 1.f, 4.f, 4.f}, entered, exited);
+  assert((entered == std::vector<uint32_t>{0}));
+
+  std::vector<size_t> hits;
+  table.Query({95.f, 0.f, 20.f, 2.f}, hits);
+  assert((hits == std::vector<size_t>{9, 10, 11}));
+
+  std::cout << "map_trigger_table_test passed\n";
+  return 0;
+}
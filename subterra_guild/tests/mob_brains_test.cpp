@@ -0,0 +1,152 @@
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "path_service.h"
+#include "subterra_components.h"
+#include "subterra_mob_brains.h"
+#include "subterra_mob_prefabs.h"
+#include "subterra_property_store.h"
+#include "subterra_session.h"
+#include "terrain.h"
+#include "world.h"
+
+namespace {
+
+criogenio::ecs::EntityId spawnMob(criogenio::World &world, float x) {
+  const auto id = world.CreateEntity("mob");
+  world.AddComponent<subterra::MobTag>(id);
+  auto &tr = world.AddComponent<criogenio::Transform>(id);
+  tr.x = x;
+  world.AddComponent<criogenio::AIController>(id);
+  return id;
+}
+
+bool ran(criogenio::World &world, criogenio::ecs::EntityId id) {
+  // The default "simple" brain switches the controller to patrol.
+  return world.GetComponent<criogenio::AIController>(id)->brainState ==
+         criogenio::AIBrainState::ENEMY_PATROL;
+}
+
+void reset(criogenio::World &world, const std::vector<criogenio::ecs::EntityId> &ids) {
+  for (auto id : ids)
+    world.GetComponent<criogenio::AIController>(id)->brainState = criogenio::AIBrainState::FRIENDLY;
+}
+
+void guardRoutesHome() {
+  criogenio::World world;
+  auto terrain = std::make_unique<criogenio::Terrain2D>();
+  terrain->tileset.tileSize = 16;
+  terrain->tmxMeta.boundsMaxTx = 8;
+  terrain->tmxMeta.boundsMaxTy = 5;
+  terrain->tmxMeta.collisionStrideTiles = 8;
+  terrain->tmxMeta.collisionHeightTiles = 5;
+  terrain->tmxMeta.collisionSolid.assign(40, 0);
+  world.SetTerrain(std::move(terrain));
+
+  subterra::SubterraSession session;
+  session.world = &world;
+  session.player = world.CreateEntity("player");
+  world.AddComponent<criogenio::Transform>(session.player, 400.f, 0.f); // outside aggro
+  const auto guard = spawnMob(world, 16.f);
+  world.GetComponent<criogenio::Transform>(guard)->y = 16.f;
+  auto &mp = world.AddComponent<subterra::MobProperties>(
+      guard, subterra::SubterraMobPropertySchema(nullptr));
+  mp.props.SetString(subterra::InternPropertyName("brain_type"), "guard");
+
+  subterra::SubterraMobBrainsTick(session, 0.1f); // no route yet: request one home
+  assert(session.paths && session.paths->GetStats().requested == 1);
+  session.paths->WaitIdle();
+  subterra::SubterraMobBrainsTick(session, 0.1f); // delivered; still following it
+  auto *path = world.GetComponent<criogenio::Path2D>(guard);
+  assert(path && path->status == criogenio::Path2D::Status::Ready);
+  path->next = path->waypoints.size(); // arrived on the home tile
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  assert(session.paths->GetStats().requested == 1);
+
+  // Pushed off the home tile after arriving: route home again.
+  world.GetComponent<criogenio::Transform>(guard)->x = 80.f;
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  assert(session.paths->GetStats().requested == 2);
+  session.paths->WaitIdle();
+
+  // Chasing drops the route once; later chase ticks make no structural ECS change.
+  world.GetComponent<criogenio::Transform>(session.player)->x = 20.f;
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  assert(!world.HasComponent<criogenio::Path2D>(guard));
+  const uint64_t mutation = criogenio::ecs::Registry::instance().mutation_counter();
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  assert(criogenio::ecs::Registry::instance().mutation_counter() == mutation);
+}
+
+} // namespace
+
+int main() {
+  guardRoutesHome();
+
+  criogenio::World world;
+  subterra::SubterraSession session;
+  session.world = &world;
+  session.player = world.CreateEntity("player");
+  world.AddComponent<criogenio::Transform>(session.player);
+
+  const auto nearMob = spawnMob(world, 100.f);
+  std::vector<criogenio::ecs::EntityId> farMobs;
+  for (int i = 0; i < 3; ++i)
+    farMobs.push_back(spawnMob(world, 1000.f + static_cast<float>(i)));
+  const auto suspendedMob = spawnMob(world, 5000.f);
+  session.mobPrefabByEntity[suspendedMob] = "test";
+
+  subterra::MobBrainLodConfig &cfg = session.mobBrains.config;
+  cfg.far_budget_ms = 0.f; // one due far brain per frame
+
+  // Far brains wait for their interval; near brains run every frame.
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  const subterra::MobBrainLodStats &st = session.mobBrains.stats;
+  assert(st.near == 1 && st.far == 3 && st.suspended == 1 && st.far_due == 0);
+  assert(ran(world, nearMob) && !ran(world, farMobs[0]) && !ran(world, suspendedMob));
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  assert(st.far_due == 3 && st.far_ticked == 1);
+
+  // Round-robin: each due far brain runs once before any runs again.
+  reset(world, farMobs);
+  for (int i = 0; i < 3; ++i)
+    subterra::SubterraMobBrainsTick(session, 0.1f);
+  for (auto id : farMobs)
+    assert(ran(world, id));
+  assert(world.GetComponent<subterra::MobBrainClock>(farMobs[0])->pending_dt < 0.15f);
+
+  // Suspended mobs stand still and never run their brain.
+  (void)world.GetSpatialIndex();
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  assert(!world.IsSpatialDirty(suspendedMob)); // the distance pass only reads transforms
+  assert(world.GetComponent<criogenio::AIController>(suspendedMob)->velocity.x == 0.f);
+  assert(!ran(world, suspendedMob));
+  assert(world.GetComponent<subterra::MobBrainClock>(suspendedMob)->lod ==
+         subterra::MobBrainLod::Suspended);
+
+  // A generous budget runs every due far brain in one frame.
+  cfg.far_budget_ms = 1000.f;
+  for (int i = 0; i < 3; ++i) {
+    subterra::SubterraMobBrainsTick(session, 0.1f);
+    assert(st.far_ticked == st.far_due);
+  }
+  for (auto id : farMobs)
+    assert(world.GetComponent<subterra::MobBrainClock>(id)->pending_dt < cfg.far_interval_sec);
+
+  // Without a player every brain is near.
+  world.DeleteEntity(session.player);
+  session.player = criogenio::ecs::NULL_ENTITY;
+  subterra::SubterraMobBrainsTick(session, 0.1f);
+  assert(st.near == 5 && st.suspended == 0);
+  assert(ran(world, suspendedMob));
+
+  // Prefab ids of destroyed mobs are pruned.
+  world.DeleteEntity(suspendedMob);
+  subterra::SubterraMobBrainsTick(session, 1.f);
+  assert(session.mobPrefabByEntity.empty());
+
+  std::cout << "mob_brains_test passed\n";
+  return 0;
+}
@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 #include "subterra_mob_prefabs.h"
 
@@ -46,6 +47,30 @@ int main() {
   assert(def.event_listeners[0].event == "light_emission_touched");
   assert(def.event_listeners[0].action == "show_hide_enemy_on_light_range");
 
+  // Listener event interned (case-insensitive), requirements compiled, indexed by symbol.
+  const subterra::EventSymbol sym = subterra::FindEventSymbol("Light_Emission_Touched");
+  assert(sym != subterra::kNoEventSymbol && def.event_listeners[0].event_sym == sym);
+  assert(subterra::FindEventSymbol("never_interned_event") == subterra::kNoEventSymbol);
+  const subterra::EventPredicate &pred = def.event_listeners[0].predicate;
+  assert(pred.Size() == 1);
+  assert(pred.Matches(nlohmann::json{{"light_color", {255, 0, 0}}, {"light_radius", 64}}));
+  assert(!pred.Matches(nlohmann::json{{"light_color", {0, 255, 0}}}));
+  assert(!pred.Matches(nlohmann::json::object()) && !pred.Matches(nlohmann::json()));
+  const subterra::EventPredicate typed = subterra::EventPredicate::Compile(
+      {{"on", true}, {"level", 2}, {"tag", "red"}, {"ignored", nullptr}});
+  assert(typed.Size() == 3);
+  assert(typed.Matches({{"on", true}, {"level", 2.0}, {"tag", "red"}}));
+  assert(!typed.Matches({{"on", 1}, {"level", 2}, {"tag", "red"}}));
+  assert(subterra::EventPredicate().Matches(nlohmann::json()));
+
+  std::vector<const subterra::EventListenerIndex::Ref *> refs;
+  subterra::SubterraMobEventListeners().Collect({sym, sym, subterra::kNoEventSymbol}, refs);
+  assert(refs.size() == 1 && refs[0]->prefab == "zombie" && refs[0]->listener == 0);
+  refs.clear();
+  subterra::SubterraMobEventListeners().Collect({}, refs);
+  assert(refs.empty());
+  assert(subterra::SubterraMobFindPrefabDef("ZOMBIE") != nullptr);
+
   fs::remove(tempPath);
   std::cout << "mob_prefabs_test passed\n";
   return 0;
@@ -0,0 +1,62 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+
+#include "subterra_mob_prefabs.h"
+#include "subterra_property_store.h"
+
+int main() {
+  using subterra::PropertyBlock;
+  using subterra::PropertyType;
+
+  const nlohmann::json defaults = nlohmann::json::parse(
+      R"({"hidden":true,"speed":75,"brain_type":"guard","loot":["bone"]})");
+  auto schema = subterra::SubterraMobPropertySchema(nullptr);
+  assert(schema && schema->Find(subterra::FindPropertyName("home_x")) >= 0);
+
+  auto custom = std::make_shared<subterra::PropertySchema>();
+  custom->DeclareFrom(defaults);
+  assert(custom->Size() == 3); // the array stays dynamic
+  assert(custom->Declare(subterra::InternPropertyName("aggro_radius"), PropertyType::Number));
+  assert(!custom->Declare(subterra::InternPropertyName("hidden"), PropertyType::Number));
+
+  PropertyBlock props(custom);
+  props.Assign(defaults);
+  const auto hidden = subterra::FindPropertyName("hidden");
+  const auto speed = subterra::FindPropertyName("speed");
+  const auto brain = subterra::FindPropertyName("brain_type");
+  const auto aggro = subterra::FindPropertyName("aggro_radius");
+  assert(props.GetBool(hidden, false));
+  assert(props.GetFloat(speed, 0.f) == 75.f);
+  assert(props.GetString(brain, "") == "guard");
+  assert(!props.Has(aggro) && props.GetFloat(aggro, 160.f) == 160.f);
+
+  // jsonBool / jsonFloat rules: integers read as bools, bools never read as numbers.
+  props.SetJson("speed", 0);
+  assert(!props.GetBool(speed, true));
+  assert(props.GetFloat(hidden, -1.f) == -1.f);
+
+  // A value that does not fit its slot shadows it until the slot is written again.
+  props.SetJson("hidden", "maybe");
+  assert(props.GetBool(hidden, false) == false && props.ToJson()["hidden"] == "maybe");
+  props.SetBool(hidden, true);
+  assert(props.GetBool(hidden, false) && props.ToJson()["hidden"] == true);
+
+  // Undeclared keys round-trip through the dynamic object.
+  props.SetJson("attack_damage", 12.5);
+  const nlohmann::json out = props.ToJson();
+  assert(out["speed"].is_number_integer() && out["speed"] == 0);
+  assert(out["loot"] == nlohmann::json::array({"bone"}));
+  assert(out["attack_damage"] == 12.5);
+  props.Erase(subterra::FindPropertyName("attack_damage"));
+  props.Erase(speed);
+  assert(!props.Has(speed) && !props.ToJson().contains("attack_damage"));
+
+  // Blocks without a schema keep everything dynamic.
+  PropertyBlock loose;
+  loose.SetBool(hidden, true);
+  assert(loose.GetBool(hidden, false) && loose.ToJson()["hidden"] == true);
+
+  std::cout << "property_store_test passed\n";
+  return 0;
+}
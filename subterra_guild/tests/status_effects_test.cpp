@@ -0,0 +1,93 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "subterra_player_vitals.h"
+#include "subterra_session.h"
+#include "subterra_status_effects.h"
+#include "world.h"
+
+int main() {
+  subterra::SubterraSession session;
+  std::string err;
+  assert(session.statusRegistry.appendFromJsonArray(R"([
+    {"player_effect_flag":"regen","effects":[
+      {"type":"increase","target":"health","amount":10,"duration":2000}]},
+    {"player_effect_flag":"well_fed","effects":[
+      {"type":"increase","target":["stamina","food"],"amount":1}]},
+    {"player_effect_flag":"cleanse","effects":[{"type":"remove_all_debuffs"}]}
+  ])",
+                                                    false, err));
+  assert(session.statusRegistry.appendFromJsonArray(R"([
+    {"player_effect_flag":"bleeding","effects":[
+      {"type":"decrease","target":"health","amount":20,"duration":1000},
+      {"type":"prevent_regen","target":["health","stamina"]}]},
+    {"player_effect_flag":"starving","effects":[
+      {"type":"decrease","target":"health","amount":2}]}
+  ])",
+                                                    true, err));
+
+  subterra::PlayerVitals v;
+  v.health = 50.f;
+  assert(subterra::SubterraStatusApply(session, v, "Bleeding"));
+  assert(subterra::SubterraStatusApply(session, v, "regen"));
+  assert(v.active_statuses.Size() == 2 && v.active_statuses.LineCount() == 2);
+  assert(subterra::SubterraStatusPreventRegenHealth(v));
+  assert(subterra::SubterraStatusPreventRegenStamina(v));
+  assert(!subterra::SubterraStatusPreventRegenFood(v));
+  assert(subterra::SubterraStatusPlayerHasActiveIncreaseLine(v, session.statusRegistry,
+                                                            subterra::StatusStatTarget::Health));
+  assert(!subterra::SubterraStatusPlayerHasActiveIncreaseLine(v, session.statusRegistry,
+                                                             subterra::StatusStatTarget::Food));
+
+  // Re-applying replaces the instance rather than stacking it.
+  assert(subterra::SubterraStatusApply(session, v, "bleeding"));
+  assert(v.active_statuses.Size() == 2 && v.active_statuses.flag.back() == "bleeding");
+
+  // Bleeding: -20 over 1s; regen: +10 over 2s. Both ramps clamp to their totals.
+  for (int i = 0; i < 10; ++i)
+    subterra::SubterraStatusTickPlayer(session, v, 0.1f);
+  assert(std::fabs(v.health - 35.f) < 1e-3f);
+  assert(v.active_statuses.Size() == 1 && v.active_statuses.flag[0] == "regen");
+  assert(!subterra::SubterraStatusPreventRegenHealth(v));
+  for (int i = 0; i < 12; ++i)
+    subterra::SubterraStatusTickPlayer(session, v, 0.1f);
+  assert(std::fabs(v.health - 40.f) < 1e-3f);
+  assert(v.active_statuses.Empty() && v.active_statuses.LineCount() == 0);
+
+  // Rate-mode lines never expire on their own; RefreshStarving adds / removes by food.
+  v.food_satiety = 0.f;
+  subterra::SubterraStatusRefreshStarving(session, v);
+  subterra::SubterraStatusRefreshStarving(session, v);
+  assert(v.active_statuses.Size() == 1);
+  subterra::SubterraStatusTickPlayer(session, v, 1.f);
+  assert(std::fabs(v.health - 38.f) < 1e-3f);
+  v.food_satiety = 10.f;
+  subterra::SubterraStatusRefreshStarving(session, v);
+  assert(v.active_statuses.Empty());
+
+  // remove_all_debuffs only clears debuffs.
+  assert(subterra::SubterraStatusApply(session, v, "bleeding"));
+  assert(subterra::SubterraStatusApply(session, v, "well_fed"));
+  assert(subterra::SubterraStatusApply(session, v, "cleanse"));
+  assert(v.active_statuses.Size() == 2 && v.active_statuses.Find(3) < 0);
+  assert(!subterra::SubterraStatusPreventRegenHealth(v));
+  assert(subterra::SubterraStatusPlayerHasActiveIncreaseLine(v, session.statusRegistry,
+                                                            subterra::StatusStatTarget::Food));
+
+  // Every entity with PlayerVitals is ticked, not only the session player.
+  criogenio::World world;
+  for (int i = 0; i < 3; ++i) {
+    const auto e = world.CreateEntity("vitals");
+    auto &ev = world.AddComponent<subterra::PlayerVitals>(e);
+    ev.health = 50.f;
+    assert(subterra::SubterraStatusApply(session, ev, "starving"));
+  }
+  subterra::SubterraStatusTickAll(session, world, 1.f);
+  for (auto e : world.GetEntitiesWith<subterra::PlayerVitals>())
+    assert(std::fabs(world.GetComponent<subterra::PlayerVitals>(e)->health - 48.f) < 1e-3f);
+
+  std::cout << "status_effects_test passed\n";
+  return 0;
+}
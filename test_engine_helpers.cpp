@@ -1,21 +1,70 @@
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <utility>
 #include <vector>
 
+#include "animation_database.h"
+#include "asset_manager.h"
 #include "components.h"
+#include "core_systems.h"
 #include "criogenio_io.h"
+#include "draw_order_sort.h"
+#include "flow_field.h"
+#include "json.hpp"
 #include "map_authoring_components.h"
 #include "network/replication_client.h"
 #include "network/replication_server.h"
+#include "network/terrain_delta.h"
 #include "object_layer.h"
+#include "path_graph.h"
+#include "path_service.h"
+#include "profiler.h"
+#include "render.h"
+#include "resources.h"
+#include "spatial_grid.h"
 #include "terrain.h"
+#include "texture_atlas.h"
+#include "timer_wheel.h"
 #include "world.h"
 
 using namespace criogenio;
 
+namespace {
+
+struct MockTransport final : INetworkTransport {
+  struct SentPacket {
+    ConnectionId to = 0;
+    std::vector<uint8_t> data;
+    bool reliable = false;
+  };
+  std::vector<ConnectionId> connections{1};
+  std::vector<NetworkMessage> inbox;
+  std::vector<SentPacket> sent;
+  bool StartServer(uint16_t) override { return true; }
+  bool ConnectToServer(const char *, uint16_t) override { return true; }
+  void Update() override {}
+  void Send(ConnectionId to, const uint8_t *data, size_t size, bool reliable) override {
+    SentPacket p;
+    p.to = to;
+    p.reliable = reliable;
+    p.data.assign(data, data + size);
+    sent.push_back(std::move(p));
+  }
+  std::vector<NetworkMessage> PollMessages() override {
+    std::vector<NetworkMessage> out;
+    out.swap(inbox);
+    return out;
+  }
+  std::vector<ConnectionId> GetConnectionIds() const override { return connections; }
+  void ClearSent() { sent.clear(); }
+};
+
+} // namespace
+
 int main() {
   std::cout << "=== Engine Helper Regression Test ===" << std::endl;
 
@@ -66,34 +115,6 @@ int main() {
 
   // Delta replication behavior: unchanged transforms are skipped between full snapshots.
   {
-    struct MockTransport final : INetworkTransport {
-      struct SentPacket {
-        ConnectionId to = 0;
-        std::vector<uint8_t> data;
-        bool reliable = false;
-      };
-      std::vector<ConnectionId> connections{1};
-      std::vector<NetworkMessage> inbox;
-      std::vector<SentPacket> sent;
-      bool StartServer(uint16_t) override { return true; }
-      bool ConnectToServer(const char *, uint16_t) override { return true; }
-      void Update() override {}
-      void Send(ConnectionId to, const uint8_t *data, size_t size, bool reliable) override {
-        SentPacket p;
-        p.to = to;
-        p.reliable = reliable;
-        p.data.assign(data, data + size);
-        sent.push_back(std::move(p));
-      }
-      std::vector<NetworkMessage> PollMessages() override {
-        std::vector<NetworkMessage> out;
-        out.swap(inbox);
-        return out;
-      }
-      std::vector<ConnectionId> GetConnectionIds() const override { return connections; }
-      void ClearSent() { sent.clear(); }
-    };
-
     World w;
     MockTransport net;
     ReplicationServer server(w, net);
@@ -158,6 +179,661 @@ int main() {
     assert(std::fabs(clientTr->x - encodedDeltaX) < 1e-4f);
     assert(clientTr->y == 0.f);
     assert(clientTr->rotation == 0.f);
+
+    // Per-tick metrics: one sample per snapshot tick, no-op ticks record zero bytes.
+    std::vector<ReplicationServer::TickSample> history;
+    server.GetTickHistory(history);
+    assert(history.size() == 3);
+    assert(history[0].tick == 0 && history[0].bytesPerClient > 0 && history[0].clients == 1);
+    assert(history[1].bytesPerClient == 0 && history[1].DeltaSkipRatio() == 1.f);
+    const auto summary = server.SummarizeTickHistory();
+    assert(summary.samples == 3);
+    assert(summary.bytesPerClient.max == static_cast<float>(history[0].bytesPerClient));
+    assert(summary.deltaSkipRatio.max == 1.f);
+    assert(server.WriteTickHistory("/tmp/_campsur_netprof.csv"));
+    assert(server.WriteTickHistory("/tmp/_campsur_netprof.json"));
+  }
+
+  // Terrain delta replication: runtime SetTile edits go out as RLE chunk deltas, and a
+  // connection that joins later is streamed the edited chunks it missed.
+  {
+    World w;
+    Terrain2D &terrain = w.CreateTerrain2D("t", "");
+    MockTransport net;
+    ReplicationServer server(w, net);
+    server.Update(); // arms chunk change tracking
+    net.ClearSent();
+
+    terrain.SetTile(0, 3, 4, 42);
+    terrain.SetTile(0, -1, -1, 7); // negative chunk coordinates
+    server.Update();
+    std::vector<uint8_t> deltaBytes;
+    for (const auto &p : net.sent) {
+      if (!p.data.empty() && p.data[0] == static_cast<uint8_t>(MsgType::TerrainDelta))
+        deltaBytes = p.data;
+    }
+    assert(!deltaBytes.empty());
+    const size_t rawChunkBytes = sizeof(int) * terrain.GetChunkSize() * terrain.GetChunkSize();
+    assert(deltaBytes.size() < rawChunkBytes); // two chunks compress well below one raw chunk
+    TerrainDelta delta = ParseTerrainDeltaFromWire(deltaBytes.data(), deltaBytes.size());
+    assert(delta.chunks.size() == 2);
+    assert(server.GetStats().terrainChunksSent == 2);
+
+    World clientWorld;
+    Terrain2D &clientTerrain = clientWorld.CreateTerrain2D("t", "");
+    ReplicationClient client(clientWorld);
+    client.ApplyTerrainDelta(delta);
+    assert(clientTerrain.GetTile(0, 3, 4) == 42);
+    assert(clientTerrain.GetTile(0, -1, -1) == 7);
+    assert(clientTerrain.GetTile(0, 5, 5) == terrain.GetTile(0, 5, 5));
+
+    // Nothing dirty -> no terrain traffic.
+    net.ClearSent();
+    server.Update();
+    for (const auto &p : net.sent)
+      assert(p.data.empty() || p.data[0] != static_cast<uint8_t>(MsgType::TerrainDelta));
+
+    // Late joiner receives the full contents of previously edited chunks.
+    net.connections.push_back(2);
+    server.Update();
+    bool streamed = false;
+    for (const auto &p : net.sent) {
+      if (p.to != 2 || p.data.empty() || p.data[0] != static_cast<uint8_t>(MsgType::TerrainDelta))
+        continue;
+      TerrainDelta d = ParseTerrainDeltaFromWire(p.data.data(), p.data.size());
+      streamed = d.chunks.size() == 2;
+    }
+    assert(streamed);
+
+    // Cleared layer chunks replicate as removals; truncated payloads parse as empty.
+    net.ClearSent();
+    terrain.ClearLayer(0);
+    server.Update();
+    assert(!net.sent.empty());
+    TerrainDelta cleared = ParseTerrainDeltaFromWire(net.sent.back().data.data(),
+                                                     net.sent.back().data.size());
+    assert(cleared.chunks.size() == 2 && cleared.chunks[0].removed);
+    client.ApplyTerrainDelta(cleared);
+    assert(clientTerrain.FindChunkTiles(0, ChunkKey{0, 0}) == nullptr);
+    assert(ParseTerrainDeltaFromWire(deltaBytes.data(), deltaBytes.size() - 3).chunks.empty());
+  }
+
+  // Animation texture handle cache: resolved once, refreshed only after unload / hot reload.
+  {
+    int loads = 0;
+    AssetManager::instance().registerLoader<TextureResource>([&loads](const std::string &p) {
+      ++loads;
+      auto r = std::make_shared<TextureResource>();
+      r->path = p;
+      return r;
+    });
+    const AssetId anim = AnimationDatabase::instance().createAnimation("anim_cache_test.png");
+    const AnimationDef *def = AnimationDatabase::instance().getAnimation(anim);
+    assert(def);
+    TextureResource *first = AnimationDatabase::resolveTexture(*def);
+    assert(first && loads == 1);
+    assert(AnimationDatabase::resolveTexture(*def) == first && loads == 1);
+    AssetManager::instance().unload("anim_cache_test.png");
+    TextureResource *reloaded = AnimationDatabase::resolveTexture(*def);
+    assert(reloaded && loads == 2);
+    AnimationDatabase::instance().setTexturePath(anim, "anim_cache_test_b.png");
+    assert(AnimationDatabase::resolveTexture(*def)->path == "anim_cache_test_b.png");
+    AssetManager::instance().clear();
+  }
+
+  // Draw-order sorter matches std::sort on (order, id) for radix, coherent and small paths.
+  {
+    DrawOrderSorter sorter;
+    std::vector<ecs::EntityId> input;
+    std::vector<int> order(300);
+    for (ecs::EntityId id = 0; id < 300; ++id) {
+      input.push_back(299 - id);
+      order[id] = static_cast<int>((id * 7919u) % 97u) - 48; // includes negative orders
+    }
+    auto orderOf = [&order](ecs::EntityId id) { return order[id]; };
+    auto expectSorted = [&](const std::vector<ecs::EntityId> &got) {
+      std::vector<ecs::EntityId> ref = input;
+      std::sort(ref.begin(), ref.end(), [&](ecs::EntityId a, ecs::EntityId b) {
+        return order[a] != order[b] ? order[a] < order[b] : a < b;
+      });
+      assert(got == ref);
+    };
+    std::vector<ecs::EntityId> ids = input;
+    sorter.Sort(ids, orderOf);
+    expectSorted(ids);
+    assert(sorter.GetStats().radixSorts == 1);
+
+    order[5] += 3; // one entity moves: coherent frame repaired by insertion sort
+    ids = input;
+    sorter.Sort(ids, orderOf);
+    expectSorted(ids);
+    assert(sorter.GetStats().insertionSorts == 1);
+
+    for (int &o : order)
+      o = -o; // full reversal exceeds the insertion budget
+    ids = input;
+    sorter.Sort(ids, orderOf);
+    expectSorted(ids);
+    assert(sorter.GetStats().radixSorts == 2);
+
+    input.resize(10);
+    ids = input;
+    sorter.Sort(ids, orderOf);
+    expectSorted(ids);
+  }
+
+  // Spatial hash grid: rect queries, moves across cells, multi-cell entries, sync sweep.
+  {
+    SpatialHashGrid2D grid(64.f);
+    grid.Update(1, {10.f, 10.f, 16.f, 16.f});
+    grid.Update(2, {500.f, 500.f, 16.f, 16.f});
+    grid.Update(3, {-100.f, 50.f, 200.f, 20.f}); // spans several cells
+    std::vector<ecs::EntityId> hits;
+    grid.QueryRect({0.f, 0.f, 100.f, 100.f}, hits);
+    std::sort(hits.begin(), hits.end());
+    assert((hits == std::vector<ecs::EntityId>{1, 3}));
+
+    grid.Update(2, {20.f, 20.f, 8.f, 8.f}); // moved into view
+    hits.clear();
+    grid.QueryRect({0.f, 0.f, 100.f, 100.f}, hits);
+    assert(hits.size() == 3);
+
+    grid.BeginSync();
+    grid.Update(1, {10.f, 10.f, 16.f, 16.f});
+    grid.Update(3, {-100.f, 50.f, 200.f, 20.f});
+    grid.EndSync(); // 2 was not refreshed -> dropped
+    assert(!grid.Contains(2) && grid.Size() == 2);
+    hits.clear();
+    grid.QueryRect({-1.0e6f, -1.0e6f, 2.0e6f, 2.0e6f}, hits); // wide-area scan path
+    assert(hits.size() == 2);
+  }
+
+  // Batched sprite quads match SDL_RenderTextureRotated: pivot relative to dst, clockwise degrees.
+  {
+    auto sdlRotated = [](const Rect &dst, Vec2 center, float deg, Vec2 out[4]) {
+      // Corner math of SDL_RenderTextureRotated (the unbatched path).
+      const double rad = static_cast<double>(deg) * 3.14159265358979323846 / 180.0;
+      const float c = static_cast<float>(std::cos(rad)), sn = static_cast<float>(std::sin(rad));
+      const float minx = -center.x, maxx = dst.width - center.x;
+      const float miny = -center.y, maxy = dst.height - center.y;
+      const float cx = dst.x + center.x, cy = dst.y + center.y;
+      const float xs[4] = {minx, maxx, maxx, minx}, ys[4] = {miny, miny, maxy, maxy};
+      for (int i = 0; i < 4; ++i)
+        out[i] = {c * xs[i] - sn * ys[i] + cx, sn * xs[i] + c * ys[i] + cy};
+    };
+    const Rect dst{120.f, -40.f, 32.f, 48.f};
+    for (Vec2 pivot : {Vec2{0.f, 0.f}, Vec2{16.f, 24.f}, Vec2{32.f, 48.f}, Vec2{-8.f, 5.f}}) {
+      for (float deg : {0.f, 30.f, 90.f, -135.f, 270.f}) {
+        Vec2 batched[4], immediate[4];
+        RotatedQuadCorners(dst, pivot, deg, batched);
+        sdlRotated(dst, pivot, deg, immediate);
+        for (int i = 0; i < 4; ++i)
+          assert(std::fabs(batched[i].x - immediate[i].x) < 1e-3f &&
+                 std::fabs(batched[i].y - immediate[i].y) < 1e-3f);
+      }
+    }
+    // The pivot itself stays put: a quarter turn about the centre swaps the extents.
+    Vec2 q[4];
+    RotatedQuadCorners(dst, {16.f, 24.f}, 90.f, q);
+    assert(std::fabs(q[0].x - 160.f) < 1e-3f && std::fabs(q[0].y - (-32.f)) < 1e-3f);
+    assert(std::fabs(q[2].x - 112.f) < 1e-3f && std::fabs(q[2].y - 0.f) < 1e-3f);
+  }
+
+  // Skyline packer: placements stay in bounds, never overlap, and a full page rejects.
+  {
+    SkylinePacker packer(128, 128);
+    std::vector<Rect> placed;
+    const int sizes[][2] = {{64, 32}, {32, 64}, {48, 48}, {16, 16}, {64, 16}, {40, 24}};
+    for (const auto &sz : sizes) {
+      int x = -1, y = -1;
+      assert(packer.Insert(sz[0], sz[1], x, y));
+      assert(x >= 0 && y >= 0 && x + sz[0] <= 128 && y + sz[1] <= 128);
+      const Rect r{static_cast<float>(x), static_cast<float>(y), static_cast<float>(sz[0]),
+                   static_cast<float>(sz[1])};
+      for (const Rect &o : placed)
+        assert(r.x + r.width <= o.x || o.x + o.width <= r.x || r.y + r.height <= o.y ||
+               o.y + o.height <= r.y);
+      placed.push_back(r);
+    }
+    int x = 0, y = 0;
+    assert(!packer.Insert(129, 8, x, y));
+    assert(packer.Occupancy() > 0.f && packer.Occupancy() <= 1.f);
+    SkylinePacker full(32, 32);
+    assert(full.Insert(32, 32, x, y) && x == 0 && y == 0);
+    assert(!full.Insert(1, 1, x, y));
+  }
+
+  // TMX GID lookup table: per-tileset ranges, margin/spacing source rects, unmapped GIDs.
+  {
+    Terrain2D terrain;
+    TmxTilesetEntry a;
+    a.firstGid = 1;
+    a.sheet.columns = 4;
+    a.sheet.rows = 2;
+    a.tilePixelW = a.tilePixelH = 16;
+    a.margin = 1;
+    a.spacing = 2;
+    TmxTilesetEntry b;
+    b.firstGid = 9;
+    b.sheet.columns = 2;
+    b.sheet.rows = 2;
+    b.tilePixelW = b.tilePixelH = 32;
+    terrain.tmxTilesets = {a, b};
+    terrain.RebuildTmxGidLookup();
+
+    assert(terrain.LookupTmxGid(0) == nullptr);
+    const TmxGidEntry *g6 = terrain.LookupTmxGid(6); // tileset a, local 5 -> col 1 row 1
+    assert(g6 && g6->tilesetIndex == 0 && g6->localId == 5);
+    assert(g6->source.x == 1.f + 18.f && g6->source.y == 1.f + 18.f);
+    assert(g6->source.width == 16.f);
+    const TmxGidEntry *g12 = terrain.LookupTmxGid(12); // tileset b, local 3
+    assert(g12 && g12->tilesetIndex == 1 && g12->localId == 3);
+    assert(g12->source.x == 32.f && g12->source.y == 32.f);
+    assert(terrain.LookupTmxGid(13) == nullptr);
+    assert(terrain.LookupTmxGid(TileGid(MakeFlippedTile(12, true, false, false))) == g12);
+  }
+
+  // Profiler: nested zones land in the closing frame with depths; Chrome trace export parses.
+  {
+    Profiler &prof = Profiler::instance();
+    prof.Clear();
+    prof.BeginFrame();
+    const uint32_t frame = prof.FrameIndex();
+    {
+      ProfileScope outer("test.outer");
+      ProfileScope inner("test.inner");
+    }
+    prof.BeginFrame();
+    const auto zones = prof.CollectMainThreadFrame(frame);
+    assert(zones.size() == 2);
+    assert(std::strcmp(zones[0].name, "test.outer") == 0 && zones[0].depth == 0);
+    assert(std::strcmp(zones[1].name, "test.inner") == 0 && zones[1].depth == 1);
+    assert(zones[1].startNs >= zones[0].startNs && zones[1].endNs <= zones[0].endNs);
+    prof.SetEnabled(false);
+    { ProfileScope skipped("test.skipped"); }
+    prof.SetEnabled(true);
+    assert(prof.CollectMainThreadFrame(frame + 1).empty());
+    const char *tracePath = "/tmp/_campsur_profile_trace.json";
+    assert(prof.WriteChromeTrace(tracePath));
+    std::ifstream in(tracePath);
+    const nlohmann::json trace = nlohmann::json::parse(in);
+    size_t complete = 0;
+    for (const auto &ev : trace["traceEvents"])
+      if (ev["ph"] == "X")
+        ++complete;
+    assert(complete == 2);
+    prof.Clear();
+  }
+
+  // Timing window stats and per-system timings recorded by World::Update / Render.
+  {
+    TimingWindow win;
+    for (int i = 1; i <= 100; ++i)
+      win.Add(static_cast<double>(i));
+    assert(win.Count() == 100 && win.AvgMs() == 50.5 && win.MaxMs() == 100.0);
+    assert(win.PercentileMs(99.0) == 99.0 && win.PercentileMs(50.0) == 50.0);
+    for (size_t i = 0; i < TimingWindow::kWindow; ++i)
+      win.Add(1.0);
+    assert(win.Count() == TimingWindow::kWindow && win.MaxMs() == 1.0);
+    assert(win.TotalSamples() == 100 + TimingWindow::kWindow);
+
+    struct NamedSystem : ISystem {
+      void Update(float) override {}
+      void Render(Renderer &) override {}
+      const char *SystemName() const override { return "Named"; }
+    };
+    World w;
+    w.AddSystem<NamedSystem>();
+    w.Update(0.016f);
+    w.Update(0.016f);
+    const SystemTiming *t = w.FindSystemTiming("Named");
+    assert(t && w.GetSystemTimings().size() == 1);
+    assert(t->update.Count() == (CRIOGENIO_SYSTEM_TIMING ? 2u : 0u));
+    w.ResetSystemTimings();
+    assert(t->update.Count() == 0);
+    w.ClearSystems();
+    assert(w.GetSystemTimings().empty());
+
+    // A system registering others mid-update still gets its own sample.
+    struct SpawningSystem : ISystem {
+      World &world;
+      explicit SpawningSystem(World &w) : world(w) {}
+      void Update(float) override {
+        for (int i = 0; i < 16; ++i)
+          world.AddSystem<NamedSystem>();
+      }
+      void Render(Renderer &) override {}
+      const char *SystemName() const override { return "Spawning"; }
+    };
+    w.AddSystem<SpawningSystem>(w);
+    w.Update(0.016f);
+    assert(w.GetSystemTimings().size() == 17);
+    assert(w.FindSystemTiming("Spawning")->update.Count() == (CRIOGENIO_SYSTEM_TIMING ? 1u : 0u));
+    w.ClearSystems();
+  }
+
+  // Spatial queries: radius / nearest-k on the grid, and the World entity index follows moves.
+  {
+    SpatialHashGrid2D grid(32.f);
+    grid.Update(1, {0.f, 0.f, 0.f, 0.f});
+    grid.Update(2, {30.f, 0.f, 0.f, 0.f});
+    grid.Update(3, {100.f, 100.f, 20.f, 20.f}); // closest point (100, 100)
+    grid.Update(4, {-50.f, 0.f, 0.f, 0.f});
+    std::vector<ecs::EntityId> hits;
+    grid.QueryRadius(0.f, 0.f, 40.f, hits);
+    std::sort(hits.begin(), hits.end());
+    assert((hits == std::vector<ecs::EntityId>{1, 2}));
+    hits.clear();
+    grid.QueryNearest(10.f, 0.f, 200.f, 3, hits);
+    assert((hits == std::vector<ecs::EntityId>{1, 2, 4}));
+    hits.clear();
+    grid.QueryNearest(95.f, 95.f, 10.f, 5, hits);
+    assert((hits == std::vector<ecs::EntityId>{3}));
+    assert(SpatialHashGrid2D::DistanceSqToRect({0.f, 0.f, 10.f, 10.f}, 5.f, 5.f) == 0.f);
+    assert(SpatialHashGrid2D::DistanceSqToRect({0.f, 0.f, 10.f, 10.f}, 13.f, 14.f) == 25.f);
+
+    World w;
+    const ecs::EntityId a = w.CreateEntity("a");
+    w.AddComponent<Transform>(a, 0.f, 0.f);
+    const ecs::EntityId b = w.CreateEntity("b");
+    w.AddComponent<Transform>(b, 500.f, 0.f);
+    auto &box = w.AddComponent<BoxCollider>(b);
+    box.offsetX = -100.f;
+    box.width = 50.f;
+    box.height = 50.f;
+    hits.clear();
+    w.QueryEntitiesInRadius({400.f, 10.f}, 5.f, hits); // collider rect, not the origin
+    assert((hits == std::vector<ecs::EntityId>{b}));
+    assert(w.GetSpatialIndex().Size() == 2);
+    w.GetComponent<Transform>(a)->x = 1000.f; // mutable access marks `a` dirty
+    hits.clear();
+    w.QueryEntitiesInRadius({0.f, 0.f}, 10.f, hits); // same tick: sees the move
+    assert(hits.empty());
+    hits.clear();
+    w.QueryEntitiesInRadius({1000.f, 0.f}, 10.f, hits);
+    assert((hits == std::vector<ecs::EntityId>{a}));
+    // A pointer held across a query needs an explicit mark.
+    Transform *held = w.GetComponent<Transform>(a);
+    (void)w.GetSpatialIndex();
+    held->x = 2000.f;
+    w.MarkSpatialDirty(a);
+    hits.clear();
+    w.QueryEntitiesInRadius({2000.f, 0.f}, 10.f, hits);
+    assert((hits == std::vector<ecs::EntityId>{a}));
+    // Reads leave the entity clean; mutable access queues it.
+    assert(w.ReadComponent<Transform>(a)->x == 2000.f && !w.IsSpatialDirty(a));
+    (void)w.GetComponent<Transform>(a);
+    assert(w.IsSpatialDirty(a));
+    (void)w.GetSpatialIndex();
+    assert(!w.IsSpatialDirty(a));
+    w.DeleteEntity(b);
+    w.RemoveComponent<Transform>(a);
+    hits.clear();
+    w.QueryNearestEntities({900.f, 0.f}, 5000.f, 4, hits);
+    assert(hits.empty() && w.GetSpatialIndex().Size() == 0);
+  }
+
+  // Sprite cull index: draw bounds of Sprite / AnimatedSprite, refreshed from the dirty marks.
+  {
+    World w;
+    const ecs::EntityId s = w.CreateEntity("sprite");
+    w.AddComponent<Transform>(s, 100.f, 100.f);
+    w.AddComponent<Sprite>(s).spriteSize = 16;
+    const AssetId anim = AnimationDatabase::instance().createAnimation("sprite_cull_test.png");
+    AnimationClip clip;
+    clip.name = "idle";
+    clip.frames.push_back({{0.f, 0.f, 32.f, 16.f}});
+    clip.frames.push_back({{32.f, 0.f, 48.f, 16.f}});
+    AnimationDatabase::instance().addClip(anim, clip);
+    const ecs::EntityId a = w.CreateEntity("animated");
+    w.AddComponent<Transform>(a, 300.f, 100.f);
+    w.AddComponent<AnimatedSprite>(a, anim).SetClip("idle");
+    const ecs::EntityId bare = w.CreateEntity("bare");
+    w.AddComponent<Transform>(bare, 100.f, 100.f);
+
+    std::vector<ecs::EntityId> hits;
+    w.QuerySpritesInRect({110.f, 110.f, 1.f, 1.f}, hits);
+    assert((hits == std::vector<ecs::EntityId>{s})); // no sprite, not indexed
+    hits.clear();
+    w.QuerySpritesInRect({340.f, 100.f, 1.f, 1.f}, hits); // widest frame, not the current one
+    assert((hits == std::vector<ecs::EntityId>{a}));
+
+    // Rotation about the sprite centre widens its bounds.
+    w.GetComponent<Transform>(s)->rotation = 45.f;
+    hits.clear();
+    w.QuerySpritesInRect({98.f, 98.f, 1.f, 1.f}, hits);
+    assert((hits == std::vector<ecs::EntityId>{s}));
+
+    // Reads and frame ticks leave entities clean; moves and animation swaps re-index them.
+    (void)w.ReadComponent<Transform>(s);
+    (void)w.ReadComponent<Sprite>(s);
+    (void)w.ReadComponent<AnimatedSprite>(a);
+    assert(!w.IsSpatialDirty(s) && !w.IsSpatialDirty(a));
+    w.GetComponent<Transform>(a)->x = 1000.f;
+    hits.clear();
+    w.QuerySpritesInRect({300.f, 100.f, 50.f, 20.f}, hits);
+    assert(hits.empty());
+    clip.name = "big";
+    clip.frames = {{{0.f, 0.f, 200.f, 16.f}}};
+    AnimationDatabase::instance().addClip(anim, clip); // clip edits refresh every AnimatedSprite
+    hits.clear();
+    w.QuerySpritesInRect({1150.f, 100.f, 1.f, 1.f}, hits);
+    assert((hits == std::vector<ecs::EntityId>{a}));
+    w.RemoveComponent<AnimatedSprite>(a);
+    w.DeleteEntity(s);
+    assert(w.GetSpriteIndex().Size() == 0);
+  }
+
+  // Flow field: detours around a wall, shared cache, AIMovementSystem follows it.
+  {
+    // 8x5 tiles, wall in column 3 except the bottom row.
+    TmxMapMetadata meta;
+    meta.boundsMinTx = meta.boundsMinTy = 0;
+    meta.boundsMaxTx = 8;
+    meta.boundsMaxTy = 5;
+    meta.collisionStrideTiles = 8;
+    meta.collisionHeightTiles = 5;
+    meta.collisionSolid.assign(40, 0);
+    for (int y = 0; y < 4; ++y)
+      meta.collisionSolid[static_cast<size_t>(y * 8 + 3)] = 1;
+
+    FlowField2D field;
+    assert(!field.Build(meta, 8, 0)); // goal outside the mask
+    assert(field.Build(meta, 6, 0));
+    assert(field.Cost(6, 0) == 0 && field.Cost(3, 0) == FlowField2D::kUnreachable);
+    assert(field.Cost(0, 0) > 60); // longer than the straight line through the wall
+    int tx = 0, ty = 0, steps = 0;
+    bool usedGap = false;
+    while (!(tx == 6 && ty == 0)) {
+      int nx = 0, ny = 0;
+      assert(field.NextStep(tx, ty, nx, ny));
+      assert(!meta.collisionTileSolid(nx, ny) && field.Cost(nx, ny) < field.Cost(tx, ty));
+      usedGap |= nx == 3 && ny == 4;
+      tx = nx;
+      ty = ny;
+      assert(++steps < 20);
+    }
+    assert(usedGap);
+    int nx = 0, ny = 0;
+    assert(field.NextStep(3, 1, nx, ny) && !meta.collisionTileSolid(nx, ny)); // escape a wall
+
+    FlowFieldCache cache;
+    assert(cache.Acquire(meta, 6, 0) && cache.Acquire(meta, 6, 0) && cache.BuildCount() == 1);
+    assert(cache.Acquire(meta, 5, 4) && cache.BuildCount() == 2 && cache.Size() == 2);
+    ++meta.collisionRevision; // mask rebuilt: cached fields are stale
+    assert(cache.Acquire(meta, 6, 0) && cache.BuildCount() == 3 && cache.Size() == 1);
+
+    World w;
+    auto terrain = std::make_unique<Terrain2D>();
+    terrain->tileset.tileSize = 16;
+    terrain->tmxMeta = meta;
+    w.SetTerrain(std::move(terrain));
+    AIMovementSystem ai(w);
+    const ecs::EntityId target = w.CreateEntity("target");
+    w.AddComponent<Transform>(target, 6 * 16.f + 4.f, 4.f);
+    const ecs::EntityId mob = w.CreateEntity("mob");
+    w.AddComponent<Transform>(mob, 4.f, 4.f);
+    w.AddComponent<AnimationState>(mob);
+    auto &ctrl = w.AddComponent<AIController>(mob, Vec2{120.f, 120.f}, static_cast<int>(target));
+    ctrl.followFlowField = true;
+    ctrl.pathAnchor = {4.f, 4.f};
+    bool arrived = false;
+    for (int i = 0; i < 200 && !arrived; ++i) {
+      ai.Update(1.f / 30.f);
+      const Transform *tr = w.GetComponent<Transform>(mob);
+      assert(!w.GetTerrain()->tmxMeta.collisionTileSolid(
+          static_cast<int>(std::floor((tr->x + 4.f) / 16.f)),
+          static_cast<int>(std::floor((tr->y + 4.f) / 16.f))));
+      arrived = tr->x == 6 * 16.f + 4.f && tr->y == 4.f;
+    }
+    assert(arrived && ai.GetFlowFields().Size() >= 1);
+  }
+
+  // Hierarchical paths: match flow-field reachability, reuse clusters, async service.
+  {
+    auto pathCost = [](const PathGrid &g, PathTile from, const std::vector<PathTile> &tiles) {
+      uint32_t cost = 0;
+      for (const PathTile &t : tiles) {
+        const int dx = t.tx - from.tx, dy = t.ty - from.ty;
+        assert(std::abs(dx) <= 1 && std::abs(dy) <= 1 && (dx || dy));
+        assert(!g.Blocked(t.tx - g.minTx, t.ty - g.minTy));
+        if (dx && dy)
+          assert(!g.Blocked(t.tx - g.minTx, from.ty - g.minTy) &&
+                 !g.Blocked(from.tx - g.minTx, t.ty - g.minTy));
+        cost += dx && dy ? 14u : 10u;
+        from = t;
+      }
+      return cost;
+    };
+    uint32_t seed = 12345u;
+    auto rnd = [&seed](uint32_t n) {
+      seed = seed * 1664525u + 1013904223u;
+      return (seed >> 8) % n;
+    };
+    for (int map = 0; map < 6; ++map) {
+      TmxMapMetadata meta;
+      meta.boundsMinTx = -5;
+      meta.boundsMinTy = 3;
+      meta.collisionStrideTiles = 45;
+      meta.collisionHeightTiles = 38;
+      meta.collisionSolid.resize(45 * 38);
+      for (uint8_t &c : meta.collisionSolid)
+        c = rnd(100) < 30 ? 1 : 0;
+      auto grid = std::make_shared<PathGrid>();
+      assert(grid->AssignFromTmx(meta));
+      auto graph = HierarchicalPathGraph::Build(grid, nullptr);
+      assert(graph->ClusterCount() == 9);
+      for (int q = 0; q < 25; ++q) {
+        const PathTile a{static_cast<int>(rnd(45)) - 5, static_cast<int>(rnd(38)) + 3};
+        const PathTile b{static_cast<int>(rnd(45)) - 5, static_cast<int>(rnd(38)) + 3};
+        if (meta.collisionTileSolid(a.tx, a.ty) || meta.collisionTileSolid(b.tx, b.ty))
+          continue;
+        FlowField2D field;
+        assert(field.Build(meta, b.tx, b.ty));
+        std::vector<PathTile> tiles;
+        const bool found = graph->FindPath(a, b, tiles);
+        assert(found == (field.Cost(a.tx, a.ty) != FlowField2D::kUnreachable));
+        if (found && !(a == b)) {
+          assert(tiles.back() == b);
+          assert(pathCost(*grid, a, tiles) >= field.Cost(a.tx, a.ty));
+        }
+      }
+    }
+
+    // Open 40x20 map split by a wall at column 20 with a 2-tile gap; closing the gap only
+    // rebuilds the clusters around it.
+    TmxMapMetadata meta;
+    meta.collisionStrideTiles = 40;
+    meta.collisionHeightTiles = 20;
+    meta.collisionSolid.assign(800, 0);
+    for (int y = 0; y < 20; ++y)
+      if (y != 17 && y != 18)
+        meta.collisionSolid[static_cast<size_t>(y * 40 + 20)] = 1;
+    auto open = std::make_shared<PathGrid>();
+    assert(open->AssignFromTmx(meta));
+    open->version = 1;
+    auto graph = HierarchicalPathGraph::Build(open, nullptr);
+    std::vector<PathTile> tiles;
+    assert(graph->FindPath({2, 2}, {37, 2}, tiles) && tiles.back() == (PathTile{37, 2}));
+    assert(std::any_of(tiles.begin(), tiles.end(), [](const PathTile &t) { return t.tx == 20; }));
+    auto closed = std::make_shared<PathGrid>(*open);
+    closed->tileW = closed->tileH = 16.f;
+    closed->BlockWorldRect(20 * 16.f, 17 * 16.f, 16.f, 32.f);
+    closed->version = 2;
+    auto rebuilt = HierarchicalPathGraph::Build(closed, graph.get());
+    assert(rebuilt->ReusedClusters() > 0 && rebuilt->ReusedClusters() < rebuilt->ClusterCount());
+    tiles.clear();
+    assert(!rebuilt->FindPath({2, 2}, {37, 2}, tiles));
+    assert(!graph->FindPath({20, 0}, {0, 0}, tiles)); // blocked start
+
+    World w;
+    const ecs::EntityId mob = w.CreateEntity("mob");
+    PathService service(2);
+    assert(service.RequestPath(w, mob, {0.f, 0.f}, {10.f, 0.f}) == 0); // no grid yet
+    service.SetCollision(meta, 16.f, 16.f, {0.f, 0.f});
+    const uint32_t req = service.RequestPath(w, mob, {2 * 16.f + 3.f, 2 * 16.f}, {37 * 16.f, 40.f});
+    assert(req != 0 && w.GetComponent<Path2D>(mob)->status == Path2D::Status::Pending);
+    service.WaitIdle();
+    assert(service.Deliver(w) == 1);
+    const Path2D *path = w.GetComponent<Path2D>(mob);
+    assert(path->Active() && path->requestId == req);
+    assert(path->waypoints.back().x == 37 * 16.f + 8.f && path->waypoints.back().y == 2 * 16.f + 8.f);
+    service.SetBlockers({Rect{20 * 16.f, 17 * 16.f, 16.f, 32.f}}); // door closes
+    service.RequestPath(w, mob, {2 * 16.f, 2 * 16.f}, {37 * 16.f, 40.f});
+    service.WaitIdle();
+    service.Deliver(w);
+    assert(w.GetComponent<Path2D>(mob)->status == Path2D::Status::Failed);
+    const PathServiceStats stats = service.GetStats();
+    assert(stats.graphBuilds == 2 && stats.reusedClusters > 0 && stats.failed == 1);
+    service.RequestPath(w, mob, {2 * 16.f, 2 * 16.f}, {37 * 16.f, 40.f});
+    const uint32_t latest = service.RequestPath(w, mob, {2 * 16.f, 2 * 16.f}, {36 * 16.f, 40.f});
+    service.WaitIdle();
+    assert(service.Deliver(w) == 1); // the superseded result is dropped
+    assert(w.GetComponent<Path2D>(mob)->requestId == latest);
+
+    // AIMovementSystem walks a delivered path ahead of its target.
+    service.SetBlockers({});
+    w.AddComponent<Transform>(mob, 2 * 16.f + 4.f, 2 * 16.f + 4.f);
+    w.AddComponent<AnimationState>(mob);
+    auto &ctrl = w.AddComponent<AIController>(mob, Vec2{200.f, 200.f}, static_cast<int>(mob));
+    ctrl.pathAnchor = {4.f, 4.f};
+    service.RequestPath(w, mob, {2 * 16.f + 8.f, 2 * 16.f + 8.f}, {37 * 16.f, 40.f});
+    service.WaitIdle();
+    service.Deliver(w);
+    AIMovementSystem ai(w);
+    for (int i = 0; i < 400 && w.GetComponent<Path2D>(mob)->Active(); ++i)
+      ai.Update(1.f / 30.f);
+    const Transform *end = w.GetComponent<Transform>(mob);
+    assert(end->x == 37 * 16.f + 4.f && end->y == 2 * 16.f + 4.f);
+  }
+
+  // TimerWheel: deadlines fire once, in order, across level cascades and parked timers.
+  {
+    TimerWheel wheel;
+    std::vector<uint64_t> fired;
+    wheel.Schedule(1, 5);
+    wheel.Schedule(2, 70); // level 1
+    wheel.Schedule(3, 300000); // level 3
+    wheel.Schedule(4, (uint64_t{1} << 24) + 10); // past the wheel span
+    wheel.Schedule(5, 0); // already due
+    assert(wheel.Pending() == 5);
+    wheel.Advance(4, fired);
+    assert((fired == std::vector<uint64_t>{5}));
+    wheel.Advance(69, fired);
+    assert((fired == std::vector<uint64_t>{5, 1}));
+    wheel.Advance(70, fired);
+    assert(fired.back() == 2 && wheel.Pending() == 2);
+    fired.clear();
+    wheel.Advance(299999, fired);
+    assert(fired.empty());
+    wheel.Advance(300000, fired);
+    assert((fired == std::vector<uint64_t>{3}));
+    wheel.Advance((uint64_t{1} << 24) + 9, fired);
+    assert(fired.size() == 1 && wheel.Pending() == 1);
+    wheel.Advance((uint64_t{1} << 24) + 10, fired);
+    assert(fired.back() == 4 && wheel.Pending() == 0);
+    wheel.Advance(uint64_t{1} << 40, fired); // idle wheels jump
+    assert(wheel.Now() == uint64_t{1} << 40);
   }
 
   // Map authoring components round-trip (Serialize / Deserialize).